@@ -48,6 +48,7 @@
 #ifdef DVBPSI_DIST
 #   include "../../src/dvbpsi.h"
 #   include "../../src/demux.h"
+#   include "../../src/router.h"
 #   include "../../src/psi.h"
 #   include "../../src/descriptor.h"
 #   include "../../src/tables/pat.h"
@@ -69,6 +70,7 @@
 #else
 #   include <dvbpsi/dvbpsi.h>
 #   include <dvbpsi/demux.h>
+#   include <dvbpsi/router.h>
 #   include <dvbpsi/psi.h>
 #   include <dvbpsi/descriptor.h>
 #   include <dvbpsi/pat.h>
@@ -240,6 +242,9 @@ struct ts_atsc_eit_s
 
 struct ts_stream_t
 {
+    /* TS packet router */
+    dvbpsi_router_t *router;
+
     /* Program Association Table */
     ts_pat_t    pat;
 
@@ -755,6 +760,10 @@ static void handle_PAT(void* p_data, dvbpsi_pat_t* p_pat)
                  break;
             }
 
+            if (!dvbpsi_router_add(p_stream->router, p_program->i_pid, p_pmt->handle))
+                fprintf(stderr, "dvbinfo: Failed to route pid %d to new pmt decoder\n",
+                        p_program->i_pid);
+
             /* insert at start of list */
             p_pmt->p_next = p_stream->pmt;
             p_stream->pmt = p_pmt;
@@ -1654,8 +1663,30 @@ static void handle_SIS(void* p_data, dvbpsi_sis_t* p_sis)
  *****************************************************************************/
 static void DumpDescriptor(dvbpsi_descriptor_t *p_descriptor)
 {
+    /* Descriptors with a dump function, decoded by libdvbpsi */
+    static void (* const pf_dump_dr[256])(const void*) =
+    {
+        [0x0b] = DumpSystemClockDescriptor,
+        [0x0e] = DumpMaxBitrateDescriptor,
+        [0x10] = DumpSmoothingBufferDescriptor,
+        [0x11] = DumpSTDDescriptor,
+        [0x12] = DumpIBPDescriptor,
+        [0x1b] = DumpMPEG4VideoDescriptor,
+        [0x1c] = DumpMPEG4AudioDescriptor,
+        [0x24] = DumpContentLabellingDescriptor,
+        [0x4c] = DumpTimeShiftedServiceDescriptor,
+        [0x4f] = DumpTimeShiftedEventDescriptor,
+        [0x52] = DumpStreamIdentifierDescriptor,
+        [0x53] = DumpCAIdentifierDescriptor,
+        [0x54] = DumpContentDescriptor,
+        [0x59] = DumpSubtitleDescriptor,
+        [0x7c] = DumpAACDescriptor,
+#ifdef TS_USE_DVB_CUEI
+        [0x8a] = DumpCUEIDescriptor,
+#endif
+    };
     const void *p_decoded = NULL;
-    void (*dump_dr_fn)(const void*) = NULL;
+    void (*dump_dr_fn)(const void*) = pf_dump_dr[p_descriptor->i_tag];
 
     switch (p_descriptor->i_tag)
     {
@@ -1681,74 +1712,11 @@ static void DumpDescriptor(dvbpsi_descriptor_t *p_descriptor)
         case 0x6a:
             printf("\"a52\" (%s)\n", GetDescriptorName(p_descriptor->i_tag));
             return;
-        case 0x7c:
-            p_decoded = dvbpsi_DecodeAACDr(p_descriptor);
-            dump_dr_fn = DumpAACDescriptor;
-            break;
-        case 0x08:
-            p_decoded = dvbpsi_DecodeSystemClockDr(p_descriptor);
-            dump_dr_fn = DumpSystemClockDescriptor;
-            break;
-#ifdef TS_USE_DVB_CUEI
-        case 0x8a:
-            p_decoded = dvbpsi_DecodeCUEIDr(p_descriptor);
-            dump_dr_fn = DumpCUEIDescriptor;
-            break;
-#endif
-        case 0x0e:
-            p_decoded = dvbpsi_DecodeMaxBitrateDr(p_descriptor);
-            dump_dr_fn = DumpMaxBitrateDescriptor;
-            break;
-        case 0x10:
-            p_decoded = dvbpsi_DecodeSmoothingBufferDr(p_descriptor);
-            dump_dr_fn = DumpSmoothingBufferDescriptor;
-            break;
-        case 0x11:
-            p_decoded = dvbpsi_DecodeSTDDr(p_descriptor);
-            dump_dr_fn = DumpSTDDescriptor;
-            break;
-        case 0x12:
-            p_decoded = dvbpsi_DecodeIBPDr(p_descriptor);
-            dump_dr_fn = DumpIBPDescriptor;
-            break;
-        case 0x1b:
-            p_decoded = dvbpsi_DecodeMPEG4VideoDr(p_descriptor);
-            dump_dr_fn = DumpMPEG4VideoDescriptor;
-            break;
-        case 0x1c:
-            p_decoded = dvbpsi_DecodeMPEG4AudioDr(p_descriptor);
-            dump_dr_fn = DumpMPEG4AudioDescriptor;
-            break;
-        case 0x24:
-            p_decoded = dvbpsi_DecodeContentLabellingDr(p_descriptor);
-            dump_dr_fn = DumpContentLabellingDescriptor;
-            break;
-        case 0x4c:
-            p_decoded = dvbpsi_DecodeTimeShiftedServiceDr(p_descriptor);
-            dump_dr_fn = DumpTimeShiftedServiceDescriptor;
-            break;
-        case 0x4f:
-            p_decoded = dvbpsi_DecodeTimeShiftedEventDr(p_descriptor);
-            dump_dr_fn = DumpTimeShiftedEventDescriptor;
-            break;
-        case 0x52:
-            p_decoded = dvbpsi_DecodeStreamIdentifierDr(p_descriptor);
-            dump_dr_fn = DumpStreamIdentifierDescriptor;
-            break;
-        case 0x53:
-            p_decoded = dvbpsi_DecodeCAIdentifierDr(p_descriptor);
-            dump_dr_fn = DumpCAIdentifierDescriptor;
-            break;
-        case 0x54:
-            p_decoded = dvbpsi_DecodeContentDr(p_descriptor);
-            dump_dr_fn = DumpContentDescriptor;
-            break;
-        case 0x59:
-            p_decoded = dvbpsi_DecodeSubtitlingDr(p_descriptor);
-            dump_dr_fn = DumpSubtitleDescriptor;
-            break;
     }
 
+    if (dump_dr_fn)
+        p_decoded = dvbpsi_DecodeDescriptor(p_descriptor, 0);
+
     if(dump_dr_fn && p_decoded)
     {
         /* call the dump function if we could decode the descriptor. */
@@ -1949,6 +1917,10 @@ static void handle_atsc_MGT(void *p_data, dvbpsi_atsc_mgt_t *p_mgt)
                  break;
             }
 
+            if (!dvbpsi_router_add(p_stream->router, p->i_table_pid, p->handle))
+                fprintf(stderr, "dvbinfo: Failed to route pid %d to new ATSC EIT decoder\n",
+                        p->i_table_pid);
+
             /* insert at start of list */
             p->p_next = p_stream->atsc_eit;
             p_stream->atsc_eit = p;
@@ -2382,6 +2354,20 @@ ts_stream_t *libdvbpsi_init(int debug, ts_stream_log_cb pf_log, void *cb_data)
         goto error;
     }
 
+    /* TS packet router */
+    stream->router = dvbpsi_router_new();
+    if (stream->router == NULL)
+        goto error;
+    if (!dvbpsi_router_add(stream->router, 0x00, stream->pat.handle) ||
+        !dvbpsi_router_add(stream->router, 0x01, stream->cat.handle) ||
+        !dvbpsi_router_add(stream->router, 0x02, stream->tdt.handle) || /* Transport Stream Description Table */
+        !dvbpsi_router_add(stream->router, 0x11, stream->sdt.handle) || /* SDT/BAT/NIT */
+        !dvbpsi_router_add(stream->router, 0x12, stream->eit.handle) ||
+        !dvbpsi_router_add(stream->router, 0x13, stream->rst.handle) ||
+        !dvbpsi_router_add(stream->router, 0x14, stream->tdt.handle) || /* TDT/TOT */
+        !dvbpsi_router_add(stream->router, 0x1FFB, stream->atsc.handle)) /* ATSC tables */
+        goto error;
+
     /* */
     stream->pat.pid = &stream->pid[0x00];
     stream->cat.pid = &stream->pid[0x01];
@@ -2397,6 +2383,8 @@ ts_stream_t *libdvbpsi_init(int debug, ts_stream_log_cb pf_log, void *cb_data)
     return stream;
 
 error:
+    dvbpsi_router_delete(stream->router);
+
     if (dvbpsi_decoder_present(stream->pat.handle))
         dvbpsi_pat_detach(stream->pat.handle);
     if (dvbpsi_decoder_present(stream->cat.handle))
@@ -2436,6 +2424,9 @@ void libdvbpsi_exit(ts_stream_t *stream)
 {
    summary(stdout, stream);
 
+   dvbpsi_router_delete(stream->router);
+   stream->router = NULL;
+
    if (dvbpsi_decoder_present(stream->pat.handle))
        dvbpsi_pat_detach(stream->pat.handle);
 
@@ -2564,44 +2555,7 @@ bool libdvbpsi_process(ts_stream_t *stream, uint8_t *buf, ssize_t length, mtime_
                            "dvbinfo: %"PRId64" packet %"PRId64" pid %u (0x%x) cc %d\n",
                            date, stream->i_packets, i_pid, i_pid, i_cc);
 
-        if (i_pid == 0x0) /* PAT */
-            dvbpsi_packet_push(stream->pat.handle, p_tmp);
-        else if (i_pid == 0x01) /* CAT */
-            dvbpsi_packet_push(stream->cat.handle, p_tmp);
-        else if (i_pid == 0x02) /* Transport Stream Description Table */
-            dvbpsi_packet_push(stream->tdt.handle, p_tmp);
-#if 0
-        else if (i_pid == 0x03) /* IPMP Control Information Table */
-            dvbpsi_packet_push(stream->ipmp.handle, p_tmp);
-#endif
-        else if (i_pid == 0x11) /* SDT/BAT/NIT */
-            dvbpsi_packet_push(stream->sdt.handle, p_tmp);
-        else if (i_pid == 0x12) /* EIT */
-            dvbpsi_packet_push(stream->eit.handle, p_tmp);
-        else if (i_pid == 0x13) /* RST */
-            dvbpsi_packet_push(stream->rst.handle, p_tmp);
-        else if (i_pid == 0x14) /* TDT/TOT */
-            dvbpsi_packet_push(stream->tdt.handle, p_tmp);
-        else if (i_pid == 0x1FFB) /* ATSC tables */
-            dvbpsi_packet_push(stream->atsc.handle, p_tmp);
-        else
-        {
-            ts_pmt_t *p = stream->pmt;
-            while(p)
-            {
-                if (p->pid_pmt->i_pid == i_pid)
-                    dvbpsi_packet_push(p->handle, p_tmp);
-                p = p->p_next;
-            }
-
-            ts_atsc_eit_t *p_atsc_eit = stream->atsc_eit;
-            while (p_atsc_eit)
-            {
-                if (p_atsc_eit->pid->i_pid == i_pid)
-                    dvbpsi_packet_push(p_atsc_eit->handle, p_tmp);
-                p_atsc_eit = p_atsc_eit->p_next;
-            }
-        }
+        dvbpsi_router_packet_push(stream->router, p_tmp);
 
         /* Remember PID */
         if (!stream->pid[i_pid].b_seen)
@@ -139,22 +139,19 @@ static void PATCallback( void *_unused, dvbpsi_pat_t *p_pat )
 /*****************************************************************************
  * TSHandle: find and decode PSI
  *****************************************************************************/
-static inline uint16_t ts_GetPID( const uint8_t *p_ts )
+static void TSHandle( uint8_t *p_buffer, size_t i_packets )
 {
-    return (((uint16_t)p_ts[1] & 0x1f) << 8) | p_ts[2];
-}
+    dvbpsi_packets_stats_t stats;
+    int i;
 
-static inline int ts_CheckSync( const uint8_t *p_ts )
-{
-    return p_ts[0] == 0x47;
-}
+    if ( !i_nb_programs )
+        dvbpsi_packets_push( p_pat_dvbpsi_fd, 0, p_buffer, i_packets, &stats );
 
-static void TSHandle( uint8_t *p_ts )
-{
-    uint16_t i_pid = ts_GetPID( p_ts );
-    int i;
+    for ( i = 0; i < i_nb_programs; i++ )
+        dvbpsi_packets_push( p_pmt_dvbpsi_fds[i], pi_pmt_pids[i],
+                             p_buffer, i_packets, &stats );
 
-    if ( !ts_CheckSync( p_ts ) )
+    if ( stats.i_sync_errors > 0 )
     {
         fprintf( stderr, "lost TS synchro, go and fix your file "
 #if defined(WIN32)
@@ -165,17 +162,6 @@ static void TSHandle( uint8_t *p_ts )
 	);
         exit(EXIT_FAILURE);
     }
-
-    if ( i_pid == 0 && !i_nb_programs )
-    {
-        dvbpsi_packet_push( p_pat_dvbpsi_fd, p_ts );
-    }
-
-    for ( i = 0; i < i_nb_programs; i++ )
-    {
-        if ( pi_pmt_pids[i] == i_pid )
-            dvbpsi_packet_push( p_pmt_dvbpsi_fds[i], p_ts );
-    }
 }
 
 /*****************************************************************************
@@ -215,7 +201,6 @@ int main( int i_argc, char **pp_argv )
 
     for ( ; ; )
     {
-        int i;
         ssize_t i_ret;
 
         if ( (i_ret = read( i_fd, p_buffer, TS_SIZE * READ_ONCE )) < 0 )
@@ -229,11 +214,8 @@ int main( int i_argc, char **pp_argv )
             break;
         }
 
-        for ( i = 0; i < i_ret / TS_SIZE; i++ )
-        {
-            TSHandle( p_buffer + TS_SIZE * i );
-            i_ts_read++;
-        }
+        TSHandle( p_buffer, i_ret / TS_SIZE );
+        i_ts_read += i_ret / TS_SIZE;
     }
     free( p_buffer );
 
@@ -34,6 +34,7 @@
 #endif
 
 #include "test_dr.h"
+#include "test_dr_compact.h"
 
   <xsl:apply-templates mode="code" />
 
@@ -74,6 +75,15 @@ static int main_<xsl:value-of select="@sname" />_<xsl:value-of select="@msuffix"
 }
 </xsl:template>
 
+<xsl:template match="compact" mode="code">
+/* <xsl:value-of select="@name" /> (compact) */
+static int main_compact_<xsl:value-of select="@sname" />(void)
+{
+  return compact_check("<xsl:value-of select="@name" />", <xsl:value-of select="@tag" />,
+                       compact_check_<xsl:value-of select="@sname" />);
+}
+</xsl:template>
+
 <xsl:template match="text()" mode="code" priority="-1"/>
 
 <!--                -->
@@ -127,6 +137,9 @@ static int main_<xsl:value-of select="@sname" />_<xsl:value-of select="@msuffix"
 <xsl:template match="descriptor" mode="main">
   i_err |= main_<xsl:value-of select="@sname" />_<xsl:value-of select="@msuffix" />();</xsl:template>
 
+<xsl:template match="compact" mode="main">
+  i_err |= main_compact_<xsl:value-of select="@sname" />();</xsl:template>
+
 <xsl:template match="text()" mode="main" priority="-1"/>
 
 </xsl:stylesheet>
@@ -37,35 +37,50 @@
 
 /*****************************************************************************
  * main
+ *****************************************************************************
+ * table[0] is the byte per byte table, table[n] gives the CRC contribution
+ * of a byte followed by n zero bytes (slicing-by-8).
  *****************************************************************************/
 int main(void)
 {
-  uint32_t table[256];
-  uint32_t i, j, k;
+  uint32_t table[8][256];
+  uint32_t i, j, k, n;
 
   for(i = 0; i < 256; i++)
   {
     k = 0;
     for (j = (i << 24) | 0x800000; j != 0x80000000; j <<= 1)
       k = (k << 1) ^ (((k ^ j) & 0x80000000) ? 0x04c11db7 : 0);
-    table[i] = k;
+    table[0][i] = k;
   }
 
-  printf("static uint32_t table[256] =\n{\n");
-  for(i = 0; i < 64; i++)
+  for(n = 1; n < 8; n++)
+    for(i = 0; i < 256; i++)
+      table[n][i] = (table[n - 1][i] << 8)
+                    ^ table[0][table[n - 1][i] >> 24];
+
+  printf("static const uint32_t table[8][256] =\n{\n");
+  for(n = 0; n < 8; n++)
   {
-    printf("  0x%08x, 0x%08x, 0x%08x, 0x%08x",
-           table[i << 2 | 0],
-           table[i << 2 | 1],
-           table[i << 2 | 2],
-           table[i << 2 | 3]);
-    if(i < 63)
-      printf(",\n");
+    printf("  {\n");
+    for(i = 0; i < 64; i++)
+    {
+      printf("    0x%08x, 0x%08x, 0x%08x, 0x%08x",
+             table[n][i << 2 | 0],
+             table[n][i << 2 | 1],
+             table[n][i << 2 | 2],
+             table[n][i << 2 | 3]);
+      if(i < 63)
+        printf(",\n");
+      else
+        printf("\n");
+    }
+    if(n < 7)
+      printf("  },\n");
     else
-      printf("\n");
+      printf("  }\n");
   }
   printf("};\n");
 
   return 0;
 }
-
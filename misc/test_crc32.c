@@ -0,0 +1,109 @@
+/*****************************************************************************
+ * test_crc32.c: CRC_32 engines check
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include <stdio.h>
+
+/* The engines are static, build them in this program */
+#include "../src/crc32.c"
+
+#include "test_random.h"
+
+#define TEST_CRC32_SIZE     8192
+#define TEST_CRC32_ALIGN    64
+#define TEST_CRC32_LOOPS    50000
+
+typedef uint32_t (*test_crc32_cb)(uint32_t i_crc, const uint8_t *p_data,
+                                  size_t i_size);
+
+/*****************************************************************************
+ * test_engine
+ *****************************************************************************
+ * Compare an engine with the bytewise one on random data, lengths, initial
+ * values and misalignments. Half of the lengths are short ones, where the
+ * engines switch between their block and tail loops.
+ *****************************************************************************/
+static int test_engine(const char *psz_name, test_crc32_cb pf_crc32)
+{
+  static uint8_t p_buffer[TEST_CRC32_SIZE + TEST_CRC32_ALIGN];
+  uint32_t i_seed = 0x47110815;
+  unsigned int i, i_loop;
+
+  fprintf(stdout, "\"%s\" engine check:\n", psz_name);
+
+  for(i = 0; i < sizeof(p_buffer); i++)
+    p_buffer[i] = test_random(&i_seed);
+
+  /* CRC-32/MPEG-2 check value */
+  if(pf_crc32(0xffffffff, (const uint8_t *)"123456789", 9) != 0x0376e6e7)
+  {
+    fprintf(stderr, "  check value FAILED !!!\n");
+    return 1;
+  }
+
+  for(i_loop = 0; i_loop < TEST_CRC32_LOOPS; i_loop++)
+  {
+    size_t i_offset = test_random(&i_seed) % TEST_CRC32_ALIGN;
+    size_t i_size = (i_loop & 1) ? test_random(&i_seed) % 300
+                                 : test_random(&i_seed) % (TEST_CRC32_SIZE + 1);
+    uint32_t i_init = (i_loop & 2) ? 0xffffffff : test_random(&i_seed);
+    uint32_t i_ref = dvbpsi_crc32_bytewise(i_init, p_buffer + i_offset, i_size);
+    uint32_t i_crc = pf_crc32(i_init, p_buffer + i_offset, i_size);
+
+    if(i_crc != i_ref)
+    {
+      fprintf(stderr, "  offset %u size %u init 0x%08x: 0x%08x instead of "
+              "0x%08x FAILED !!!\n", (unsigned int)i_offset,
+              (unsigned int)i_size, i_init, i_crc, i_ref);
+      return 1;
+    }
+  }
+
+  fprintf(stdout, "  %u random buffers Ok.\n", TEST_CRC32_LOOPS);
+  return 0;
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************/
+int main(void)
+{
+  int i_err = 0;
+
+  i_err |= test_engine("bytewise", dvbpsi_crc32_bytewise);
+  i_err |= test_engine("slicing-by-8", dvbpsi_crc32_sliced);
+#ifdef HAVE_X86_PCLMUL
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3"))
+    i_err |= test_engine("pclmul", dvbpsi_crc32_clmul);
+  else
+    fprintf(stdout, "\"pclmul\" engine not supported by this CPU, skipped\n");
+#endif
+  i_err |= test_engine("dispatched", dvbpsi_crc32);
+
+  if(i_err)
+    fprintf(stderr, "At least one test has FAILED !!!\n");
+  else
+    fprintf(stdout, "All tests succeeded.\n");
+
+  return i_err;
+}
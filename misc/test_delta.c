@@ -0,0 +1,308 @@
+/*****************************************************************************
+ * test_delta.c: table changes check
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+/* The changes are computed by private functions of the library */
+#include "../src/dvbpsi.h"
+#include "../src/dvbpsi_private.h"
+#include "../src/descriptor.h"
+#include "../src/delta.h"
+
+#include "test_random.h"
+
+#define TEST_DELTA_TABLES       20000
+#define TEST_DELTA_KEYS         32
+#define TEST_DELTA_DESCRIPTORS  8
+
+static const uint8_t pi_tags[] = { 0x09, 0x40, 0x41, 0x5f, 0xff };
+#define TEST_DELTA_TAGS (sizeof(pi_tags) / sizeof(pi_tags[0]))
+
+/*****************************************************************************
+ * test_table_t
+ *****************************************************************************
+ * A table as the delta state sees it: elements with a key and some
+ * contents, a loop of descriptors and a field of the table itself.
+ *****************************************************************************/
+typedef struct test_table_s
+{
+  bool                  pb_present[TEST_DELTA_KEYS];
+  uint32_t              pi_contents[TEST_DELTA_KEYS];
+  uint32_t              i_field;
+
+  dvbpsi_descriptor_t  *p_first_descriptor;
+} test_table_t;
+
+/*****************************************************************************
+ * test_table_new
+ *****************************************************************************
+ * Derive a table from the previous one: few contents change, so that most
+ * elements and descriptor loops are unchanged.
+ *****************************************************************************/
+static void test_table_new(test_table_t *p_table, const test_table_t *p_previous,
+                           uint32_t *pi_seed)
+{
+  dvbpsi_descriptor_t *p_last = NULL;
+  unsigned int i, i_descriptors;
+
+  for(i = 0; i < TEST_DELTA_KEYS; i++)
+  {
+    p_table->pb_present[i] = p_previous->pb_present[i];
+    p_table->pi_contents[i] = p_previous->pi_contents[i];
+    if(!(test_random(pi_seed) % 8))
+      p_table->pb_present[i] = !p_table->pb_present[i];
+    if(!(test_random(pi_seed) % 8))
+      p_table->pi_contents[i] = test_random(pi_seed) % 4;
+  }
+  p_table->i_field = p_previous->i_field;
+  if(!(test_random(pi_seed) % 8))
+    p_table->i_field = test_random(pi_seed) % 2;
+
+  /* Descriptors with a few possible payloads and repeated tags */
+  p_table->p_first_descriptor = NULL;
+  i_descriptors = test_random(pi_seed) % (TEST_DELTA_DESCRIPTORS + 1);
+  for(i = 0; i < i_descriptors; i++)
+  {
+    uint8_t p_data[2] = { test_random(pi_seed) % 2, test_random(pi_seed) % 2 };
+    dvbpsi_descriptor_t *p_descriptor
+        = dvbpsi_NewDescriptor(pi_tags[test_random(pi_seed) % TEST_DELTA_TAGS],
+                               1 + test_random(pi_seed) % 2, p_data);
+    if(p_descriptor == NULL)
+      continue;
+    if(p_last)
+      p_last->p_next = p_descriptor;
+    else
+      p_table->p_first_descriptor = p_descriptor;
+    p_last = p_descriptor;
+  }
+}
+
+/*****************************************************************************
+ * test_descriptors_equal
+ *****************************************************************************
+ * Compare the descriptors with one tag of two loops, in order.
+ *****************************************************************************/
+static bool test_descriptors_equal(const dvbpsi_descriptor_t *p_a,
+                                   const dvbpsi_descriptor_t *p_b, uint8_t i_tag)
+{
+  for(;;)
+  {
+    while(p_a && p_a->i_tag != i_tag)
+      p_a = p_a->p_next;
+    while(p_b && p_b->i_tag != i_tag)
+      p_b = p_b->p_next;
+    if(!p_a || !p_b)
+      return !p_a && !p_b;
+    if(p_a->i_length != p_b->i_length
+     || memcmp(p_a->p_data, p_b->p_data, p_a->i_length))
+      return false;
+    p_a = p_a->p_next;
+    p_b = p_b->p_next;
+  }
+}
+
+static const dvbpsi_descriptor_t *test_descriptor_find(const dvbpsi_descriptor_t *p,
+                                                       uint8_t i_tag)
+{
+  while(p && p->i_tag != i_tag)
+    p = p->p_next;
+  return p;
+}
+
+/*****************************************************************************
+ * test_expected
+ *****************************************************************************
+ * Changes between two tables, in the order of dvbpsi_delta_compute(). The
+ * field of the first table is added.
+ *****************************************************************************/
+static unsigned int test_expected(const test_table_t *p_previous,
+                                  const test_table_t *p_table, bool b_first,
+                                  dvbpsi_delta_t *p_deltas)
+{
+  unsigned int i, i_deltas = 0;
+
+  for(i = 0; i < TEST_DELTA_KEYS; i++)
+  {
+    dvbpsi_delta_t *p_delta = &p_deltas[i_deltas];
+    p_delta->i_kind = DVBPSI_DELTA_ELEMENT;
+    p_delta->i_key = i;
+    p_delta->p_element = &p_table->pi_contents[i];
+    if(p_previous->pb_present[i] && !p_table->pb_present[i])
+    {
+      p_delta->i_change = DVBPSI_DELTA_REMOVED;
+      p_delta->p_element = NULL;
+    }
+    else if(!p_previous->pb_present[i] && p_table->pb_present[i])
+      p_delta->i_change = DVBPSI_DELTA_ADDED;
+    else if(p_table->pb_present[i]
+         && p_previous->pi_contents[i] != p_table->pi_contents[i])
+      p_delta->i_change = DVBPSI_DELTA_MODIFIED;
+    else
+      continue;
+    i_deltas++;
+  }
+
+  for(i = 0; i < TEST_DELTA_TAGS; i++)
+  {
+    const dvbpsi_descriptor_t *p_old = test_descriptor_find(
+                                   p_previous->p_first_descriptor, pi_tags[i]);
+    const dvbpsi_descriptor_t *p_new = test_descriptor_find(
+                                   p_table->p_first_descriptor, pi_tags[i]);
+    dvbpsi_delta_t *p_delta = &p_deltas[i_deltas];
+    p_delta->i_kind = DVBPSI_DELTA_DESCRIPTOR;
+    p_delta->i_key = pi_tags[i];
+    p_delta->p_element = p_new;
+    if(p_old && !p_new)
+      p_delta->i_change = DVBPSI_DELTA_REMOVED;
+    else if(!p_old && p_new)
+      p_delta->i_change = DVBPSI_DELTA_ADDED;
+    else if(p_new && !test_descriptors_equal(p_previous->p_first_descriptor,
+                                             p_table->p_first_descriptor,
+                                             pi_tags[i]))
+      p_delta->i_change = DVBPSI_DELTA_MODIFIED;
+    else
+      continue;
+    i_deltas++;
+  }
+
+  if(b_first || p_previous->i_field != p_table->i_field)
+  {
+    dvbpsi_delta_t *p_delta = &p_deltas[i_deltas++];
+    p_delta->i_kind = DVBPSI_DELTA_TABLE;
+    p_delta->i_change = b_first ? DVBPSI_DELTA_ADDED : DVBPSI_DELTA_MODIFIED;
+    p_delta->i_key = 0;
+    p_delta->p_element = p_table;
+  }
+  return i_deltas;
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************
+ * A delta state is given a sequence of random tables, each one derived
+ * from the previous one, and its changes are compared with the ones
+ * computed from the tables themselves.
+ *****************************************************************************/
+int main(void)
+{
+  dvbpsi_delta_t p_expected[TEST_DELTA_KEYS + TEST_DELTA_TAGS + 1];
+  test_table_t p_tables[2];
+  dvbpsi_delta_state_t *p_state = dvbpsi_delta_state_new();
+  uint32_t i_seed = 0x0badcafe;
+  unsigned long i_changes = 0;
+  unsigned int i_table;
+  int i_err = 0;
+
+  fprintf(stdout, "table changes check:\n");
+  if(p_state == NULL)
+  {
+    fprintf(stderr, "  dvbpsi_delta_state_new FAILED !!!\n");
+    return 1;
+  }
+
+  /* The state starts with an empty previous table */
+  memset(&p_tables[1], 0, sizeof(test_table_t));
+
+  for(i_table = 0; i_table < TEST_DELTA_TABLES && !i_err; i_table++)
+  {
+    test_table_t *p_table = &p_tables[i_table & 1];
+    test_table_t *p_previous = &p_tables[!(i_table & 1)];
+    const dvbpsi_delta_t *p_deltas;
+    unsigned int i, i_deltas, i_expected;
+
+    test_table_new(p_table, p_previous, &i_seed);
+
+    /* Add the elements in a random order */
+    for(i = 0; i < TEST_DELTA_KEYS; i++)
+    {
+      unsigned int k = (i * 13 + i_table) % TEST_DELTA_KEYS;
+      if(p_table->pb_present[k])
+        dvbpsi_delta_element_add(p_state, k,
+                dvbpsi_delta_hash(DVBPSI_DELTA_HASH_INIT,
+                                  (const uint8_t *)&p_table->pi_contents[k],
+                                  sizeof(uint32_t)),
+                &p_table->pi_contents[k]);
+    }
+    dvbpsi_delta_descriptors_add(p_state, p_table->p_first_descriptor);
+    dvbpsi_delta_table_add(p_state,
+            dvbpsi_delta_hash(DVBPSI_DELTA_HASH_INIT,
+                              (const uint8_t *)&p_table->i_field, sizeof(uint32_t)),
+            p_table);
+
+    if(!dvbpsi_delta_compute(p_state, &p_deltas, &i_deltas))
+    {
+      fprintf(stderr, "  table %u: dvbpsi_delta_compute FAILED !!!\n", i_table);
+      i_err = 1;
+      break;
+    }
+
+    i_expected = test_expected(p_previous, p_table, i_table == 0, p_expected);
+    i_changes += i_expected;
+    if(i_deltas != i_expected)
+    {
+      fprintf(stderr, "  table %u: %u changes instead of %u FAILED !!!\n",
+              i_table, i_deltas, i_expected);
+      i_err = 1;
+    }
+    for(i = 0; i < i_deltas && !i_err; i++)
+    {
+      if(p_deltas[i].i_kind != p_expected[i].i_kind
+       || p_deltas[i].i_change != p_expected[i].i_change
+       || p_deltas[i].i_key != p_expected[i].i_key
+       || p_deltas[i].p_element != p_expected[i].p_element)
+      {
+        fprintf(stderr, "  table %u: change %u is %d/%d/%u instead of %d/%d/%u"
+                " FAILED !!!\n", i_table, i,
+                p_deltas[i].i_kind, p_deltas[i].i_change, p_deltas[i].i_key,
+                p_expected[i].i_kind, p_expected[i].i_change, p_expected[i].i_key);
+        i_err = 1;
+      }
+    }
+
+    dvbpsi_DeleteDescriptors(p_previous->p_first_descriptor);
+    p_previous->p_first_descriptor = NULL;
+  }
+
+  dvbpsi_DeleteDescriptors(p_tables[0].p_first_descriptor);
+  dvbpsi_DeleteDescriptors(p_tables[1].p_first_descriptor);
+  dvbpsi_delta_state_delete(p_state);
+
+  if(i_err)
+    fprintf(stderr, "At least one test has FAILED !!!\n");
+  else
+    fprintf(stdout, "  %u random tables, %lu changes Ok.\n"
+            "All tests succeeded.\n", TEST_DELTA_TABLES, i_changes);
+
+  return i_err;
+}
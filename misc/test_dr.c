@@ -27,6 +27,7 @@
 #endif
 
 #include "test_dr.h"
+#include "test_dr_compact.h"
 
   
 /* video stream (b_mpeg2 = false) */
@@ -643,6 +644,104 @@ static int main_service_(void)
   return i_err;
 }
 
+/* ISO 639 language (compact) */
+static int main_compact_iso639(void)
+{
+  return compact_check("ISO 639 language", 0x0a,
+                       compact_check_iso639);
+}
+
+/* network name (compact) */
+static int main_compact_network_name(void)
+{
+  return compact_check("network name", 0x40,
+                       compact_check_network_name);
+}
+
+/* service list (compact) */
+static int main_compact_service_list(void)
+{
+  return compact_check("service list", 0x41,
+                       compact_check_service_list);
+}
+
+/* bouquet name (compact) */
+static int main_compact_bouquet_name(void)
+{
+  return compact_check("bouquet name", 0x47,
+                       compact_check_bouquet_name);
+}
+
+/* service (compact) */
+static int main_compact_service(void)
+{
+  return compact_check("service", 0x48,
+                       compact_check_service);
+}
+
+/* country availability (compact) */
+static int main_compact_country_availability(void)
+{
+  return compact_check("country availability", 0x49,
+                       compact_check_country_availability);
+}
+
+/* NVOD reference (compact) */
+static int main_compact_nvod_ref(void)
+{
+  return compact_check("NVOD reference", 0x4b,
+                       compact_check_nvod_ref);
+}
+
+/* short event (compact) */
+static int main_compact_short_event(void)
+{
+  return compact_check("short event", 0x4d,
+                       compact_check_short_event);
+}
+
+/* extended event (compact) */
+static int main_compact_extended_event(void)
+{
+  return compact_check("extended event", 0x4e,
+                       compact_check_extended_event);
+}
+
+/* CA identifier (compact) */
+static int main_compact_ca_identifier(void)
+{
+  return compact_check("CA identifier", 0x53,
+                       compact_check_ca_identifier);
+}
+
+/* content (compact) */
+static int main_compact_content(void)
+{
+  return compact_check("content", 0x54,
+                       compact_check_content);
+}
+
+/* parental rating (compact) */
+static int main_compact_parental_rating(void)
+{
+  return compact_check("parental rating", 0x55,
+                       compact_check_parental_rating);
+}
+
+/* frequency list (compact) */
+static int main_compact_frequency_list(void)
+{
+  return compact_check("frequency list", 0x62,
+                       compact_check_frequency_list);
+}
+
+/* logical channel number (compact) */
+static int main_compact_lcn(void)
+{
+  return compact_check("logical channel number", 0x83,
+                       compact_check_lcn);
+}
+
 
 /* main function */
 int main(void)
@@ -664,6 +763,20 @@ int main(void)
   i_err |= main_max_bitrate_();
   i_err |= main_private_data_();
   i_err |= main_service_();
+  i_err |= main_compact_iso639();
+  i_err |= main_compact_network_name();
+  i_err |= main_compact_service_list();
+  i_err |= main_compact_bouquet_name();
+  i_err |= main_compact_service();
+  i_err |= main_compact_country_availability();
+  i_err |= main_compact_nvod_ref();
+  i_err |= main_compact_short_event();
+  i_err |= main_compact_extended_event();
+  i_err |= main_compact_ca_identifier();
+  i_err |= main_compact_content();
+  i_err |= main_compact_parental_rating();
+  i_err |= main_compact_frequency_list();
+  i_err |= main_compact_lcn();
 
   if(i_err)
     fprintf(stderr, "At least one test has FAILED !!!\n");
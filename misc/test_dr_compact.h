@@ -0,0 +1,601 @@
+/*****************************************************************************
+ * test_dr_compact.h: compact descriptor decoders check
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ * Each compact decoder is given descriptors of every length with random
+ * payloads, most bytes being small so that the length fields they hold
+ * often fit. A compact decoding must give the same fields as the full one.
+ * The full decoders which read past malformed descriptors are only called
+ * on the descriptors the compact decoder accepts, its rejections are then
+ * checked against the descriptor syntax.
+ *****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#define BOZO_COMPACT_LOOPS 64
+
+#define BOZO_COMPACT_CHECK(cond)                                        \
+  if(!(cond))                                                           \
+  {                                                                     \
+    fprintf(stdout, "    \"%s\" failed on a %u bytes descriptor\n",     \
+            #cond, p_descriptor->i_length);                             \
+    i_err = 1;                                                          \
+    goto out;                                                           \
+  }
+
+typedef int (*compact_check_cb)(dvbpsi_descriptor_t *p_descriptor,
+                                bool *pb_decoded);
+
+/*****************************************************************************
+ * compact_random
+ *****************************************************************************/
+static uint32_t compact_random(uint32_t *pi_seed)
+{
+  *pi_seed = *pi_seed * 1103515245 + 12345;
+  return *pi_seed >> 8;
+}
+
+/*****************************************************************************
+ * compact_check
+ *****************************************************************************
+ * Run a check on descriptors of all lengths, and make sure the compact
+ * decoder rejects another tag and accepts some of the payloads.
+ *****************************************************************************/
+static int compact_check(const char *psz_name, uint8_t i_tag,
+                         compact_check_cb pf_check)
+{
+  uint8_t p_data[255];
+  uint32_t i_seed = 0x19790815 ^ i_tag;
+  unsigned int i_length, i_loop, i_decoded = 0;
+  int i_err = 0;
+
+  fprintf(stdout, "\"%s\" compact descriptor check:\n", psz_name);
+
+  for(i_length = 0; i_length < 256 && !i_err; i_length++)
+  {
+    for(i_loop = 0; i_loop < BOZO_COMPACT_LOOPS && !i_err; i_loop++)
+    {
+      dvbpsi_descriptor_t *p_descriptor;
+      bool b_decoded = false;
+      unsigned int i;
+
+      for(i = 0; i < i_length; i++)
+        p_data[i] = (compact_random(&i_seed) & 1) ? compact_random(&i_seed) % 8
+                                                  : compact_random(&i_seed);
+
+      /* The first payload of each length is checked with another tag */
+      p_descriptor = dvbpsi_NewDescriptor(i_loop ? i_tag : i_tag ^ 0x01,
+                                          i_length, p_data);
+      if(p_descriptor == NULL)
+      {
+        i_err = 1;
+        break;
+      }
+      i_err |= pf_check(p_descriptor, &b_decoded);
+      if(!i_loop && b_decoded)
+      {
+        fprintf(stdout, "    tag 0x%02x decoded\n", p_descriptor->i_tag);
+        i_err = 1;
+      }
+      if(i_loop && b_decoded)
+        i_decoded++;
+      dvbpsi_DeleteDescriptors(p_descriptor);
+    }
+  }
+
+  if(!i_decoded)
+  {
+    fprintf(stdout, "    no descriptor decoded\n");
+    i_err = 1;
+  }
+
+  if(i_err)
+    fprintf(stderr, "\"%s\" compact descriptor check FAILED !!!\n\n", psz_name);
+  else
+    fprintf(stdout, "  %u descriptors decoded Ok.\n"
+            "\"%s\" compact descriptor check succeeded\n\n", i_decoded, psz_name);
+
+  return i_err;
+}
+
+/*****************************************************************************
+ * ISO 639 language
+ *****************************************************************************/
+static int compact_check_iso639(dvbpsi_descriptor_t *p_descriptor, bool *pb_decoded)
+{
+  dvbpsi_iso639_compact_dr_t *p_compact = dvbpsi_DecodeISO639CompactDr(p_descriptor);
+  dvbpsi_iso639_dr_t *p_full = dvbpsi_DecodeISO639Dr(p_descriptor);
+  int i, i_err = 0;
+
+  *pb_decoded = (p_compact != NULL);
+  BOZO_COMPACT_CHECK(!p_compact == !p_full);
+  if(p_compact)
+  {
+    BOZO_COMPACT_CHECK(p_compact->i_code_count == p_full->i_code_count);
+    for(i = 0; i < p_full->i_code_count; i++)
+    {
+      BOZO_COMPACT_CHECK(!memcmp(p_compact->code[i].iso_639_code,
+                                 p_full->code[i].iso_639_code, 3));
+      BOZO_COMPACT_CHECK(p_compact->code[i].i_audio_type
+                         == p_full->code[i].i_audio_type);
+    }
+  }
+out:
+  free(p_compact);
+  return i_err;
+}
+
+/*****************************************************************************
+ * network name
+ *****************************************************************************/
+static int compact_check_network_name(dvbpsi_descriptor_t *p_descriptor,
+                                      bool *pb_decoded)
+{
+  dvbpsi_network_name_compact_dr_t *p_compact
+                                = dvbpsi_DecodeNetworkNameCompactDr(p_descriptor);
+  dvbpsi_network_name_dr_t *p_full = dvbpsi_DecodeNetworkNameDr(p_descriptor);
+  int i_err = 0;
+
+  *pb_decoded = (p_compact != NULL);
+  BOZO_COMPACT_CHECK(!p_compact == !p_full);
+  if(p_compact)
+  {
+    BOZO_COMPACT_CHECK(p_compact->i_name_length == p_full->i_name_length);
+    BOZO_COMPACT_CHECK(!memcmp(p_compact->i_name_byte, p_full->i_name_byte,
+                               p_full->i_name_length));
+  }
+out:
+  free(p_compact);
+  return i_err;
+}
+
+/*****************************************************************************
+ * service list
+ *****************************************************************************
+ * The full decoder is limited to 63 services, the compact one takes all the
+ * well-formed lengths, up to 85 services.
+ *****************************************************************************/
+static int compact_check_service_list(dvbpsi_descriptor_t *p_descriptor,
+                                      bool *pb_decoded)
+{
+  dvbpsi_service_list_compact_dr_t *p_compact
+                                = dvbpsi_DecodeServiceListCompactDr(p_descriptor);
+  dvbpsi_service_list_dr_t *p_full = dvbpsi_DecodeServiceListDr(p_descriptor);
+  const uint8_t *p_data = p_descriptor->p_data;
+  int i, i_err = 0;
+
+  *pb_decoded = (p_compact != NULL);
+  BOZO_COMPACT_CHECK(!p_compact == (p_descriptor->i_tag != 0x41
+                                    || p_descriptor->i_length < 3
+                                    || p_descriptor->i_length % 3));
+  if(p_descriptor->i_length <= 63 * 3)
+    BOZO_COMPACT_CHECK(!p_compact == !p_full);
+  if(p_compact)
+  {
+    BOZO_COMPACT_CHECK(p_compact->i_service_count == p_descriptor->i_length / 3);
+    for(i = 0; i < p_compact->i_service_count; i++)
+    {
+      BOZO_COMPACT_CHECK(p_compact->i_service[i].i_service_id
+                         == ((p_data[3 * i] << 8) | p_data[3 * i + 1]));
+      BOZO_COMPACT_CHECK(p_compact->i_service[i].i_service_type
+                         == p_data[3 * i + 2]);
+      if(!p_full)
+        continue;
+      BOZO_COMPACT_CHECK(p_compact->i_service[i].i_service_id
+                         == p_full->i_service[i].i_service_id);
+      BOZO_COMPACT_CHECK(p_compact->i_service[i].i_service_type
+                         == p_full->i_service[i].i_service_type);
+    }
+  }
+out:
+  free(p_compact);
+  return i_err;
+}
+
+/*****************************************************************************
+ * bouquet name
+ *****************************************************************************/
+static int compact_check_bouquet_name(dvbpsi_descriptor_t *p_descriptor,
+                                      bool *pb_decoded)
+{
+  dvbpsi_bouquet_name_compact_dr_t *p_compact
+                                = dvbpsi_DecodeBouquetNameCompactDr(p_descriptor);
+  dvbpsi_bouquet_name_dr_t *p_full = dvbpsi_DecodeBouquetNameDr(p_descriptor);
+  int i_err = 0;
+
+  *pb_decoded = (p_compact != NULL);
+  BOZO_COMPACT_CHECK(!p_compact == !p_full);
+  if(p_compact)
+  {
+    BOZO_COMPACT_CHECK(p_compact->i_name_length == p_full->i_name_length);
+    BOZO_COMPACT_CHECK(!memcmp(p_compact->i_char, p_full->i_char,
+                               p_full->i_name_length));
+  }
+out:
+  free(p_compact);
+  return i_err;
+}
+
+/*****************************************************************************
+ * service
+ *****************************************************************************
+ * The decoders differ on truncated names, the full one keeps their length,
+ * the compact one leaves them empty.
+ *****************************************************************************/
+static int compact_check_service(dvbpsi_descriptor_t *p_descriptor, bool *pb_decoded)
+{
+  dvbpsi_service_compact_dr_t *p_compact = dvbpsi_DecodeServiceCompactDr(p_descriptor);
+  dvbpsi_service_dr_t *p_full = dvbpsi_DecodeServiceDr(p_descriptor);
+  const uint8_t *p_data = p_descriptor->p_data;
+  const unsigned int i_length = p_descriptor->i_length;
+  int i_err = 0;
+
+  *pb_decoded = (p_compact != NULL);
+  BOZO_COMPACT_CHECK(!p_compact == !p_full);
+  if(p_compact)
+  {
+    const unsigned int i_provider = p_data[1];
+    BOZO_COMPACT_CHECK(p_compact->i_service_type == p_full->i_service_type);
+    if(i_provider + 3 > i_length)
+    {
+      BOZO_COMPACT_CHECK(p_compact->i_service_provider_name_length == 0);
+      BOZO_COMPACT_CHECK(p_compact->i_service_name_length == 0);
+      goto out;
+    }
+    BOZO_COMPACT_CHECK(p_compact->i_service_provider_name_length
+                       == p_full->i_service_provider_name_length);
+    BOZO_COMPACT_CHECK(!memcmp(p_compact->i_service_provider_name,
+                               p_full->i_service_provider_name, i_provider));
+    if(i_provider + 3 + p_data[2 + i_provider] > i_length)
+    {
+      BOZO_COMPACT_CHECK(p_compact->i_service_name_length == 0);
+      goto out;
+    }
+    BOZO_COMPACT_CHECK(p_compact->i_service_name_length
+                       == p_full->i_service_name_length);
+    BOZO_COMPACT_CHECK(!memcmp(p_compact->i_service_name, p_full->i_service_name,
+                               p_full->i_service_name_length));
+  }
+out:
+  free(p_compact);
+  return i_err;
+}
+
+/*****************************************************************************
+ * country availability
+ *****************************************************************************
+ * The full decoder is limited to 83 countries, the compact one takes all the
+ * well-formed lengths, up to 84 countries.
+ *****************************************************************************/
+static int compact_check_country_availability(dvbpsi_descriptor_t *p_descriptor,
+                                              bool *pb_decoded)
+{
+  dvbpsi_country_availability_compact_dr_t *p_compact
+                        = dvbpsi_DecodeCountryAvailabilityCompactDr(p_descriptor);
+  dvbpsi_country_availability_dr_t *p_full
+                        = dvbpsi_DecodeCountryAvailability(p_descriptor);
+  const uint8_t *p_data = p_descriptor->p_data;
+  int i, i_err = 0;
+
+  *pb_decoded = (p_compact != NULL);
+  BOZO_COMPACT_CHECK(!p_compact == (p_descriptor->i_tag != 0x49
+                                    || p_descriptor->i_length < 1
+                                    || (p_descriptor->i_length - 1) % 3));
+  if(p_descriptor->i_length <= 1 + 83 * 3)
+    BOZO_COMPACT_CHECK(!p_compact == !p_full);
+  if(p_compact)
+  {
+    BOZO_COMPACT_CHECK(p_compact->i_code_count == (p_descriptor->i_length - 1) / 3);
+    BOZO_COMPACT_CHECK(p_compact->b_country_availability_flag
+                       == !!(p_data[0] & 0x80));
+    for(i = 0; i < p_compact->i_code_count; i++)
+    {
+      BOZO_COMPACT_CHECK(!memcmp(p_compact->code[i].iso_639_code,
+                                 &p_data[1 + 3 * i], 3));
+      if(!p_full)
+        continue;
+      BOZO_COMPACT_CHECK(p_compact->b_country_availability_flag
+                         == p_full->b_country_availability_flag);
+      BOZO_COMPACT_CHECK(!memcmp(p_compact->code[i].iso_639_code,
+                                 p_full->code[i].iso_639_code, 3));
+    }
+  }
+out:
+  free(p_compact);
+  return i_err;
+}
+
+/*****************************************************************************
+ * NVOD reference
+ *****************************************************************************/
+static int compact_check_nvod_ref(dvbpsi_descriptor_t *p_descriptor, bool *pb_decoded)
+{
+  dvbpsi_nvod_ref_compact_dr_t *p_compact
+                                = dvbpsi_DecodeNVODReferenceCompactDr(p_descriptor);
+  dvbpsi_nvod_ref_dr_t *p_full = dvbpsi_DecodeNVODReferenceDr(p_descriptor);
+  int i, i_err = 0;
+
+  *pb_decoded = (p_compact != NULL);
+  BOZO_COMPACT_CHECK(!p_compact == !p_full);
+  if(p_compact)
+  {
+    BOZO_COMPACT_CHECK(p_compact->i_references == p_full->i_references);
+    for(i = 0; i < p_full->i_references; i++)
+    {
+      BOZO_COMPACT_CHECK(p_compact->p_nvod_refs[i].i_transport_stream_id
+                         == p_full->p_nvod_refs[i].i_transport_stream_id);
+      BOZO_COMPACT_CHECK(p_compact->p_nvod_refs[i].i_original_network_id
+                         == p_full->p_nvod_refs[i].i_original_network_id);
+      BOZO_COMPACT_CHECK(p_compact->p_nvod_refs[i].i_service_id
+                         == p_full->p_nvod_refs[i].i_service_id);
+    }
+  }
+out:
+  free(p_compact);
+  return i_err;
+}
+
+/*****************************************************************************
+ * short event
+ *****************************************************************************
+ * The full decoder reads the text length past a truncated event name.
+ *****************************************************************************/
+static int compact_check_short_event(dvbpsi_descriptor_t *p_descriptor,
+                                     bool *pb_decoded)
+{
+  dvbpsi_short_event_compact_dr_t *p_compact
+                                = dvbpsi_DecodeShortEventCompactDr(p_descriptor);
+  const uint8_t *p_data = p_descriptor->p_data;
+  const unsigned int i_length = p_descriptor->i_length;
+  dvbpsi_short_event_dr_t *p_full;
+  int i_err = 0;
+
+  *pb_decoded = (p_compact != NULL);
+  if(!p_compact)
+  {
+    if(p_descriptor->i_tag == 0x4d && i_length >= 5)
+      BOZO_COMPACT_CHECK(5u + p_data[3] > i_length
+                         || 5u + p_data[3] + p_data[4 + p_data[3]] > i_length);
+    goto out;
+  }
+
+  p_full = dvbpsi_DecodeShortEventDr(p_descriptor);
+  BOZO_COMPACT_CHECK(p_full);
+  BOZO_COMPACT_CHECK(!memcmp(p_compact->i_iso_639_code, p_full->i_iso_639_code, 3));
+  BOZO_COMPACT_CHECK(p_compact->i_event_name_length == p_full->i_event_name_length);
+  BOZO_COMPACT_CHECK(!memcmp(p_compact->i_event_name, p_full->i_event_name,
+                             p_full->i_event_name_length));
+  BOZO_COMPACT_CHECK(p_compact->i_text_length == p_full->i_text_length);
+  BOZO_COMPACT_CHECK(!memcmp(p_compact->i_text, p_full->i_text,
+                             p_full->i_text_length));
+out:
+  free(p_compact);
+  return i_err;
+}
+
+/*****************************************************************************
+ * extended event
+ *****************************************************************************
+ * The full decoder does not check that the items and text fit.
+ *****************************************************************************/
+static int compact_check_extended_event(dvbpsi_descriptor_t *p_descriptor,
+                                        bool *pb_decoded)
+{
+  dvbpsi_extended_event_compact_dr_t *p_compact
+                                = dvbpsi_DecodeExtendedEventCompactDr(p_descriptor);
+  const uint8_t *p_data = p_descriptor->p_data;
+  const unsigned int i_length = p_descriptor->i_length;
+  dvbpsi_extended_event_dr_t *p_full;
+  int i, i_err = 0;
+
+  *pb_decoded = (p_compact != NULL);
+  if(!p_compact)
+  {
+    if(p_descriptor->i_tag == 0x4e && i_length >= 6)
+    {
+      /* Some item or the text does not fit */
+      const unsigned int i_end = 5 + p_data[4];
+      unsigned int i_pos = 5;
+      bool b_fit = true;
+      while(b_fit && i_end < i_length && i_pos < i_end)
+      {
+        i_pos += 1 + p_data[i_pos];
+        if(i_pos >= i_end)
+          b_fit = false;
+        else
+          i_pos += 1 + p_data[i_pos];
+        if(i_pos > i_end)
+          b_fit = false;
+      }
+      BOZO_COMPACT_CHECK(i_end >= i_length || !b_fit
+                         || i_end + 1 + p_data[i_end] > i_length);
+    }
+    goto out;
+  }
+
+  p_full = dvbpsi_DecodeExtendedEventDr(p_descriptor);
+  BOZO_COMPACT_CHECK(p_full);
+  BOZO_COMPACT_CHECK(p_compact->i_descriptor_number == p_full->i_descriptor_number);
+  BOZO_COMPACT_CHECK(p_compact->i_last_descriptor_number
+                     == p_full->i_last_descriptor_number);
+  BOZO_COMPACT_CHECK(!memcmp(p_compact->i_iso_639_code, p_full->i_iso_639_code, 3));
+  BOZO_COMPACT_CHECK(p_compact->i_entry_count == p_full->i_entry_count);
+  for(i = 0; i < p_full->i_entry_count; i++)
+  {
+    BOZO_COMPACT_CHECK(p_compact->i_item_description_length[i]
+                       == p_full->i_item_description_length[i]);
+    BOZO_COMPACT_CHECK(!memcmp(p_compact->i_item_description[i],
+                               p_full->i_item_description[i],
+                               p_full->i_item_description_length[i]));
+    BOZO_COMPACT_CHECK(p_compact->i_item_length[i] == p_full->i_item_length[i]);
+    BOZO_COMPACT_CHECK(!memcmp(p_compact->i_item[i], p_full->i_item[i],
+                               p_full->i_item_length[i]));
+  }
+  BOZO_COMPACT_CHECK(p_compact->i_text_length == p_full->i_text_length);
+  BOZO_COMPACT_CHECK(!memcmp(p_compact->i_text, p_full->i_text,
+                             p_full->i_text_length));
+out:
+  free(p_compact);
+  return i_err;
+}
+
+/*****************************************************************************
+ * CA identifier
+ *****************************************************************************/
+static int compact_check_ca_identifier(dvbpsi_descriptor_t *p_descriptor,
+                                       bool *pb_decoded)
+{
+  dvbpsi_ca_identifier_compact_dr_t *p_compact
+                                = dvbpsi_DecodeCAIdentifierCompactDr(p_descriptor);
+  dvbpsi_ca_identifier_dr_t *p_full = dvbpsi_DecodeCAIdentifierDr(p_descriptor);
+  int i, i_err = 0;
+
+  *pb_decoded = (p_compact != NULL);
+  BOZO_COMPACT_CHECK(!p_compact == !p_full);
+  if(p_compact)
+  {
+    BOZO_COMPACT_CHECK(p_compact->i_number == p_full->i_number);
+    for(i = 0; i < p_full->i_number; i++)
+      BOZO_COMPACT_CHECK(p_compact->p_system[i].i_ca_system_id
+                         == p_full->p_system[i].i_ca_system_id);
+  }
+out:
+  free(p_compact);
+  return i_err;
+}
+
+/*****************************************************************************
+ * content
+ *****************************************************************************
+ * The full decoder keeps the first 64 contents, the compact one all of them.
+ *****************************************************************************/
+static int compact_check_content(dvbpsi_descriptor_t *p_descriptor, bool *pb_decoded)
+{
+  dvbpsi_content_compact_dr_t *p_compact = dvbpsi_DecodeContentCompactDr(p_descriptor);
+  dvbpsi_content_dr_t *p_full = dvbpsi_DecodeContentDr(p_descriptor);
+  const uint8_t *p_data = p_descriptor->p_data;
+  int i, i_err = 0;
+
+  *pb_decoded = (p_compact != NULL);
+  BOZO_COMPACT_CHECK(!p_compact == !p_full);
+  if(p_compact)
+  {
+    BOZO_COMPACT_CHECK(p_compact->i_contents_number == p_descriptor->i_length / 2);
+    for(i = 0; i < p_compact->i_contents_number; i++)
+    {
+      BOZO_COMPACT_CHECK(p_compact->p_content[i].i_type == p_data[2 * i]);
+      BOZO_COMPACT_CHECK(p_compact->p_content[i].i_user_byte == p_data[2 * i + 1]);
+      if(i >= p_full->i_contents_number)
+        continue;
+      BOZO_COMPACT_CHECK(p_compact->p_content[i].i_type
+                         == p_full->p_content[i].i_type);
+      BOZO_COMPACT_CHECK(p_compact->p_content[i].i_user_byte
+                         == p_full->p_content[i].i_user_byte);
+    }
+  }
+out:
+  free(p_compact);
+  return i_err;
+}
+
+/*****************************************************************************
+ * parental rating
+ *****************************************************************************/
+static int compact_check_parental_rating(dvbpsi_descriptor_t *p_descriptor,
+                                         bool *pb_decoded)
+{
+  dvbpsi_parental_rating_compact_dr_t *p_compact
+                                = dvbpsi_DecodeParentalRatingCompactDr(p_descriptor);
+  dvbpsi_parental_rating_dr_t *p_full = dvbpsi_DecodeParentalRatingDr(p_descriptor);
+  int i, i_err = 0;
+
+  *pb_decoded = (p_compact != NULL);
+  BOZO_COMPACT_CHECK(!p_compact == !p_full);
+  if(p_compact)
+  {
+    BOZO_COMPACT_CHECK(p_compact->i_ratings_number == p_full->i_ratings_number);
+    for(i = 0; i < p_full->i_ratings_number; i++)
+    {
+      BOZO_COMPACT_CHECK(p_compact->p_parental_rating[i].i_country_code
+                         == p_full->p_parental_rating[i].i_country_code);
+      BOZO_COMPACT_CHECK(p_compact->p_parental_rating[i].i_rating
+                         == p_full->p_parental_rating[i].i_rating);
+    }
+  }
+out:
+  free(p_compact);
+  return i_err;
+}
+
+/*****************************************************************************
+ * frequency list
+ *****************************************************************************/
+static int compact_check_frequency_list(dvbpsi_descriptor_t *p_descriptor,
+                                        bool *pb_decoded)
+{
+  dvbpsi_frequency_list_compact_dr_t *p_compact
+                                = dvbpsi_DecodeFrequencyListCompactDr(p_descriptor);
+  dvbpsi_frequency_list_dr_t *p_full = dvbpsi_DecodeFrequencyListDr(p_descriptor);
+  int i, i_err = 0;
+
+  *pb_decoded = (p_compact != NULL);
+  BOZO_COMPACT_CHECK(!p_compact == !p_full);
+  if(p_compact)
+  {
+    BOZO_COMPACT_CHECK(p_compact->i_coding_type == p_full->i_coding_type);
+    BOZO_COMPACT_CHECK(p_compact->i_number_of_frequencies
+                       == p_full->i_number_of_frequencies);
+    for(i = 0; i < p_full->i_number_of_frequencies; i++)
+      BOZO_COMPACT_CHECK(p_compact->p_center_frequencies[i]
+                         == p_full->p_center_frequencies[i]);
+  }
+out:
+  free(p_compact);
+  return i_err;
+}
+
+/*****************************************************************************
+ * logical channel number
+ *****************************************************************************/
+static int compact_check_lcn(dvbpsi_descriptor_t *p_descriptor, bool *pb_decoded)
+{
+  dvbpsi_lcn_compact_dr_t *p_compact = dvbpsi_DecodeLCNCompactDr(p_descriptor);
+  dvbpsi_lcn_dr_t *p_full = dvbpsi_DecodeLCNDr(p_descriptor);
+  int i, i_err = 0;
+
+  *pb_decoded = (p_compact != NULL);
+  BOZO_COMPACT_CHECK(!p_compact == !p_full);
+  if(p_compact)
+  {
+    BOZO_COMPACT_CHECK(p_compact->i_number_of_entries == p_full->i_number_of_entries);
+    for(i = 0; i < p_full->i_number_of_entries; i++)
+    {
+      BOZO_COMPACT_CHECK(p_compact->p_entries[i].i_service_id
+                         == p_full->p_entries[i].i_service_id);
+      BOZO_COMPACT_CHECK(p_compact->p_entries[i].b_visible_service_flag
+                         == p_full->p_entries[i].b_visible_service_flag);
+      BOZO_COMPACT_CHECK(p_compact->p_entries[i].i_logical_channel_number
+                         == p_full->p_entries[i].i_logical_channel_number);
+    }
+  }
+out:
+  free(p_compact);
+  return i_err;
+}
@@ -0,0 +1,190 @@
+/*****************************************************************************
+ * test_filter.c: section filters check
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+/* The filters are matched by a private function of the library */
+#include "../src/dvbpsi.h"
+#include "../src/dvbpsi_private.h"
+
+#include "test_random.h"
+
+#define TEST_FILTER_LOOPS       200000
+#define TEST_FILTER_MAX_FILTERS 3
+#define TEST_FILTER_MAX_LENGTH  30
+
+/*****************************************************************************
+ * test_reference
+ *****************************************************************************
+ * Straightforward dmx_filter_t matching of a complete section. A section
+ * byte which does not exist fails the positive bits and differs from none
+ * of the negative bits.
+ *****************************************************************************/
+static bool test_reference(const dvbpsi_section_filter_t *p_filters,
+                           unsigned int i_filters,
+                           const uint8_t *p_section, size_t i_total)
+{
+  unsigned int f;
+  int i;
+
+  for(f = 0; f < i_filters; f++)
+  {
+    const dvbpsi_section_filter_t *p_filter = &p_filters[f];
+    bool b_match = true, b_negative = false, b_differ = false;
+
+    for(i = 0; i < DVBPSI_FILTER_SIZE; i++)
+    {
+      const size_t j = (i == 0) ? 0 : i + 2;
+      const uint8_t i_positive = p_filter->i_mask[i] & ~p_filter->i_mode[i];
+      const uint8_t i_negative = p_filter->i_mask[i] & p_filter->i_mode[i];
+
+      if(i_negative)
+        b_negative = true;
+      if(j >= i_total)
+      {
+        if(i_positive)
+          b_match = false;
+        continue;
+      }
+      if((p_section[j] ^ p_filter->i_filter[i]) & i_positive)
+        b_match = false;
+      if((p_section[j] ^ p_filter->i_filter[i]) & i_negative)
+        b_differ = true;
+    }
+
+    if(b_match && (!b_negative || b_differ))
+      return true;
+  }
+  return false;
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************
+ * Random sections are matched against random filters derived from them.
+ * A complete section must match like the reference. A partial one must
+ * match whenever the complete one does, and exactly like it once all the
+ * filtered bytes are there.
+ *****************************************************************************/
+int main(void)
+{
+  dvbpsi_section_filter_t p_filters[TEST_FILTER_MAX_FILTERS];
+  uint8_t p_section[3 + TEST_FILTER_MAX_LENGTH + 1];
+  uint32_t i_seed = 0x2a2a2a2a;
+  unsigned long i_matched = 0;
+  unsigned int i_loop;
+  int i_err = 0;
+
+  fprintf(stdout, "section filters check:\n");
+
+  for(i_loop = 0; i_loop < TEST_FILTER_LOOPS && !i_err; i_loop++)
+  {
+    dvbpsi_t *p_dvbpsi = dvbpsi_new(NULL, DVBPSI_MSG_NONE);
+    size_t i_length = test_random(&i_seed) % (TEST_FILTER_MAX_LENGTH + 1);
+    size_t i_total = 3 + i_length;
+    unsigned int i_filters = 1 + test_random(&i_seed) % TEST_FILTER_MAX_FILTERS;
+    unsigned int f;
+    size_t i, i_size;
+    bool b_reference;
+
+    if(p_dvbpsi == NULL)
+    {
+      fprintf(stderr, "  dvbpsi_new FAILED !!!\n");
+      return 1;
+    }
+
+    for(i = 0; i < i_total; i++)
+      p_section[i] = test_random(&i_seed);
+    p_section[1] = 0xb0 | (i_length >> 8);
+    p_section[2] = i_length & 0xff;
+
+    /* Filters on a few bytes, close to the section ones */
+    for(f = 0; f < i_filters; f++)
+    {
+      dvbpsi_section_filter_t *p_filter = &p_filters[f];
+      memset(p_filter, 0, sizeof(dvbpsi_section_filter_t));
+      for(i = 0; i < DVBPSI_FILTER_SIZE; i++)
+      {
+        const size_t j = (i == 0) ? 0 : i + 2;
+        if(test_random(&i_seed) % 4)
+          continue;
+        p_filter->i_mask[i] = test_random(&i_seed);
+        p_filter->i_filter[i] = (j < i_total) ? p_section[j] : 0;
+        if(!(test_random(&i_seed) % 4))
+          p_filter->i_filter[i] ^= 1 << (test_random(&i_seed) % 8);
+        if(!(test_random(&i_seed) % 4))
+          p_filter->i_mode[i] = test_random(&i_seed) & p_filter->i_mask[i];
+      }
+      if(!dvbpsi_section_filter_add(p_dvbpsi, p_filter))
+      {
+        fprintf(stderr, "  dvbpsi_section_filter_add FAILED !!!\n");
+        i_err = 1;
+      }
+    }
+
+    b_reference = test_reference(p_filters, i_filters, p_section, i_total);
+    if(b_reference)
+      i_matched++;
+
+    /* Every prefix of the section, then the section followed by stuffing */
+    for(i_size = 0; i_size <= i_total + 1 && !i_err; i_size++)
+    {
+      bool b_match;
+      if(i_size == i_total + 1)
+        p_section[i_total] = 0xff;
+      b_match = dvbpsi_section_filters_match(p_dvbpsi->p_filters,
+                                             p_section, i_size);
+      if((b_reference && !b_match)
+       || (i_size >= i_total && b_match != b_reference)
+       || (i_size >= DVBPSI_FILTER_SIZE + 2 && b_match != b_reference))
+      {
+        fprintf(stderr, "  loop %u: %u of %u bytes match %d instead of %d"
+                " FAILED !!!\n", i_loop, (unsigned int)i_size,
+                (unsigned int)i_total, b_match, b_reference);
+        i_err = 1;
+      }
+    }
+
+    dvbpsi_section_filter_clear(p_dvbpsi);
+    dvbpsi_delete(p_dvbpsi);
+  }
+
+  if(i_err)
+    fprintf(stderr, "At least one test has FAILED !!!\n");
+  else
+    fprintf(stdout, "  %u random sections, %lu matching Ok.\n"
+            "All tests succeeded.\n", TEST_FILTER_LOOPS, i_matched);
+
+  return i_err;
+}
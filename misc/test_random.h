@@ -0,0 +1,32 @@
+/*****************************************************************************
+ * test_random.h: pseudo-random numbers of the check programs
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ * A linear congruential generator, so that a check gives the same data on
+ * every run and platform from its seed.
+ *****************************************************************************/
+
+/*****************************************************************************
+ * test_random
+ *****************************************************************************/
+static uint32_t test_random(uint32_t *pi_seed)
+{
+  *pi_seed = *pi_seed * 1103515245 + 12345;
+  return *pi_seed >> 8;
+}
@@ -0,0 +1,191 @@
+/*****************************************************************************
+ * test_router.c: TS packet router check
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+#include "../src/dvbpsi.h"
+#include "../src/psi.h"
+#include "../src/router.h"
+#include "../src/tables/pat.h"
+
+#define TEST_ROUTER_HANDLES 3
+
+/*****************************************************************************
+ * test_router_t
+ *****************************************************************************/
+typedef struct test_router_s
+{
+  dvbpsi_router_t *p_router;
+  dvbpsi_t        *p_handles[TEST_ROUTER_HANDLES];
+  unsigned int    i_tables[TEST_ROUTER_HANDLES];
+  bool            b_remove;
+} test_router_t;
+
+static test_router_t test;
+
+/*****************************************************************************
+ * test_pat_callback
+ *****************************************************************************
+ * With test.b_remove, the first handle unregisters all the handles, itself
+ * included, and deletes the last one.
+ *****************************************************************************/
+static void test_pat_callback(void *p_cb_data, dvbpsi_pat_t *p_pat)
+{
+  int i_handle = (int)(intptr_t)p_cb_data;
+  int i;
+
+  test.i_tables[i_handle]++;
+  dvbpsi_pat_delete(p_pat);
+
+  if(i_handle != 0 || !test.b_remove)
+    return;
+
+  test.b_remove = false;
+  for(i = 0; i < TEST_ROUTER_HANDLES; i++)
+    dvbpsi_router_remove(test.p_router, 0, test.p_handles[i]);
+
+  dvbpsi_pat_detach(test.p_handles[TEST_ROUTER_HANDLES - 1]);
+  dvbpsi_delete(test.p_handles[TEST_ROUTER_HANDLES - 1]);
+  test.p_handles[TEST_ROUTER_HANDLES - 1] = NULL;
+}
+
+/*****************************************************************************
+ * test_packet_write
+ *****************************************************************************
+ * A PAT of the given version in one TS packet.
+ *****************************************************************************/
+static void test_packet_write(uint8_t *p_packet, dvbpsi_t *p_dvbpsi,
+                              uint8_t i_version, uint8_t i_cc)
+{
+  dvbpsi_psi_section_t *p_section;
+  dvbpsi_pat_t pat;
+
+  dvbpsi_pat_init(&pat, 1, i_version, true);
+  dvbpsi_pat_program_add(&pat, 1, 0x100);
+  p_section = dvbpsi_pat_sections_generate(p_dvbpsi, &pat, 8);
+
+  memset(p_packet, 0xff, 188);
+  p_packet[0] = 0x47;
+  p_packet[1] = 0x40;
+  p_packet[2] = 0x00;
+  p_packet[3] = 0x10 | i_cc;
+  p_packet[4] = 0x00;  /* pointer_field */
+  memcpy(&p_packet[5], p_section->p_data,
+         p_section->p_payload_end + 4 - p_section->p_data);
+
+  dvbpsi_DeletePSISections(p_section);
+  dvbpsi_pat_empty(&pat);
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************
+ * The handles of PID 0 are unregistered and one of them deleted from a table
+ * callback while the router walks them.
+ *****************************************************************************/
+int main(void)
+{
+  uint8_t p_packet[188];
+  int i, i_err = 0;
+
+  fprintf(stdout, "TS packet router check:\n");
+  test.p_router = dvbpsi_router_new();
+  if(test.p_router == NULL)
+  {
+    fprintf(stderr, "  router creation FAILED !!!\n");
+    return 1;
+  }
+
+  /* Routes are walked from the last one added */
+  for(i = TEST_ROUTER_HANDLES - 1; i >= 0; i--)
+  {
+    test.p_handles[i] = dvbpsi_new(NULL, DVBPSI_MSG_NONE);
+    if(test.p_handles[i] == NULL
+       || !dvbpsi_pat_attach(test.p_handles[i], test_pat_callback,
+                             (void *)(intptr_t)i)
+       || !dvbpsi_router_add(test.p_router, 0, test.p_handles[i]))
+    {
+      fprintf(stderr, "  handle creation FAILED !!!\n");
+      return 1;
+    }
+  }
+
+  test.b_remove = true;
+  test_packet_write(p_packet, test.p_handles[0], 0, 0);
+  dvbpsi_router_packet_push(test.p_router, p_packet);
+  if(test.i_tables[0] != 1 || test.i_tables[1] != 0 || test.i_tables[2] != 0)
+  {
+    fprintf(stderr, "  removal: %u %u %u tables FAILED !!!\n",
+            test.i_tables[0], test.i_tables[1], test.i_tables[2]);
+    i_err = 1;
+  }
+
+  test_packet_write(p_packet, test.p_handles[0], 1, 1);
+  if(dvbpsi_router_packet_push(test.p_router, p_packet))
+  {
+    fprintf(stderr, "  removed handles still routed FAILED !!!\n");
+    i_err = 1;
+  }
+
+  if(!dvbpsi_router_add(test.p_router, 0, test.p_handles[1]))
+  {
+    fprintf(stderr, "  handle registered again FAILED !!!\n");
+    i_err = 1;
+  }
+  test_packet_write(p_packet, test.p_handles[0], 2, 2);
+  dvbpsi_router_packet_push(test.p_router, p_packet);
+  if(test.i_tables[0] != 1 || test.i_tables[1] != 1)
+  {
+    fprintf(stderr, "  handle registered again: %u %u tables FAILED !!!\n",
+            test.i_tables[0], test.i_tables[1]);
+    i_err = 1;
+  }
+
+  dvbpsi_router_delete(test.p_router);
+  for(i = 0; i < TEST_ROUTER_HANDLES; i++)
+  {
+    if(test.p_handles[i] == NULL)
+      continue;
+    dvbpsi_pat_detach(test.p_handles[i]);
+    dvbpsi_delete(test.p_handles[i]);
+  }
+
+  if(i_err)
+    fprintf(stderr, "At least one test has FAILED !!!\n");
+  else
+    fprintf(stdout, "  handles removed from a table callback Ok.\n"
+            "All tests succeeded.\n");
+
+  return i_err;
+}
@@ -0,0 +1,210 @@
+/*****************************************************************************
+ * test_zero_copy.c: zero-copy sections check
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*****************************************************************************
+ * test_malloc
+ *****************************************************************************
+ * The section data allocations, which fail on demand.
+ *****************************************************************************/
+static unsigned int i_test_fail;        /* next allocations to fail */
+static unsigned int i_test_failed;
+
+static void *test_malloc(size_t i_size)
+{
+  if(i_test_fail)
+  {
+    i_test_fail--;
+    i_test_failed++;
+    return NULL;
+  }
+  return malloc(i_size);
+}
+
+/* The sections are allocated by static functions, build them in this
+ * program */
+#define malloc(i_size) test_malloc(i_size)
+#include "../src/psi.c"
+#undef malloc
+
+#include "../src/tables/pat.h"
+
+#define TEST_ZERO_COPY_PROGRAMS 8
+#define TEST_ZERO_COPY_PPS      4       /* programs per section */
+#define TEST_ZERO_COPY_PACKETS  (TEST_ZERO_COPY_PROGRAMS / TEST_ZERO_COPY_PPS)
+
+/*****************************************************************************
+ * test_pat_t
+ *****************************************************************************/
+typedef struct test_pat_s
+{
+  unsigned int  i_tables;
+  uint8_t       i_version;
+} test_pat_t;
+
+static void test_pat_callback(void *p_cb_data, dvbpsi_pat_t *p_pat)
+{
+  test_pat_t *p_test = (test_pat_t *)p_cb_data;
+  p_test->i_tables++;
+  p_test->i_version = p_pat->i_version;
+  dvbpsi_pat_delete(p_pat);
+}
+
+/*****************************************************************************
+ * test_packets_write
+ *****************************************************************************
+ * One TS packet per section, so that all the sections are views.
+ *****************************************************************************/
+static void test_packets_write(uint8_t p_packets[][188], dvbpsi_psi_section_t *p_section)
+{
+  unsigned int i = 0;
+
+  for(; p_section; p_section = p_section->p_next, i++)
+  {
+    size_t i_size = p_section->p_payload_end + 4 - p_section->p_data;
+
+    memset(p_packets[i], 0xff, 188);
+    p_packets[i][0] = 0x47;
+    p_packets[i][1] = 0x40;
+    p_packets[i][2] = 0x00;
+    p_packets[i][3] = 0x10;
+    p_packets[i][4] = 0x00;  /* pointer_field */
+    memcpy(&p_packets[i][5], p_section->p_data, i_size);
+  }
+}
+
+/*****************************************************************************
+ * test_packets_push
+ *****************************************************************************/
+static void test_packets_push(dvbpsi_t *p_dvbpsi, uint8_t p_packets[][188],
+                              uint8_t *pi_cc)
+{
+  unsigned int i;
+
+  for(i = 0; i < TEST_ZERO_COPY_PACKETS; i++)
+  {
+    p_packets[i][3] = 0x10 | *pi_cc;
+    *pi_cc = (*pi_cc + 1) & 0x0f;
+    dvbpsi_packet_push(p_dvbpsi, p_packets[i]);
+  }
+}
+
+/*****************************************************************************
+ * test_pool_drain
+ *****************************************************************************
+ * Free the pooled data buffers, so that the next ones are allocated.
+ *****************************************************************************/
+static void test_pool_drain(dvbpsi_section_pool_t *p_pool)
+{
+  int i;
+
+  for(i = 0; i < DVBPSI_SECTION_POOL_CLASSES; i++)
+  {
+    while(p_pool->i_data[i])
+    {
+      int8_t i_class;
+      free(dvbpsi_section_pool_data_get(p_pool, DVBPSI_SECTION_POOL_MIN << i,
+                                        &i_class));
+    }
+  }
+}
+
+/*****************************************************************************
+ * main
+ *****************************************************************************
+ * A PAT is received in zero-copy mode, then a new version of it whose first
+ * section cannot be copied out of its TS packet. The new version must be
+ * gathered again and signaled once the sections are repeated.
+ *****************************************************************************/
+int main(void)
+{
+  uint8_t p_packets[2][TEST_ZERO_COPY_PACKETS][188];
+  test_pat_t test = { 0, 0 };
+  dvbpsi_t *p_dvbpsi = dvbpsi_new(NULL, DVBPSI_MSG_NONE);
+  dvbpsi_pat_t pat;
+  uint8_t i_cc = 0;
+  int i, i_err = 0;
+
+  fprintf(stdout, "zero-copy sections check:\n");
+  if(p_dvbpsi == NULL || !dvbpsi_pat_attach(p_dvbpsi, test_pat_callback, &test))
+  {
+    fprintf(stderr, "  PAT decoder creation FAILED !!!\n");
+    return 1;
+  }
+  p_dvbpsi->b_zero_copy = true;
+
+  dvbpsi_pat_init(&pat, 1, 0, true);
+  for(i = 0; i < TEST_ZERO_COPY_PROGRAMS; i++)
+    dvbpsi_pat_program_add(&pat, i + 1, 0x100 + i);
+  for(i = 0; i < 2; i++)
+  {
+    dvbpsi_psi_section_t *p_sections;
+
+    pat.i_version = i;
+    p_sections = dvbpsi_pat_sections_generate(p_dvbpsi, &pat, TEST_ZERO_COPY_PPS);
+    test_packets_write(p_packets[i], p_sections);
+    dvbpsi_DeletePSISections(p_sections);
+  }
+  dvbpsi_pat_empty(&pat);
+
+  /* Version 0 */
+  test_packets_push(p_dvbpsi, p_packets[0], &i_cc);
+  if(test.i_tables != 1 || test.i_version != 0)
+  {
+    fprintf(stderr, "  version 0: %u tables FAILED !!!\n", test.i_tables);
+    i_err = 1;
+  }
+
+  /* Version 1, the first section is lost, then repeated */
+  test_pool_drain(p_dvbpsi->p_pool);
+  i_test_fail = 1;
+  test_packets_push(p_dvbpsi, p_packets[1], &i_cc);
+  test_packets_push(p_dvbpsi, p_packets[1], &i_cc);
+  test_packets_push(p_dvbpsi, p_packets[1], &i_cc);
+  if(i_test_failed != 1)
+  {
+    fprintf(stderr, "  version 1: %u failed copies FAILED !!!\n", i_test_failed);
+    i_err = 1;
+  }
+  else if(test.i_tables != 2 || test.i_version != 1)
+  {
+    fprintf(stderr, "  version 1: %u tables, version %u FAILED !!!\n",
+            test.i_tables, test.i_version);
+    i_err = 1;
+  }
+
+  dvbpsi_pat_detach(p_dvbpsi);
+  dvbpsi_delete(p_dvbpsi);
+
+  if(i_err)
+    fprintf(stderr, "At least one test has FAILED !!!\n");
+  else
+    fprintf(stdout, "  lost section gathered again Ok.\n"
+            "All tests succeeded.\n");
+
+  return i_err;
+}
@@ -0,0 +1,307 @@
+/*****************************************************************************
+ * arena.c: memory of decoded tables
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+#include <assert.h>
+
+#include "dvbpsi.h"
+#include "dvbpsi_private.h"
+#include "psi.h"
+#include "descriptor.h"
+
+/*****************************************************************************
+ * dvbpsi_arena_s
+ *****************************************************************************
+ * Chunks of memory given out from their start, each chunk twice as large as
+ * the previous one up to DVBPSI_ARENA_CHUNK_MAX. The arena itself lives in
+ * its first chunk. Section buffers taken over by the arena are listed apart.
+ *****************************************************************************/
+typedef union
+{
+    void       *p;
+    uint64_t    i;
+    double      d;
+} dvbpsi_arena_align_t;
+
+#define DVBPSI_ARENA_ALIGN(x) \
+    (((x) + sizeof(dvbpsi_arena_align_t) - 1) & ~(sizeof(dvbpsi_arena_align_t) - 1))
+
+#define DVBPSI_ARENA_CHUNK_MIN 2048
+#define DVBPSI_ARENA_CHUNK_MAX 65536
+
+typedef struct dvbpsi_arena_chunk_s
+{
+    struct dvbpsi_arena_chunk_s *p_next;    /* previous chunk */
+    size_t                       i_size;    /* including this header */
+} dvbpsi_arena_chunk_t;
+
+typedef struct dvbpsi_arena_buffer_s
+{
+    struct dvbpsi_arena_buffer_s *p_next;
+    uint8_t                      *p_data;   /* allocated by the section */
+} dvbpsi_arena_buffer_t;
+
+struct dvbpsi_arena_s
+{
+    dvbpsi_arena_chunk_t   *p_chunks;       /* last allocated first */
+    uint8_t                *p_free;         /* free bytes of p_chunks */
+    uint8_t                *p_end;
+
+    bool                    b_keep_sections;
+    dvbpsi_arena_buffer_t  *p_buffers;      /* section buffers taken over */
+    const uint8_t          *p_section_start;/* payload of the last section */
+    const uint8_t          *p_section_end;  /* kept, NULL if none */
+};
+
+#define DVBPSI_ARENA_CHUNK_HEADER DVBPSI_ARENA_ALIGN(sizeof(dvbpsi_arena_chunk_t))
+
+/*****************************************************************************
+ * dvbpsi_arena_new
+ *****************************************************************************/
+dvbpsi_arena_t *dvbpsi_arena_new(const bool b_keep_sections)
+{
+    dvbpsi_arena_chunk_t *p_chunk = malloc(DVBPSI_ARENA_CHUNK_MIN);
+    if (p_chunk == NULL)
+        return NULL;
+    p_chunk->p_next = NULL;
+    p_chunk->i_size = DVBPSI_ARENA_CHUNK_MIN;
+
+    dvbpsi_arena_t *p_arena = (dvbpsi_arena_t *)((uint8_t *)p_chunk
+                                                 + DVBPSI_ARENA_CHUNK_HEADER);
+    p_arena->p_chunks = p_chunk;
+    p_arena->p_free = (uint8_t *)p_arena + DVBPSI_ARENA_ALIGN(sizeof(dvbpsi_arena_t));
+    p_arena->p_end = (uint8_t *)p_chunk + DVBPSI_ARENA_CHUNK_MIN;
+    p_arena->b_keep_sections = b_keep_sections;
+    p_arena->p_buffers = NULL;
+    p_arena->p_section_start = p_arena->p_section_end = NULL;
+    return p_arena;
+}
+
+/*****************************************************************************
+ * dvbpsi_arena_delete
+ *****************************************************************************/
+void dvbpsi_arena_delete(dvbpsi_arena_t *p_arena)
+{
+    if (p_arena == NULL)
+        return;
+
+    /* The list lives in the chunks */
+    for (dvbpsi_arena_buffer_t *p_buffer = p_arena->p_buffers; p_buffer;
+         p_buffer = p_buffer->p_next)
+        free(p_buffer->p_data);
+
+    /* The first chunk, holding the arena, is the last of the list */
+    dvbpsi_arena_chunk_t *p_chunk = p_arena->p_chunks;
+    while (p_chunk)
+    {
+        dvbpsi_arena_chunk_t *p_next = p_chunk->p_next;
+        free(p_chunk);
+        p_chunk = p_next;
+    }
+}
+
+/*****************************************************************************
+ * dvbpsi_arena_alloc
+ *****************************************************************************/
+void *dvbpsi_arena_alloc(dvbpsi_arena_t *p_arena, size_t i_size)
+{
+    if (p_arena == NULL)
+        return calloc(1, i_size);
+
+    i_size = DVBPSI_ARENA_ALIGN(i_size);
+    if (i_size > (size_t)(p_arena->p_end - p_arena->p_free))
+    {
+        size_t i_chunk = 2 * p_arena->p_chunks->i_size;
+        if (i_chunk > DVBPSI_ARENA_CHUNK_MAX)
+            i_chunk = DVBPSI_ARENA_CHUNK_MAX;
+        if (i_chunk < DVBPSI_ARENA_CHUNK_HEADER + i_size)
+            i_chunk = DVBPSI_ARENA_CHUNK_HEADER + i_size;
+
+        dvbpsi_arena_chunk_t *p_chunk = malloc(i_chunk);
+        if (p_chunk == NULL)
+            return NULL;
+        p_chunk->p_next = p_arena->p_chunks;
+        p_chunk->i_size = i_chunk;
+        p_arena->p_chunks = p_chunk;
+        p_arena->p_free = (uint8_t *)p_chunk + DVBPSI_ARENA_CHUNK_HEADER;
+        p_arena->p_end = (uint8_t *)p_chunk + i_chunk;
+    }
+
+    void *p_object = p_arena->p_free;
+    p_arena->p_free += i_size;
+    memset(p_object, 0, i_size);
+    return p_object;
+}
+
+/*****************************************************************************
+ * dvbpsi_arena_free
+ *****************************************************************************/
+void dvbpsi_arena_free(dvbpsi_arena_t *p_arena, void *p_object)
+{
+    if (p_arena == NULL)
+        free(p_object);
+}
+
+/*****************************************************************************
+ * dvbpsi_arena_section_keep
+ *****************************************************************************/
+void dvbpsi_arena_section_keep(dvbpsi_arena_t *p_arena, dvbpsi_psi_section_t *p_section)
+{
+    assert(p_section);
+
+    if (p_arena == NULL || !p_arena->b_keep_sections)
+        return;
+
+    p_arena->p_section_start = p_arena->p_section_end = NULL;
+    if (p_section->p_payload_start == NULL)
+        return;
+
+    if (p_section->b_data_view)
+    {
+        /* The data belongs to a TS packet or to another table, copy it */
+        const size_t i_size = p_section->p_payload_end - p_section->p_data;
+        uint8_t *p_data = dvbpsi_arena_alloc(p_arena, i_size);
+        if (p_data == NULL)
+            return;
+        memcpy(p_data, p_section->p_data, i_size);
+        p_section->p_payload_start = p_data
+                    + (p_section->p_payload_start - p_section->p_data);
+        p_section->p_payload_end = p_data + i_size;
+        p_section->p_data = p_data;
+    }
+    else
+    {
+        /* Take the buffer over, pooled buffers are allocated with malloc() too */
+        dvbpsi_arena_buffer_t *p_buffer = dvbpsi_arena_alloc(p_arena,
+                                                             sizeof(dvbpsi_arena_buffer_t));
+        if (p_buffer == NULL)
+            return;
+        p_buffer->p_data = p_section->p_data;
+        p_buffer->p_next = p_arena->p_buffers;
+        p_arena->p_buffers = p_buffer;
+        p_section->b_data_view = true;
+    }
+
+    p_arena->p_section_start = p_section->p_payload_start;
+    p_arena->p_section_end = p_section->p_payload_end;
+}
+
+/*****************************************************************************
+ * dvbpsi_arena_descriptor_new
+ *****************************************************************************/
+dvbpsi_descriptor_t *dvbpsi_arena_descriptor_new(dvbpsi_arena_t *p_arena,
+                                                 uint8_t i_tag, uint8_t i_length,
+                                                 uint8_t *p_data)
+{
+    if (p_arena == NULL)
+        return dvbpsi_NewDescriptor(i_tag, i_length, p_data);
+
+    /* Point into the section the descriptor comes from */
+    if (p_data && p_data >= p_arena->p_section_start
+     && p_data + i_length <= p_arena->p_section_end)
+    {
+        dvbpsi_descriptor_t *p_descriptor = dvbpsi_arena_alloc(p_arena,
+                                                sizeof(dvbpsi_descriptor_t));
+        if (p_descriptor == NULL)
+            return NULL;
+
+        p_descriptor->i_tag = i_tag;
+        p_descriptor->i_length = i_length;
+        p_descriptor->b_arena = true;
+        p_descriptor->p_data = p_data;
+        return p_descriptor;
+    }
+
+    /* The data follows the descriptor */
+    dvbpsi_descriptor_t *p_descriptor = dvbpsi_arena_alloc(p_arena,
+                                            sizeof(dvbpsi_descriptor_t) + i_length);
+    if (p_descriptor == NULL)
+        return NULL;
+
+    p_descriptor->i_tag = i_tag;
+    p_descriptor->i_length = i_length;
+    p_descriptor->b_arena = true;
+    p_descriptor->p_data = (uint8_t *)(p_descriptor + 1);
+    if (p_data)
+        memcpy(p_descriptor->p_data, p_data, i_length);
+    return p_descriptor;
+}
+
+/*****************************************************************************
+ * dvbpsi_arena_descriptor_add
+ *****************************************************************************/
+dvbpsi_descriptor_t *dvbpsi_arena_descriptor_add(dvbpsi_arena_t *p_arena,
+                                                 dvbpsi_descriptor_t **pp_first,
+                                                 dvbpsi_descriptor_t **pp_last,
+                                                 uint8_t i_tag, uint8_t i_length,
+                                                 uint8_t *p_data)
+{
+    dvbpsi_descriptor_t *p_descriptor = dvbpsi_arena_descriptor_new(p_arena, i_tag,
+                                                                    i_length, p_data);
+    if (p_descriptor == NULL)
+        return NULL;
+
+    dvbpsi_descriptor_append(pp_first, pp_last, p_descriptor);
+    return p_descriptor;
+}
+
+/*****************************************************************************
+ * dvbpsi_arena_descriptors_delete
+ *****************************************************************************/
+void dvbpsi_arena_descriptors_delete(dvbpsi_arena_t *p_arena,
+                                     dvbpsi_descriptor_t *p_descriptor)
+{
+    if (p_arena == NULL)
+    {
+        dvbpsi_DeleteDescriptors(p_descriptor);
+        return;
+    }
+
+    while (p_descriptor != NULL)
+    {
+        dvbpsi_descriptor_t *p_next = p_descriptor->p_next;
+
+        /* Decoded by the application after the table was built */
+        free(p_descriptor->p_decoded);
+
+        /* Added by the application with dvbpsi_NewDescriptor() */
+        if (!p_descriptor->b_arena)
+        {
+            free(p_descriptor->p_data);
+            free(p_descriptor);
+        }
+        p_descriptor = p_next;
+    }
+}
@@ -0,0 +1,157 @@
+/*****************************************************************************
+ * cache.c: cache of received sections
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+#include <assert.h>
+
+#include "dvbpsi.h"
+#include "dvbpsi_private.h"
+#include "psi.h"
+
+/*****************************************************************************
+ * dvbpsi_section_cache_s
+ *****************************************************************************
+ * Direct mapped table of section fingerprints. An entry is keyed by
+ * table_id << 24 | table_id_extension << 8 | section_number, colliding
+ * sections replace each other.
+ *****************************************************************************/
+typedef struct dvbpsi_section_cache_entry_s
+{
+    uint32_t    i_key;
+    uint32_t    i_crc;          /* CRC_32 field of the section */
+    uint16_t    i_length;       /* section_length, 0 when unused */
+} dvbpsi_section_cache_entry_t;
+
+struct dvbpsi_section_cache_s
+{
+    unsigned int                    i_mask;     /* entries - 1 */
+
+    dvbpsi_section_cache_entry_t    p_entries[];
+};
+
+/*****************************************************************************
+ * dvbpsi_section_cache_enable
+ *****************************************************************************/
+bool dvbpsi_section_cache_enable(dvbpsi_t *p_dvbpsi, const unsigned int i_entries)
+{
+    assert(p_dvbpsi);
+
+    free(p_dvbpsi->p_section_cache);
+    p_dvbpsi->p_section_cache = NULL;
+
+    if (i_entries == 0)
+        return true;
+
+    /* The hash gives 20 bits */
+    unsigned int i_size = 1;
+    while (i_size < i_entries && i_size < (1u << 20))
+        i_size <<= 1;
+
+    dvbpsi_section_cache_t *p_cache = calloc(1, sizeof(dvbpsi_section_cache_t)
+                            + i_size * sizeof(dvbpsi_section_cache_entry_t));
+    if (p_cache == NULL)
+        return false;
+
+    p_cache->i_mask = i_size - 1;
+    p_dvbpsi->p_section_cache = p_cache;
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_section_cache_flush
+ *****************************************************************************/
+void dvbpsi_section_cache_flush(dvbpsi_t *p_dvbpsi)
+{
+    assert(p_dvbpsi);
+
+    dvbpsi_section_cache_t *p_cache = p_dvbpsi->p_section_cache;
+    if (p_cache)
+        memset(p_cache->p_entries, 0,
+               (p_cache->i_mask + 1) * sizeof(dvbpsi_section_cache_entry_t));
+}
+
+/*****************************************************************************
+ * dvbpsi_section_cache_entry
+ *****************************************************************************
+ * Entry of a complete section with syntax indicator.
+ *****************************************************************************/
+static inline dvbpsi_section_cache_entry_t *
+    dvbpsi_section_cache_entry(dvbpsi_section_cache_t *p_cache,
+                               const dvbpsi_psi_section_t *p_section,
+                               uint32_t *pi_key, uint32_t *pi_crc)
+{
+    const uint8_t *p_data = p_section->p_data;
+    const uint8_t *p_crc = p_data + 3 + p_section->i_length - 4;
+
+    *pi_key = ((uint32_t)p_data[0] << 24) | ((uint32_t)p_data[3] << 16)
+            | ((uint32_t)p_data[4] << 8) | p_data[6];
+    *pi_crc = ((uint32_t)p_crc[0] << 24) | ((uint32_t)p_crc[1] << 16)
+            | ((uint32_t)p_crc[2] << 8) | p_crc[3];
+
+    /* Fibonacci hashing, the upper bits are the best mixed */
+    uint32_t i_hash = (*pi_key * 2654435761u) >> 12;
+    return &p_cache->p_entries[i_hash & p_cache->i_mask];
+}
+
+/*****************************************************************************
+ * dvbpsi_section_cache_lookup
+ *****************************************************************************/
+bool dvbpsi_section_cache_lookup(dvbpsi_section_cache_t *p_cache,
+                                 const dvbpsi_psi_section_t *p_section)
+{
+    uint32_t i_key, i_crc;
+    dvbpsi_section_cache_entry_t *p_entry =
+        dvbpsi_section_cache_entry(p_cache, p_section, &i_key, &i_crc);
+
+    if (p_entry->i_length == p_section->i_length
+     && p_entry->i_key == i_key && p_entry->i_crc == i_crc)
+        return true;
+    return false;
+}
+
+/*****************************************************************************
+ * dvbpsi_section_cache_add
+ *****************************************************************************/
+void dvbpsi_section_cache_add(dvbpsi_section_cache_t *p_cache,
+                              const dvbpsi_psi_section_t *p_section)
+{
+    uint32_t i_key, i_crc;
+    dvbpsi_section_cache_entry_t *p_entry =
+        dvbpsi_section_cache_entry(p_cache, p_section, &i_key, &i_crc);
+
+    p_entry->i_key = i_key;
+    p_entry->i_crc = i_crc;
+    p_entry->i_length = p_section->i_length;
+}
@@ -0,0 +1,322 @@
+/*****************************************************************************
+ * delta.c: changes between two versions of a table
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+#include <assert.h>
+
+#include "dvbpsi.h"
+#include "dvbpsi_private.h"
+#include "descriptor.h"
+#include "delta.h"
+
+/*****************************************************************************
+ * dvbpsi_delta_state_s
+ *****************************************************************************
+ * Fingerprints of the elements of the previous table, sorted by kind and
+ * key, and of the table being compared. Several records with the same kind
+ * and key are folded into one, in the order they were added.
+ *****************************************************************************/
+typedef struct dvbpsi_delta_record_s
+{
+    uint64_t            i_hash;
+    uint32_t            i_key;
+    uint32_t            i_order;    /* kind << 30 | rank of the record */
+    const void         *p_element;  /* only valid in the new table */
+} dvbpsi_delta_record_t;
+
+struct dvbpsi_delta_state_s
+{
+    dvbpsi_delta_record_t  *p_previous;
+    unsigned int            i_previous;
+    unsigned int            i_previous_size;
+
+    dvbpsi_delta_record_t  *p_new;
+    unsigned int            i_new;
+    unsigned int            i_new_size;
+
+    dvbpsi_delta_t         *p_deltas;
+    unsigned int            i_deltas_size;
+
+    bool                    b_error;    /* a record could not be added */
+};
+
+#define DVBPSI_DELTA_KIND(p) ((p)->i_order >> 30)
+
+/*****************************************************************************
+ * dvbpsi_delta_state_new
+ *****************************************************************************/
+dvbpsi_delta_state_t *dvbpsi_delta_state_new(void)
+{
+    return calloc(1, sizeof(dvbpsi_delta_state_t));
+}
+
+/*****************************************************************************
+ * dvbpsi_delta_state_delete
+ *****************************************************************************/
+void dvbpsi_delta_state_delete(dvbpsi_delta_state_t *p_state)
+{
+    if (p_state == NULL)
+        return;
+    free(p_state->p_previous);
+    free(p_state->p_new);
+    free(p_state->p_deltas);
+    free(p_state);
+}
+
+/*****************************************************************************
+ * dvbpsi_delta_hash
+ *****************************************************************************
+ * FNV-1a.
+ *****************************************************************************/
+uint64_t dvbpsi_delta_hash(uint64_t i_hash, const uint8_t *p_data, size_t i_size)
+{
+    while (i_size--)
+    {
+        i_hash ^= *p_data++;
+        i_hash *= UINT64_C(0x100000001b3);
+    }
+    return i_hash;
+}
+
+/*****************************************************************************
+ * dvbpsi_delta_hash_descriptors
+ *****************************************************************************/
+uint64_t dvbpsi_delta_hash_descriptors(uint64_t i_hash,
+                                       const dvbpsi_descriptor_t *p_descriptor)
+{
+    for (; p_descriptor; p_descriptor = p_descriptor->p_next)
+    {
+        const uint8_t p_header[2] = { p_descriptor->i_tag, p_descriptor->i_length };
+        i_hash = dvbpsi_delta_hash(i_hash, p_header, 2);
+        i_hash = dvbpsi_delta_hash(i_hash, p_descriptor->p_data, p_descriptor->i_length);
+    }
+    return i_hash;
+}
+
+/*****************************************************************************
+ * dvbpsi_delta_record_add
+ *****************************************************************************/
+static void dvbpsi_delta_record_add(dvbpsi_delta_state_t *p_state,
+                                    const dvbpsi_delta_kind_t i_kind,
+                                    const uint32_t i_key, const uint64_t i_hash,
+                                    const void *p_element)
+{
+    if (p_state->i_new == p_state->i_new_size)
+    {
+        const unsigned int i_size = p_state->i_new_size ? 2 * p_state->i_new_size : 16;
+        dvbpsi_delta_record_t *p_new = realloc(p_state->p_new,
+                                               i_size * sizeof(dvbpsi_delta_record_t));
+        if (p_new == NULL)
+        {
+            p_state->b_error = true;
+            return;
+        }
+        p_state->p_new = p_new;
+        p_state->i_new_size = i_size;
+    }
+
+    dvbpsi_delta_record_t *p_record = &p_state->p_new[p_state->i_new];
+    p_record->i_hash = i_hash;
+    p_record->i_key = i_key;
+    p_record->i_order = ((uint32_t)i_kind << 30) | p_state->i_new;
+    p_record->p_element = p_element;
+    p_state->i_new++;
+}
+
+/*****************************************************************************
+ * dvbpsi_delta_element_add
+ *****************************************************************************/
+void dvbpsi_delta_element_add(dvbpsi_delta_state_t *p_state, const uint32_t i_key,
+                              const uint64_t i_hash, const void *p_element)
+{
+    assert(p_state);
+    dvbpsi_delta_record_add(p_state, DVBPSI_DELTA_ELEMENT, i_key, i_hash, p_element);
+}
+
+/*****************************************************************************
+ * dvbpsi_delta_table_add
+ *****************************************************************************/
+void dvbpsi_delta_table_add(dvbpsi_delta_state_t *p_state, const uint64_t i_hash,
+                            const void *p_table)
+{
+    assert(p_state);
+    dvbpsi_delta_record_add(p_state, DVBPSI_DELTA_TABLE, 0, i_hash, p_table);
+}
+
+/*****************************************************************************
+ * dvbpsi_delta_descriptors_add
+ *****************************************************************************/
+void dvbpsi_delta_descriptors_add(dvbpsi_delta_state_t *p_state,
+                                  const dvbpsi_descriptor_t *p_descriptor)
+{
+    assert(p_state);
+
+    for (; p_descriptor; p_descriptor = p_descriptor->p_next)
+    {
+        const uint8_t i_length = p_descriptor->i_length;
+        uint64_t i_hash = dvbpsi_delta_hash(DVBPSI_DELTA_HASH_INIT, &i_length, 1);
+        i_hash = dvbpsi_delta_hash(i_hash, p_descriptor->p_data, i_length);
+        dvbpsi_delta_record_add(p_state, DVBPSI_DELTA_DESCRIPTOR, p_descriptor->i_tag,
+                                i_hash, p_descriptor);
+    }
+}
+
+static int dvbpsi_delta_record_compare(const void *p_a, const void *p_b)
+{
+    const dvbpsi_delta_record_t *a = p_a, *b = p_b;
+
+    if (DVBPSI_DELTA_KIND(a) != DVBPSI_DELTA_KIND(b))
+        return DVBPSI_DELTA_KIND(a) < DVBPSI_DELTA_KIND(b) ? -1 : 1;
+    if (a->i_key != b->i_key)
+        return a->i_key < b->i_key ? -1 : 1;
+    return a->i_order < b->i_order ? -1 : (a->i_order > b->i_order);
+}
+
+/*****************************************************************************
+ * dvbpsi_delta_add
+ *****************************************************************************/
+static bool dvbpsi_delta_add(dvbpsi_delta_state_t *p_state, unsigned int *pi_deltas,
+                             const dvbpsi_delta_record_t *p_record,
+                             const dvbpsi_delta_change_t i_change)
+{
+    if (*pi_deltas == p_state->i_deltas_size)
+    {
+        const unsigned int i_size = p_state->i_deltas_size ? 2 * p_state->i_deltas_size : 16;
+        dvbpsi_delta_t *p_deltas = realloc(p_state->p_deltas, i_size * sizeof(dvbpsi_delta_t));
+        if (p_deltas == NULL)
+            return false;
+        p_state->p_deltas = p_deltas;
+        p_state->i_deltas_size = i_size;
+    }
+
+    dvbpsi_delta_t *p_delta = &p_state->p_deltas[(*pi_deltas)++];
+    p_delta->i_kind = DVBPSI_DELTA_KIND(p_record);
+    p_delta->i_change = i_change;
+    p_delta->i_key = p_record->i_key;
+    p_delta->p_element = (i_change == DVBPSI_DELTA_REMOVED) ? NULL : p_record->p_element;
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_delta_compute
+ *****************************************************************************/
+bool dvbpsi_delta_compute(dvbpsi_delta_state_t *p_state,
+                          const dvbpsi_delta_t **pp_deltas, unsigned int *pi_deltas)
+{
+    assert(p_state);
+    assert(pp_deltas);
+    assert(pi_deltas);
+
+    if (p_state->b_error)
+    {
+        /* Keep comparing with the previous table */
+        p_state->i_new = 0;
+        p_state->b_error = false;
+        return false;
+    }
+
+    /* Sort the new table and fold the records with the same key */
+    dvbpsi_delta_record_t *p_new = p_state->p_new;
+    unsigned int i_new = 0;
+    if (p_state->i_new)
+    {
+        qsort(p_new, p_state->i_new, sizeof(dvbpsi_delta_record_t),
+              dvbpsi_delta_record_compare);
+        for (unsigned int i = 1; i < p_state->i_new; i++)
+        {
+            if (DVBPSI_DELTA_KIND(&p_new[i]) == DVBPSI_DELTA_KIND(&p_new[i_new])
+             && p_new[i].i_key == p_new[i_new].i_key)
+            {
+                const uint8_t *p_hash = (const uint8_t *)&p_new[i].i_hash;
+                p_new[i_new].i_hash = dvbpsi_delta_hash(p_new[i_new].i_hash, p_hash,
+                                                        sizeof(p_new[i].i_hash));
+            }
+            else
+                p_new[++i_new] = p_new[i];
+        }
+        i_new++;
+    }
+
+    /* Merge with the previous table */
+    const dvbpsi_delta_record_t *p_previous = p_state->p_previous;
+    const unsigned int i_previous = p_state->i_previous;
+    unsigned int i = 0, j = 0, i_deltas = 0;
+    bool b_ok = true;
+    while (b_ok && (i < i_previous || j < i_new))
+    {
+        int i_cmp;
+        if (i == i_previous)
+            i_cmp = 1;
+        else if (j == i_new)
+            i_cmp = -1;
+        else if (DVBPSI_DELTA_KIND(&p_previous[i]) != DVBPSI_DELTA_KIND(&p_new[j]))
+            i_cmp = DVBPSI_DELTA_KIND(&p_previous[i]) < DVBPSI_DELTA_KIND(&p_new[j]) ? -1 : 1;
+        else if (p_previous[i].i_key != p_new[j].i_key)
+            i_cmp = p_previous[i].i_key < p_new[j].i_key ? -1 : 1;
+        else
+            i_cmp = 0;
+
+        if (i_cmp < 0)
+            b_ok = dvbpsi_delta_add(p_state, &i_deltas, &p_previous[i++], DVBPSI_DELTA_REMOVED);
+        else if (i_cmp > 0)
+            b_ok = dvbpsi_delta_add(p_state, &i_deltas, &p_new[j++], DVBPSI_DELTA_ADDED);
+        else
+        {
+            if (p_previous[i].i_hash != p_new[j].i_hash)
+                b_ok = dvbpsi_delta_add(p_state, &i_deltas, &p_new[j], DVBPSI_DELTA_MODIFIED);
+            i++;
+            j++;
+        }
+    }
+
+    if (!b_ok)
+    {
+        p_state->i_new = 0;
+        return false;
+    }
+
+    /* The new table becomes the previous one */
+    const unsigned int i_new_size = p_state->i_new_size;
+    p_state->p_new = p_state->p_previous;
+    p_state->i_new_size = p_state->i_previous_size;
+    p_state->i_new = 0;
+    p_state->p_previous = p_new;
+    p_state->i_previous_size = i_new_size;
+    p_state->i_previous = i_new;
+
+    *pp_deltas = p_state->p_deltas;
+    *pi_deltas = i_deltas;
+    return true;
+}
@@ -0,0 +1,125 @@
+/*****************************************************************************
+ * delta.h
+ *
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *****************************************************************************/
+
+/*!
+ * \file <delta.h>
+ * \brief Changes between two versions of a table.
+ *
+ * The PMT, SDT, NIT and BAT decoders can report what changed in a new
+ * table compared to the previous one they decoded: the elementary streams,
+ * services or transport streams which were added, removed or modified, and
+ * the descriptors of the table level loop, by tag, and the fields of the
+ * table itself. Elements are compared by their contents, including their
+ * descriptor loops, and identified by a key.
+ */
+
+#ifndef _DVBPSI_DELTA_H_
+#define _DVBPSI_DELTA_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************
+ * dvbpsi_delta_kind_t
+ *****************************************************************************/
+/*!
+ * \enum dvbpsi_delta_kind
+ * \brief What a change is about.
+ */
+enum dvbpsi_delta_kind
+{
+    DVBPSI_DELTA_ELEMENT = 0,   /*!< an element of the table: ES of a PMT
+                                     (key: elementary_PID), service of a SDT
+                                     (key: service_id), transport stream of
+                                     a NIT or BAT (key: transport_stream_id
+                                     << 16 | original_network_id) */
+    DVBPSI_DELTA_DESCRIPTOR,    /*!< the descriptors with one tag of the
+                                     table level loop: program_info of a
+                                     PMT, network descriptors of a NIT,
+                                     bouquet descriptors of a BAT (key:
+                                     descriptor_tag) */
+    DVBPSI_DELTA_TABLE,         /*!< the fields of the table which are not
+                                     part of its subtable id: PCR_PID of a
+                                     PMT, original_network_id of a SDT
+                                     (key: 0) */
+};
+
+/*!
+ * \typedef enum dvbpsi_delta_kind dvbpsi_delta_kind_t
+ * \brief dvbpsi_delta_kind_t type definition.
+ */
+typedef enum dvbpsi_delta_kind dvbpsi_delta_kind_t;
+
+/*****************************************************************************
+ * dvbpsi_delta_change_t
+ *****************************************************************************/
+/*!
+ * \enum dvbpsi_delta_change
+ * \brief How an element changed.
+ */
+enum dvbpsi_delta_change
+{
+    DVBPSI_DELTA_ADDED = 0,     /*!< not in the previous table */
+    DVBPSI_DELTA_REMOVED,       /*!< not in the new table */
+    DVBPSI_DELTA_MODIFIED,      /*!< in both tables with different contents */
+};
+
+/*!
+ * \typedef enum dvbpsi_delta_change dvbpsi_delta_change_t
+ * \brief dvbpsi_delta_change_t type definition.
+ */
+typedef enum dvbpsi_delta_change dvbpsi_delta_change_t;
+
+/*****************************************************************************
+ * dvbpsi_delta_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_delta_s
+ * \brief One change between two versions of a table.
+ *
+ * p_element points into the new table: it is the dvbpsi_pmt_es_t,
+ * dvbpsi_sdt_service_t, dvbpsi_nit_ts_t or dvbpsi_bat_ts_t of an element,
+ * the first dvbpsi_descriptor_t with the tag of a descriptor change, or the
+ * new dvbpsi_pmt_t or dvbpsi_sdt_t of a table change. It is NULL for a
+ * removed element. The changes are sorted by kind, then by key.
+ */
+/*!
+ * \typedef struct dvbpsi_delta_s dvbpsi_delta_t
+ * \brief dvbpsi_delta_t type definition.
+ */
+typedef struct dvbpsi_delta_s
+{
+    dvbpsi_delta_kind_t     i_kind;     /*!< element, descriptors or table */
+    dvbpsi_delta_change_t   i_change;   /*!< added, removed or modified */
+    uint32_t                i_key;      /*!< identifier of the element, see
+                                             dvbpsi_delta_kind */
+    const void             *p_element;  /*!< element in the new table */
+} dvbpsi_delta_t;
+
+#ifdef __cplusplus
+};
+#endif
+
+#else
+#error "Multiple inclusions of delta.h"
+#endif
@@ -44,6 +44,182 @@
 #include "psi.h"
 #include "demux.h"
 
+static void dvbpsi_demux_sections_gather(dvbpsi_t *p_dvbpsi,
+                                         dvbpsi_psi_section_t *p_section);
+
+/* Initial number of slots of the subtable decoder index, a power of two */
+#define DVBPSI_DEMUX_INDEX_SIZE 16
+
+/*****************************************************************************
+ * dvbpsi_demux_ignored_t
+ *****************************************************************************
+ * Entry of the set of ignored subtables, free when i_id is 0. Subtable ids
+ * fit in 24 bits, the used entries have DVBPSI_DEMUX_IGNORED_USED set.
+ *****************************************************************************/
+#define DVBPSI_DEMUX_IGNORED_USED 0x80000000u
+
+typedef struct dvbpsi_demux_ignored_s
+{
+    uint32_t    i_id;
+    int64_t     i_expiry;   /* dvbpsi_clock() time, 0 for ever */
+} dvbpsi_demux_ignored_t;
+
+/*****************************************************************************
+ * dvbpsi_demux_hash
+ *****************************************************************************
+ * First slot to probe for subtable i_id in a table of i_mask + 1 slots.
+ *****************************************************************************/
+static inline unsigned int dvbpsi_demux_hash(const uint32_t i_id, const unsigned int i_mask)
+{
+    return ((i_id * 2654435761u) >> 8) & i_mask;
+}
+
+/*****************************************************************************
+ * dvbpsi_demux_index_slot
+ *****************************************************************************
+ * First slot to probe for subtable i_id.
+ *****************************************************************************/
+static inline unsigned int dvbpsi_demux_index_slot(const dvbpsi_demux_t *p_demux,
+                                                   const uint32_t i_id)
+{
+    return dvbpsi_demux_hash(i_id, p_demux->i_index_mask);
+}
+
+/*****************************************************************************
+ * dvbpsi_demux_index_insert
+ *****************************************************************************
+ * Linear probing, the index is kept at most half full.
+ *****************************************************************************/
+static void dvbpsi_demux_index_insert(dvbpsi_demux_t *p_demux,
+                                      dvbpsi_demux_subdec_t *p_subdec)
+{
+    unsigned int i = dvbpsi_demux_index_slot(p_demux, p_subdec->i_id);
+    while (p_demux->pp_index[i])
+        i = (i + 1) & p_demux->i_index_mask;
+    p_demux->pp_index[i] = p_subdec;
+    p_demux->i_index_count++;
+}
+
+/*****************************************************************************
+ * dvbpsi_demux_index_build
+ *****************************************************************************
+ * (Re)build the index with i_size slots from the list of subtable decoders.
+ * On allocation failure the index is dropped and the lookups walk the list.
+ *****************************************************************************/
+static void dvbpsi_demux_index_build(dvbpsi_demux_t *p_demux, const unsigned int i_size)
+{
+    free(p_demux->pp_index);
+    p_demux->pp_index = calloc(i_size, sizeof(dvbpsi_demux_subdec_t *));
+    p_demux->i_index_mask = i_size - 1;
+    p_demux->i_index_count = 0;
+    if (p_demux->pp_index == NULL)
+        return;
+
+    for (dvbpsi_demux_subdec_t *p = p_demux->p_first_subdec; p; p = p->p_next)
+        dvbpsi_demux_index_insert(p_demux, p);
+}
+
+/*****************************************************************************
+ * dvbpsi_demux_index_remove
+ *****************************************************************************
+ * Remove a subtable decoder and move back the following entries of its
+ * probe sequence, so that no tombstone is needed.
+ *****************************************************************************/
+static void dvbpsi_demux_index_remove(dvbpsi_demux_t *p_demux,
+                                      dvbpsi_demux_subdec_t *p_subdec)
+{
+    const unsigned int i_mask = p_demux->i_index_mask;
+    unsigned int i = dvbpsi_demux_index_slot(p_demux, p_subdec->i_id);
+
+    while (p_demux->pp_index[i] != p_subdec)
+    {
+        assert(p_demux->pp_index[i]);
+        i = (i + 1) & i_mask;
+    }
+    p_demux->pp_index[i] = NULL;
+    p_demux->i_index_count--;
+
+    for (unsigned int j = (i + 1) & i_mask; p_demux->pp_index[j]; j = (j + 1) & i_mask)
+    {
+        /* An entry may fill the hole if its home slot is not in (i, j] */
+        unsigned int k = dvbpsi_demux_index_slot(p_demux, p_demux->pp_index[j]->i_id);
+        if (((j - k) & i_mask) >= ((j - i) & i_mask))
+        {
+            p_demux->pp_index[i] = p_demux->pp_index[j];
+            p_demux->pp_index[j] = NULL;
+            i = j;
+        }
+    }
+}
+
+/*****************************************************************************
+ * dvbpsi_demux_ignored_find
+ *****************************************************************************
+ * Slot of subtable i_id in the set of ignored subtables, or -1.
+ *****************************************************************************/
+static int dvbpsi_demux_ignored_find(const dvbpsi_demux_t *p_demux, const uint32_t i_id)
+{
+    const uint32_t i_key = i_id | DVBPSI_DEMUX_IGNORED_USED;
+    unsigned int i = dvbpsi_demux_hash(i_id, p_demux->i_ignored_mask);
+
+    while (p_demux->p_ignored[i].i_id)
+    {
+        if (p_demux->p_ignored[i].i_id == i_key)
+            return i;
+        i = (i + 1) & p_demux->i_ignored_mask;
+    }
+    return -1;
+}
+
+/*****************************************************************************
+ * dvbpsi_demux_ignored_remove
+ *****************************************************************************
+ * Same backward shift as dvbpsi_demux_index_remove().
+ *****************************************************************************/
+static void dvbpsi_demux_ignored_remove(dvbpsi_demux_t *p_demux, unsigned int i)
+{
+    const unsigned int i_mask = p_demux->i_ignored_mask;
+    dvbpsi_demux_ignored_t *p_ignored = p_demux->p_ignored;
+
+    p_ignored[i].i_id = 0;
+    p_demux->i_ignored_count--;
+
+    for (unsigned int j = (i + 1) & i_mask; p_ignored[j].i_id; j = (j + 1) & i_mask)
+    {
+        unsigned int k = dvbpsi_demux_hash(p_ignored[j].i_id & ~DVBPSI_DEMUX_IGNORED_USED,
+                                           i_mask);
+        if (((j - k) & i_mask) >= ((j - i) & i_mask))
+        {
+            p_ignored[i] = p_ignored[j];
+            p_ignored[j].i_id = 0;
+            i = j;
+        }
+    }
+}
+
+/*****************************************************************************
+ * dvbpsi_demux_ignored_check
+ *****************************************************************************
+ * Is subtable i_id ignored? Forget it once its time to live is over.
+ *****************************************************************************/
+static bool dvbpsi_demux_ignored_check(dvbpsi_demux_t *p_demux, const uint32_t i_id)
+{
+    if (p_demux->i_ignored_count == 0)
+        return false;
+
+    int i = dvbpsi_demux_ignored_find(p_demux, i_id);
+    if (i < 0)
+        return false;
+
+    if (p_demux->p_ignored[i].i_expiry
+     && dvbpsi_clock() >= p_demux->p_ignored[i].i_expiry)
+    {
+        dvbpsi_demux_ignored_remove(p_demux, i);
+        return false;
+    }
+    return true;
+}
+
 /*****************************************************************************
  * dvbpsi_AttachDemux
  *****************************************************************************
@@ -57,13 +233,23 @@ bool dvbpsi_AttachDemux(dvbpsi_t *            p_dvbpsi,
     assert(p_dvbpsi->p_decoder == NULL);
 
     dvbpsi_demux_t *p_demux;
-    p_demux = (dvbpsi_demux_t*) dvbpsi_decoder_new(&dvbpsi_Demux, 4096, true,
+    p_demux = (dvbpsi_demux_t*) dvbpsi_decoder_new(&dvbpsi_demux_sections_gather, 4096, true,
                                                    sizeof(dvbpsi_demux_t));
     if (p_demux == NULL)
         return false;
 
     /* Subtables demux configuration */
     p_demux->p_first_subdec = NULL;
+    dvbpsi_demux_index_build(p_demux, DVBPSI_DEMUX_INDEX_SIZE);
+    if (p_demux->pp_index == NULL)
+    {
+        dvbpsi_decoder_delete(DVBPSI_DECODER(p_demux));
+        return false;
+    }
+    p_demux->p_ignored = NULL;
+    p_demux->i_ignored_mask = 0;
+    p_demux->i_ignored_count = 0;
+    p_demux->p_first_range = NULL;
     p_demux->pf_new_callback = pf_new_cb;
     p_demux->p_new_cb_data = p_new_cb_data;
 
@@ -72,17 +258,31 @@ bool dvbpsi_AttachDemux(dvbpsi_t *            p_dvbpsi,
 }
 
 /*****************************************************************************
- * dvbpsi_demuxGetSubDec
+ * dvbpsi_demux_subdec_find
  *****************************************************************************
  * Finds a subtable decoder given the table id and extension
  *****************************************************************************/
-dvbpsi_demux_subdec_t * dvbpsi_demuxGetSubDec(dvbpsi_demux_t * p_demux,
-                                              uint8_t i_table_id,
-                                              uint16_t i_extension)
+static dvbpsi_demux_subdec_t *dvbpsi_demux_subdec_find(dvbpsi_demux_t *p_demux,
+                                                       const uint8_t i_table_id,
+                                                       const uint16_t i_extension)
 {
     uint32_t i_id = (uint32_t)i_table_id << 16 |(uint32_t)i_extension;
-    dvbpsi_demux_subdec_t * p_subdec = p_demux->p_first_subdec;
 
+    if (p_demux->pp_index)
+    {
+        unsigned int i = dvbpsi_demux_index_slot(p_demux, i_id);
+        dvbpsi_demux_subdec_t *p_subdec;
+
+        while ((p_subdec = p_demux->pp_index[i]) != NULL)
+        {
+            if (p_subdec->i_id == i_id)
+                return p_subdec;
+            i = (i + 1) & p_demux->i_index_mask;
+        }
+        return NULL;
+    }
+
+    dvbpsi_demux_subdec_t * p_subdec = p_demux->p_first_subdec;
     while (p_subdec)
     {
         if (p_subdec->i_id == i_id)
@@ -94,19 +294,181 @@ dvbpsi_demux_subdec_t * dvbpsi_demuxGetSubDec(dvbpsi_demux_t * p_demux,
     return p_subdec;
 }
 
+/*****************************************************************************
+ * dvbpsi_demuxGetSubDec
+ *****************************************************************************
+ * Finds a subtable decoder given the table id and extension
+ *****************************************************************************/
+dvbpsi_demux_subdec_t * dvbpsi_demuxGetSubDec(dvbpsi_demux_t * p_demux,
+                                              uint8_t i_table_id,
+                                              uint16_t i_extension)
+{
+    return dvbpsi_demux_subdec_find(p_demux, i_table_id, i_extension);
+}
+
+/*****************************************************************************
+ * dvbpsi_demux_decoder_find
+ *****************************************************************************
+ * Finds the decoder of a subtable if p_decoder is a demux
+ *****************************************************************************/
+dvbpsi_decoder_t *dvbpsi_demux_decoder_find(dvbpsi_decoder_t *p_decoder,
+                                            const uint8_t i_table_id,
+                                            const uint16_t i_extension)
+{
+    if (p_decoder->pf_gather != &dvbpsi_demux_sections_gather)
+        return NULL;
+
+    dvbpsi_demux_subdec_t *p_subdec =
+        dvbpsi_demux_subdec_find((dvbpsi_demux_t *)p_decoder, i_table_id, i_extension);
+    return p_subdec ? p_subdec->p_decoder : NULL;
+}
+
+/*****************************************************************************
+ * dvbpsi_demux_range_idle
+ *****************************************************************************
+ * Asks the range decoder of a subtable without decoder of its own
+ *****************************************************************************/
+bool dvbpsi_demux_range_idle(dvbpsi_decoder_t *p_decoder,
+                             const uint8_t i_table_id, const uint16_t i_extension,
+                             uint8_t *pi_version, bool *pb_current_next)
+{
+    if (p_decoder->pf_gather != &dvbpsi_demux_sections_gather)
+        return false;
+
+    dvbpsi_demux_range_t *p_range = dvbpsi_demux_range_get((dvbpsi_demux_t *)p_decoder,
+                                                           i_table_id);
+    return p_range && p_range->pf_idle
+        && p_range->pf_idle(p_range->p_decoder, i_table_id, i_extension,
+                            pi_version, pb_current_next);
+}
+
+/*****************************************************************************
+ * dvbpsi_demux_section_ignored
+ *****************************************************************************
+ * Is a section of an ignored subtable without decoder?
+ *****************************************************************************/
+bool dvbpsi_demux_section_ignored(dvbpsi_decoder_t *p_decoder,
+                                  const uint8_t i_table_id,
+                                  const uint16_t i_extension)
+{
+    if (p_decoder->pf_gather != &dvbpsi_demux_sections_gather)
+        return false;
+
+    dvbpsi_demux_t *p_demux = (dvbpsi_demux_t *)p_decoder;
+    return dvbpsi_demux_ignored_check(p_demux, (uint32_t)i_table_id << 16 | i_extension)
+        && dvbpsi_demux_subdec_find(p_demux, i_table_id, i_extension) == NULL
+        && dvbpsi_demux_range_get(p_demux, i_table_id) == NULL;
+}
+
+/*****************************************************************************
+ * dvbpsi_demux_ignore
+ *****************************************************************************/
+bool dvbpsi_demux_ignore(dvbpsi_t *p_dvbpsi, const uint8_t i_table_id,
+                         const uint16_t i_extension, const unsigned int i_ttl)
+{
+    assert(p_dvbpsi);
+    assert(p_dvbpsi->p_decoder);
+
+    dvbpsi_demux_t *p_demux = (dvbpsi_demux_t *)p_dvbpsi->p_decoder;
+    const uint32_t i_id = (uint32_t)i_table_id << 16 | i_extension;
+    const int64_t i_expiry = i_ttl ? dvbpsi_clock() + (int64_t)i_ttl * 1000 : 0;
+
+    int i = p_demux->p_ignored ? dvbpsi_demux_ignored_find(p_demux, i_id) : -1;
+    if (i >= 0)
+    {
+        p_demux->p_ignored[i].i_expiry = i_expiry;
+        return true;
+    }
+
+    /* Grow the set before it is half full */
+    if (p_demux->p_ignored == NULL
+     || 2 * (p_demux->i_ignored_count + 1) > p_demux->i_ignored_mask + 1)
+    {
+        const unsigned int i_size = p_demux->p_ignored ? 2 * (p_demux->i_ignored_mask + 1)
+                                                       : DVBPSI_DEMUX_INDEX_SIZE;
+        dvbpsi_demux_ignored_t *p_ignored = calloc(i_size, sizeof(dvbpsi_demux_ignored_t));
+        if (p_ignored == NULL)
+            return false;
+
+        for (unsigned int j = 0; p_demux->p_ignored && j <= p_demux->i_ignored_mask; j++)
+        {
+            if (!p_demux->p_ignored[j].i_id)
+                continue;
+            unsigned int k = dvbpsi_demux_hash(p_demux->p_ignored[j].i_id
+                                               & ~DVBPSI_DEMUX_IGNORED_USED, i_size - 1);
+            while (p_ignored[k].i_id)
+                k = (k + 1) & (i_size - 1);
+            p_ignored[k] = p_demux->p_ignored[j];
+        }
+        free(p_demux->p_ignored);
+        p_demux->p_ignored = p_ignored;
+        p_demux->i_ignored_mask = i_size - 1;
+    }
+
+    unsigned int k = dvbpsi_demux_hash(i_id, p_demux->i_ignored_mask);
+    while (p_demux->p_ignored[k].i_id)
+        k = (k + 1) & p_demux->i_ignored_mask;
+    p_demux->p_ignored[k].i_id = i_id | DVBPSI_DEMUX_IGNORED_USED;
+    p_demux->p_ignored[k].i_expiry = i_expiry;
+    p_demux->i_ignored_count++;
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_demux_ignore_clear
+ *****************************************************************************/
+void dvbpsi_demux_ignore_clear(dvbpsi_t *p_dvbpsi)
+{
+    assert(p_dvbpsi);
+    assert(p_dvbpsi->p_decoder);
+
+    dvbpsi_demux_t *p_demux = (dvbpsi_demux_t *)p_dvbpsi->p_decoder;
+    free(p_demux->p_ignored);
+    p_demux->p_ignored = NULL;
+    p_demux->i_ignored_mask = 0;
+    p_demux->i_ignored_count = 0;
+}
+
 /*****************************************************************************
  * dvbpsi_Demux
  *****************************************************************************
  * Sends a PSI section to the right subtable decoder
  *****************************************************************************/
 void dvbpsi_Demux(dvbpsi_t *p_dvbpsi, dvbpsi_psi_section_t *p_section)
+{
+    dvbpsi_demux_sections_gather(p_dvbpsi, p_section);
+}
+
+static void dvbpsi_demux_sections_gather(dvbpsi_t *p_dvbpsi,
+                                         dvbpsi_psi_section_t *p_section)
 {
     assert(p_dvbpsi);
     assert(p_dvbpsi->p_decoder);
 
     dvbpsi_demux_t * p_demux = (dvbpsi_demux_t *)p_dvbpsi->p_decoder;
-    dvbpsi_demux_subdec_t * p_subdec = dvbpsi_demuxGetSubDec(p_demux, p_section->i_table_id,
-                                                             p_section->i_extension);
+    dvbpsi_demux_subdec_t * p_subdec = dvbpsi_demux_subdec_find(p_demux, p_section->i_table_id,
+                                                                p_section->i_extension);
+    if (p_subdec == NULL)
+    {
+        /* Sections of a range without subtable decoder of their own */
+        dvbpsi_demux_range_t *p_range = dvbpsi_demux_range_get(p_demux, p_section->i_table_id);
+        if (p_range)
+        {
+            p_range->pf_gather(p_dvbpsi, p_range->p_decoder, p_section);
+            return;
+        }
+    }
+
+    if (p_subdec == NULL
+     && dvbpsi_demux_ignored_check(p_demux, (uint32_t)p_section->i_table_id << 16
+                                            | p_section->i_extension))
+    {
+        /* The application does not want this subtable */
+        p_dvbpsi->counters.i_ignored++;
+        dvbpsi_DeletePSISections(p_section);
+        return;
+    }
+
     if (p_subdec == NULL)
     {
         /* Tell the application we found a new subtable, so that it may attach a
@@ -115,12 +477,16 @@ void dvbpsi_Demux(dvbpsi_t *p_dvbpsi, dvbpsi_psi_section_t *p_section)
                                  p_demux->p_new_cb_data);
 
         /* Check if a new subtable decoder is available */
-        p_subdec = dvbpsi_demuxGetSubDec(p_demux, p_section->i_table_id,
-                                         p_section->i_extension);
+        p_subdec = dvbpsi_demux_subdec_find(p_demux, p_section->i_table_id,
+                                            p_section->i_extension);
     }
 
     if (p_subdec)
+    {
         p_subdec->pf_gather(p_dvbpsi, p_subdec->p_decoder, p_section);
+        if (p_dvbpsi->b_zero_copy)
+            dvbpsi_decoder_sections_own(p_dvbpsi, p_subdec->p_decoder);
+    }
     else
         dvbpsi_DeletePSISections(p_section);
 }
@@ -149,6 +515,23 @@ void dvbpsi_DetachDemux(dvbpsi_t *p_dvbpsi)
         else free(p_subdec_temp);
     }
 
+    dvbpsi_demux_range_t *p_range = p_demux->p_first_range;
+    while (p_range)
+    {
+        dvbpsi_demux_range_t *p_range_temp = p_range;
+        p_range = p_range->p_next;
+
+        if (p_range_temp->pf_detach)
+            p_range_temp->pf_detach(p_dvbpsi, p_range_temp->i_table_id_min,
+                                    p_range_temp->i_table_id_max);
+        else free(p_range_temp);
+    }
+
+    free(p_demux->pp_index);
+    p_demux->pp_index = NULL;
+    free(p_demux->p_ignored);
+    p_demux->p_ignored = NULL;
+
     dvbpsi_decoder_delete(p_dvbpsi->p_decoder);
     p_dvbpsi->p_decoder = NULL;
 }
@@ -208,8 +591,18 @@ void dvbpsi_AttachDemuxSubDecoder(dvbpsi_demux_t *p_demux, dvbpsi_demux_subdec_t
     if (!p_demux || !p_subdec)
         abort();
 
+    p_subdec->p_prev = NULL;
     p_subdec->p_next = p_demux->p_first_subdec;
+    if (p_subdec->p_next)
+        p_subdec->p_next->p_prev = p_subdec;
     p_demux->p_first_subdec = p_subdec;
+
+    /* Grow the index before it is half full */
+    if (p_demux->pp_index
+     && 2 * (p_demux->i_index_count + 1) > p_demux->i_index_mask + 1)
+        dvbpsi_demux_index_build(p_demux, 2 * (p_demux->i_index_mask + 1));
+    else if (p_demux->pp_index)
+        dvbpsi_demux_index_insert(p_demux, p_subdec);
 }
 
 /*****************************************************************************
@@ -225,10 +618,110 @@ void dvbpsi_DetachDemuxSubDecoder(dvbpsi_demux_t *p_demux, dvbpsi_demux_subdec_t
 
     assert(p_demux->p_first_subdec);
 
-    dvbpsi_demux_subdec_t** pp_prev_subdec;
-    pp_prev_subdec = &p_demux->p_first_subdec;
-    while(*pp_prev_subdec != p_subdec)
-        pp_prev_subdec = &(*pp_prev_subdec)->p_next;
+    if (p_demux->pp_index)
+        dvbpsi_demux_index_remove(p_demux, p_subdec);
+
+    if (p_subdec->p_prev)
+        p_subdec->p_prev->p_next = p_subdec->p_next;
+    else
+        p_demux->p_first_subdec = p_subdec->p_next;
+    if (p_subdec->p_next)
+        p_subdec->p_next->p_prev = p_subdec->p_prev;
+    p_subdec->p_next = p_subdec->p_prev = NULL;
+}
+
+/*****************************************************************************
+ * dvbpsi_demux_range_new
+ *****************************************************************************
+ * Allocate a new demux range decoder
+ *****************************************************************************/
+dvbpsi_demux_range_t *dvbpsi_demux_range_new(const uint8_t i_table_id_min,
+                                             const uint8_t i_table_id_max,
+                                             dvbpsi_demux_range_detach_cb_t pf_detach,
+                                             dvbpsi_demux_gather_cb_t pf_gather,
+                                             dvbpsi_decoder_t *p_decoder)
+{
+    assert(pf_gather);
+    assert(pf_detach);
+    assert(i_table_id_min <= i_table_id_max);
+
+    dvbpsi_demux_range_t *p_range = calloc(1, sizeof(dvbpsi_demux_range_t));
+    if (p_range == NULL)
+        return NULL;
+
+    p_range->i_table_id_min = i_table_id_min;
+    p_range->i_table_id_max = i_table_id_max;
+    p_range->p_decoder = p_decoder;
+    p_range->pf_gather = pf_gather;
+    p_range->pf_detach = pf_detach;
+
+    return p_range;
+}
+
+/*****************************************************************************
+ * dvbpsi_demux_range_delete
+ *****************************************************************************
+ * Free a demux range decoder
+ *****************************************************************************/
+void dvbpsi_demux_range_delete(dvbpsi_demux_range_t *p_range)
+{
+    if (!p_range)
+        return;
+    dvbpsi_decoder_delete(p_range->p_decoder);
+    free(p_range);
+}
+
+/*****************************************************************************
+ * dvbpsi_demux_range_get
+ *****************************************************************************/
+dvbpsi_demux_range_t *dvbpsi_demux_range_get(dvbpsi_demux_t *p_demux,
+                                             const uint8_t i_table_id)
+{
+    dvbpsi_demux_range_t *p_range = p_demux->p_first_range;
+    while (p_range)
+    {
+        if (i_table_id >= p_range->i_table_id_min
+         && i_table_id <= p_range->i_table_id_max)
+            break;
+        p_range = p_range->p_next;
+    }
+    return p_range;
+}
+
+/*****************************************************************************
+ * dvbpsi_demux_range_attach
+ *****************************************************************************/
+bool dvbpsi_demux_range_attach(dvbpsi_demux_t *p_demux, dvbpsi_demux_range_t *p_range)
+{
+    assert(p_demux);
+    assert(p_range);
+
+    for (dvbpsi_demux_range_t *p = p_demux->p_first_range; p; p = p->p_next)
+    {
+        if (p_range->i_table_id_min <= p->i_table_id_max
+         && p_range->i_table_id_max >= p->i_table_id_min)
+            return false;
+    }
+
+    p_range->p_next = p_demux->p_first_range;
+    p_demux->p_first_range = p_range;
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_demux_range_detach
+ *****************************************************************************/
+void dvbpsi_demux_range_detach(dvbpsi_demux_t *p_demux, dvbpsi_demux_range_t *p_range)
+{
+    assert(p_demux);
+    assert(p_range);
+
+    dvbpsi_demux_range_t **pp_range = &p_demux->p_first_range;
+    while (*pp_range && *pp_range != p_range)
+        pp_range = &(*pp_range)->p_next;
 
-    *pp_prev_subdec = p_subdec->p_next;
+    assert(*pp_range);
+    if (*pp_range)
+        *pp_range = p_range->p_next;
+    p_range->p_next = NULL;
 }
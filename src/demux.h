@@ -98,9 +98,68 @@ typedef struct dvbpsi_demux_subdec_s
   dvbpsi_demux_detach_cb_t      pf_detach; /*!< detach subdec callback */
 
   struct dvbpsi_demux_subdec_s *p_next;    /*!< next subdec */
+  struct dvbpsi_demux_subdec_s *p_prev;    /*!< previous subdec */
 } dvbpsi_demux_subdec_t;
 
 
+/*!
+ * \typedef void (*dvbpsi_demux_range_detach_cb_t) (dvbpsi_t *p_dvbpsi,
+                                                    uint8_t i_table_id_min,
+                                                    uint8_t i_table_id_max);
+ * \brief Callback used for detaching a range decoder from demuxer
+ */
+typedef void (*dvbpsi_demux_range_detach_cb_t) (dvbpsi_t *p_dvbpsi,       /*!< pointer to dvbpsi handle */
+                                                uint8_t i_table_id_min,   /*!< first table id of the range */
+                                                uint8_t i_table_id_max);  /*!< last table id of the range */
+
+/*!
+ * \typedef bool (*dvbpsi_demux_range_idle_cb_t) (dvbpsi_decoder_t *p_decoder,
+                                                  uint8_t i_table_id,
+                                                  uint16_t i_extension,
+                                                  uint8_t *pi_version,
+                                                  bool *pb_current_next);
+ * \brief Callback used to know if a subtable of a range decoder holds a
+ * complete table and has nothing being built. It then gives the
+ * version_number and current_next_indicator of that table.
+ */
+typedef bool (*dvbpsi_demux_range_idle_cb_t) (dvbpsi_decoder_t *p_decoder,  /*!< private decoder of the range */
+                                              uint8_t i_table_id,           /*!< table id of the subtable */
+                                              uint16_t i_extension,         /*!< extension of the subtable */
+                                              uint8_t *pi_version,          /*!< version of its table */
+                                              bool *pb_current_next);       /*!< current_next of its table */
+
+/*****************************************************************************
+ * dvbpsi_demux_range_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_demux_range_s
+ * \brief Range decoder structure
+ *
+ * This structure contains the data specific to the decoding of all the
+ * subtables of a range of table ids, whatever their extension. The range
+ * decoder keeps the state of each subtable itself. With pf_idle, the
+ * repetitions of the complete subtables of the range are dropped before
+ * reassembly like the ones of a subtable decoder.
+ */
+/*!
+ * \typedef struct dvbpsi_demux_range_s dvbpsi_demux_range_t
+ * \brief dvbpsi_demux_range_t type definition.
+ */
+typedef struct dvbpsi_demux_range_s
+{
+  uint8_t                       i_table_id_min; /*!< first table id */
+  uint8_t                       i_table_id_max; /*!< last table id */
+
+  dvbpsi_demux_gather_cb_t      pf_gather; /*!< gather range callback */
+  dvbpsi_decoder_t             *p_decoder; /*!< private decoder for this range */
+
+  dvbpsi_demux_range_detach_cb_t pf_detach; /*!< detach range callback */
+  dvbpsi_demux_range_idle_cb_t pf_idle;    /*!< idle subtable callback, may
+                                                be NULL */
+
+  struct dvbpsi_demux_range_s  *p_next;    /*!< next range */
+} dvbpsi_demux_range_t;
+
 /*****************************************************************************
  * dvbpsi_demux_s
  *****************************************************************************/
@@ -122,6 +181,19 @@ struct dvbpsi_demux_s
     DVBPSI_DECODER_COMMON
 
     dvbpsi_demux_subdec_t *   p_first_subdec;     /*!< First subtable decoder */
+    dvbpsi_demux_subdec_t **  pp_index;           /*!< private: open addressing
+                                                     index of the subtable
+                                                     decoders by id */
+    unsigned int              i_index_mask;       /*!< private: index size - 1 */
+    unsigned int              i_index_count;      /*!< private: subtable decoders
+                                                     in the index */
+    struct dvbpsi_demux_ignored_s *p_ignored;     /*!< private: open addressing
+                                                     set of the ignored
+                                                     subtables */
+    unsigned int              i_ignored_mask;     /*!< private: set size - 1 */
+    unsigned int              i_ignored_count;    /*!< private: ignored
+                                                     subtables in the set */
+    dvbpsi_demux_range_t *    p_first_range;      /*!< First range decoder */
 
     /* New subtable callback */
     dvbpsi_demux_new_cb_t     pf_new_callback;    /*!< New subtable callback */
@@ -250,6 +322,124 @@ void dvbpsi_AttachDemuxSubDecoder(dvbpsi_demux_t *p_demux, dvbpsi_demux_subdec_t
 __attribute__((deprecated))
 void dvbpsi_DetachDemuxSubDecoder(dvbpsi_demux_t *p_demux, dvbpsi_demux_subdec_t *p_subdec);
 
+/*****************************************************************************
+ * dvbpsi_demux_range_new
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_demux_range_t *dvbpsi_demux_range_new(const uint8_t i_table_id_min,
+                                              const uint8_t i_table_id_max,
+                                              dvbpsi_demux_range_detach_cb_t pf_detach,
+                                              dvbpsi_demux_gather_cb_t pf_gather,
+                                              dvbpsi_decoder_t *p_decoder)
+ * \brief Allocates a new demux range decoder and initializes it.
+ * \param i_table_id_min first table id of the range
+ * \param i_table_id_max last table id of the range
+ * \param pf_detach pointer to detach function for the range decoder.
+ * \param pf_gather pointer to gather function for the range decoder, it
+ * receives the sections of all the subtables of the range.
+ * \param p_decoder pointer to private decoder.
+ * \return pointer to demux range decoder.
+ */
+dvbpsi_demux_range_t *dvbpsi_demux_range_new(const uint8_t i_table_id_min,
+                                             const uint8_t i_table_id_max,
+                                             dvbpsi_demux_range_detach_cb_t pf_detach,
+                                             dvbpsi_demux_gather_cb_t pf_gather,
+                                             dvbpsi_decoder_t *p_decoder);
+
+/*****************************************************************************
+ * dvbpsi_demux_range_delete
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_demux_range_delete(dvbpsi_demux_range_t *p_range)
+ * \brief Releases a range decoder allocated with dvbpsi_demux_range_new()
+ * and its private decoder.
+ * \param p_range pointer to demux range decoder.
+ * \return nothing.
+ */
+void dvbpsi_demux_range_delete(dvbpsi_demux_range_t *p_range);
+
+/*****************************************************************************
+ * dvbpsi_demux_range_attach
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_demux_range_attach(dvbpsi_demux_t *p_demux,
+                                      dvbpsi_demux_range_t *p_range)
+ * \brief Attach a range decoder to the given demux handle.
+ * \param p_demux pointer to dvbpsi_demux_t
+ * \param p_range pointer to dvbpsi_demux_range_t
+ * \return true on success, false if the range overlaps an attached one.
+ *
+ * The sections of a subtable with its own subtable decoder are given to
+ * this decoder, the other sections with a table id in the range are given
+ * to the range decoder. The new subtable callback is not called for them.
+ */
+bool dvbpsi_demux_range_attach(dvbpsi_demux_t *p_demux, dvbpsi_demux_range_t *p_range);
+
+/*****************************************************************************
+ * dvbpsi_demux_range_detach
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_demux_range_detach(dvbpsi_demux_t *p_demux,
+                                      dvbpsi_demux_range_t *p_range)
+ * \brief Detach a range decoder from the given demux handle.
+ * \param p_demux pointer to dvbpsi_demux_t
+ * \param p_range pointer to dvbpsi_demux_range_t
+ * \return nothing
+ */
+void dvbpsi_demux_range_detach(dvbpsi_demux_t *p_demux, dvbpsi_demux_range_t *p_range);
+
+/*****************************************************************************
+ * dvbpsi_demux_range_get
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_demux_range_t *dvbpsi_demux_range_get(dvbpsi_demux_t *p_demux,
+                                                    const uint8_t i_table_id)
+ * \brief Looks for the range decoder of a table id.
+ * \param p_demux pointer to the demux structure.
+ * \param i_table_id table id
+ * \return a pointer to the range decoder, or NULL.
+ */
+dvbpsi_demux_range_t *dvbpsi_demux_range_get(dvbpsi_demux_t *p_demux,
+                                             const uint8_t i_table_id);
+
+/*****************************************************************************
+ * dvbpsi_demux_ignore
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_demux_ignore(dvbpsi_t *p_dvbpsi, const uint8_t i_table_id,
+                                const uint16_t i_extension,
+                                const unsigned int i_ttl)
+ * \brief Ignore a subtable the application does not want to decode.
+ * \param p_dvbpsi handle of the demux
+ * \param i_table_id table id of the subtable
+ * \param i_extension table extension of the subtable
+ * \param i_ttl time in milliseconds after which the subtable is reported
+ * again by the new subtable callback, 0 to ignore it until
+ * dvbpsi_demux_ignore_clear() is called.
+ * \return true on success, false on failure.
+ *
+ * Typically called from the new subtable callback for the subtables it does
+ * not attach a decoder to. The sections of an ignored subtable without
+ * decoder are dropped without calling the new subtable callback, before
+ * being reassembled when their header is in the first TS packet. Ignoring a
+ * subtable already ignored updates its time to live.
+ */
+bool dvbpsi_demux_ignore(dvbpsi_t *p_dvbpsi, const uint8_t i_table_id,
+                         const uint16_t i_extension, const unsigned int i_ttl);
+
+/*****************************************************************************
+ * dvbpsi_demux_ignore_clear
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_demux_ignore_clear(dvbpsi_t *p_dvbpsi)
+ * \brief Stop ignoring the subtables ignored with dvbpsi_demux_ignore().
+ * \param p_dvbpsi handle of the demux
+ * \return nothing
+ *
+ * The new subtable callback is called again for these subtables.
+ */
+void dvbpsi_demux_ignore_clear(dvbpsi_t *p_dvbpsi);
+
 #ifdef __cplusplus
 };
 #endif
@@ -39,8 +39,167 @@
 #include <assert.h>
 
 #include "dvbpsi.h"
+#include "dvbpsi_private.h"
 #include "descriptor.h"
 
+#include "descriptors/dr.h"
+
+/*****************************************************************************
+ * Descriptor decoders
+ *****************************************************************************
+ * The decoder of each tag, and the decoders of private tags which replace it
+ * when a private_data_specifier is in force.
+ *****************************************************************************/
+#define DVBPSI_DESCRIPTOR_DECODER(pf)                                          \
+static void *pf##_generic(dvbpsi_descriptor_t *p_descriptor)                   \
+{                                                                              \
+    return pf(p_descriptor);                                                   \
+}
+
+/* The decoders return their own descriptor types, they are called through
+ * functions of the dvbpsi_descriptor_decoder_t type */
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeVStreamDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeAStreamDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeHierarchyDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeRegistrationDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeDSAlignmentDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeTargetBgGridDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeVWindowDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeCADr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeISO639Dr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeSystemClockDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeMxBuffUtilizationDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeCopyrightDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeMaxBitrateDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodePrivateDataDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeSmoothingBufferDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeSTDDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeIBPDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeCarouselIdDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeAssociationTagDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeMPEG4VideoDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeMPEG4AudioDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeContentLabellingDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeNetworkNameDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeServiceListDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeStuffingDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeSatDelivSysDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeCableDelivSysDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeVBIDataDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeBouquetNameDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeServiceDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeCountryAvailability)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeLinkageDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeNVODReferenceDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeTimeShiftedServiceDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeShortEventDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeExtendedEventDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeTimeShiftedEventDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeComponentDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeStreamIdentifierDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeCAIdentifierDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeContentDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeParentalRatingDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeTeletextDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeLocalTimeOffsetDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeSubtitlingDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeTerrDelivSysDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeFrequencyListDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeDataBroadcastIdDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodePDCDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeDefaultAuthorityDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeContentIdDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeAACDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeAc3AudioDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeLCNDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeCaptionServiceDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeCUEIDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeExtendedChannelNameDr)
+DVBPSI_DESCRIPTOR_DECODER(dvbpsi_DecodeServiceLocationDr)
+
+static dvbpsi_descriptor_decoder_t dvbpsi_descriptor_decoders[256] =
+{
+    [0x02] = dvbpsi_DecodeVStreamDr_generic,
+    [0x03] = dvbpsi_DecodeAStreamDr_generic,
+    [0x04] = dvbpsi_DecodeHierarchyDr_generic,
+    [0x05] = dvbpsi_DecodeRegistrationDr_generic,
+    [0x06] = dvbpsi_DecodeDSAlignmentDr_generic,
+    [0x07] = dvbpsi_DecodeTargetBgGridDr_generic,
+    [0x08] = dvbpsi_DecodeVWindowDr_generic,
+    [0x09] = dvbpsi_DecodeCADr_generic,
+    [0x0a] = dvbpsi_DecodeISO639Dr_generic,
+    [0x0b] = dvbpsi_DecodeSystemClockDr_generic,
+    [0x0c] = dvbpsi_DecodeMxBuffUtilizationDr_generic,
+    [0x0d] = dvbpsi_DecodeCopyrightDr_generic,
+    [0x0e] = dvbpsi_DecodeMaxBitrateDr_generic,
+    [0x0f] = dvbpsi_DecodePrivateDataDr_generic,
+    [0x10] = dvbpsi_DecodeSmoothingBufferDr_generic,
+    [0x11] = dvbpsi_DecodeSTDDr_generic,
+    [0x12] = dvbpsi_DecodeIBPDr_generic,
+    [0x13] = dvbpsi_DecodeCarouselIdDr_generic,
+    [0x14] = dvbpsi_DecodeAssociationTagDr_generic,
+    [0x1b] = dvbpsi_DecodeMPEG4VideoDr_generic,
+    [0x1c] = dvbpsi_DecodeMPEG4AudioDr_generic,
+    [0x24] = dvbpsi_DecodeContentLabellingDr_generic,
+    [0x40] = dvbpsi_DecodeNetworkNameDr_generic,
+    [0x41] = dvbpsi_DecodeServiceListDr_generic,
+    [0x42] = dvbpsi_DecodeStuffingDr_generic,
+    [0x43] = dvbpsi_DecodeSatDelivSysDr_generic,
+    [0x44] = dvbpsi_DecodeCableDelivSysDr_generic,
+    [0x45] = dvbpsi_DecodeVBIDataDr_generic,
+    [0x47] = dvbpsi_DecodeBouquetNameDr_generic,
+    [0x48] = dvbpsi_DecodeServiceDr_generic,
+    [0x49] = dvbpsi_DecodeCountryAvailability_generic,
+    [0x4a] = dvbpsi_DecodeLinkageDr_generic,
+    [0x4b] = dvbpsi_DecodeNVODReferenceDr_generic,
+    [0x4c] = dvbpsi_DecodeTimeShiftedServiceDr_generic,
+    [0x4d] = dvbpsi_DecodeShortEventDr_generic,
+    [0x4e] = dvbpsi_DecodeExtendedEventDr_generic,
+    [0x4f] = dvbpsi_DecodeTimeShiftedEventDr_generic,
+    [0x50] = dvbpsi_DecodeComponentDr_generic,
+    [0x52] = dvbpsi_DecodeStreamIdentifierDr_generic,
+    [0x53] = dvbpsi_DecodeCAIdentifierDr_generic,
+    [0x54] = dvbpsi_DecodeContentDr_generic,
+    [0x55] = dvbpsi_DecodeParentalRatingDr_generic,
+    [0x56] = dvbpsi_DecodeTeletextDr_generic,
+    [0x58] = dvbpsi_DecodeLocalTimeOffsetDr_generic,
+    [0x59] = dvbpsi_DecodeSubtitlingDr_generic,
+    [0x5a] = dvbpsi_DecodeTerrDelivSysDr_generic,
+    [0x62] = dvbpsi_DecodeFrequencyListDr_generic,
+    [0x66] = dvbpsi_DecodeDataBroadcastIdDr_generic,
+    [0x69] = dvbpsi_DecodePDCDr_generic,
+    [0x73] = dvbpsi_DecodeDefaultAuthorityDr_generic,
+    [0x76] = dvbpsi_DecodeContentIdDr_generic,
+    [0x7c] = dvbpsi_DecodeAACDr_generic,
+    /* Private tags of ATSC A/52 and A/65, EACEM and SCTE 35, which are used
+     * without private_data_specifier */
+    [0x81] = dvbpsi_DecodeAc3AudioDr_generic,
+    [0x83] = dvbpsi_DecodeLCNDr_generic,
+    [0x86] = dvbpsi_DecodeCaptionServiceDr_generic,
+    [0x8a] = dvbpsi_DecodeCUEIDr_generic,
+    [0xa0] = dvbpsi_DecodeExtendedChannelNameDr_generic,
+    [0xa1] = dvbpsi_DecodeServiceLocationDr_generic,
+};
+
+typedef struct dvbpsi_descriptor_private_decoder_s
+{
+    uint32_t                    i_private_data_specifier;
+    uint8_t                     i_tag;
+    dvbpsi_descriptor_decoder_t pf_decode;
+} dvbpsi_descriptor_private_decoder_t;
+
+#define DVBPSI_PRIVATE_DECODERS_MAX 32
+
+static dvbpsi_descriptor_private_decoder_t
+                        dvbpsi_private_decoders[DVBPSI_PRIVATE_DECODERS_MAX] =
+{
+    /* logical_channel_descriptor of EACEM, NorDig and DTG */
+    { 0x00000028, 0x83, dvbpsi_DecodeLCNDr_generic },
+    { 0x00000029, 0x83, dvbpsi_DecodeLCNDr_generic },
+    { 0x0000233a, 0x83, dvbpsi_DecodeLCNDr_generic },
+};
+static unsigned int dvbpsi_private_decoders_count = 3;
+
 /*****************************************************************************
  * dvbpsi_IsDescriptor
  *****************************************************************************
@@ -96,6 +255,7 @@ dvbpsi_descriptor_t* dvbpsi_NewDescriptor(uint8_t i_tag, uint8_t i_length,
     {
         p_descriptor->i_tag = i_tag;
         p_descriptor->i_length = i_length;
+        p_descriptor->b_arena = false;
         if (p_data)
             memcpy(p_descriptor->p_data, p_data, i_length);
         p_descriptor->p_decoded = NULL;
@@ -132,6 +292,29 @@ dvbpsi_descriptor_t *dvbpsi_AddDescriptor(dvbpsi_descriptor_t *p_list,
     return p_list;
 }
 
+/*****************************************************************************
+ * dvbpsi_descriptor_append
+ *****************************************************************************
+ * Append p_descriptor to the list *pp_first, searching its end from *pp_last.
+ *****************************************************************************/
+void dvbpsi_descriptor_append(dvbpsi_descriptor_t **pp_first,
+                              dvbpsi_descriptor_t **pp_last,
+                              dvbpsi_descriptor_t *p_descriptor)
+{
+    assert(p_descriptor);
+
+    if (*pp_first == NULL)
+        *pp_first = p_descriptor;
+    else
+    {
+        dvbpsi_descriptor_t *p_last = *pp_last ? *pp_last : *pp_first;
+        while (p_last->p_next != NULL)
+            p_last = p_last->p_next;
+        p_last->p_next = p_descriptor;
+    }
+    *pp_last = p_descriptor;
+}
+
 /*****************************************************************************
  * dvbpsi_DeleteDescriptors
  *****************************************************************************
@@ -169,3 +352,112 @@ void *dvbpsi_DuplicateDecodedDescriptor(void *p_decoded, ssize_t i_size)
         memcpy(p_duplicate, p_decoded, i_size);
     return p_duplicate;
 }
+
+/*****************************************************************************
+ * dvbpsi_RegisterDescriptorDecoder
+ *****************************************************************************/
+bool dvbpsi_RegisterDescriptorDecoder(uint8_t i_tag, uint32_t i_private_data_specifier,
+                                      dvbpsi_descriptor_decoder_t pf_decode)
+{
+    if (i_private_data_specifier == 0)
+    {
+        dvbpsi_descriptor_decoders[i_tag] = pf_decode;
+        return true;
+    }
+
+    if (i_tag < 0x80 || i_tag == 0xff)
+        return false;
+
+    unsigned int i = 0;
+    while (i < dvbpsi_private_decoders_count
+        && (dvbpsi_private_decoders[i].i_private_data_specifier != i_private_data_specifier
+         || dvbpsi_private_decoders[i].i_tag != i_tag))
+        i++;
+    if (i == DVBPSI_PRIVATE_DECODERS_MAX)
+        return false;
+    if (i == dvbpsi_private_decoders_count)
+        dvbpsi_private_decoders_count++;
+
+    dvbpsi_private_decoders[i].i_private_data_specifier = i_private_data_specifier;
+    dvbpsi_private_decoders[i].i_tag = i_tag;
+    dvbpsi_private_decoders[i].pf_decode = pf_decode;
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_DecodeDescriptor
+ *****************************************************************************
+ * Private tags are only decoded by the decoders of the private_data_specifier
+ * in force, if there is one.
+ *****************************************************************************/
+void *dvbpsi_DecodeDescriptor(dvbpsi_descriptor_t *p_descriptor,
+                              uint32_t i_private_data_specifier)
+{
+    assert(p_descriptor);
+
+    const uint8_t i_tag = p_descriptor->i_tag;
+    dvbpsi_descriptor_decoder_t pf_decode = dvbpsi_descriptor_decoders[i_tag];
+
+    if (i_private_data_specifier && i_tag >= 0x80)
+    {
+        pf_decode = NULL;
+        for (unsigned int i = 0; i < dvbpsi_private_decoders_count; i++)
+        {
+            if (dvbpsi_private_decoders[i].i_private_data_specifier == i_private_data_specifier
+             && dvbpsi_private_decoders[i].i_tag == i_tag)
+            {
+                pf_decode = dvbpsi_private_decoders[i].pf_decode;
+                break;
+            }
+        }
+    }
+
+    return pf_decode ? pf_decode(p_descriptor) : NULL;
+}
+
+/*****************************************************************************
+ * dvbpsi_descriptors_select
+ *****************************************************************************/
+void dvbpsi_descriptors_select(uint8_t p_selected[256],
+                               const uint8_t *p_tags, const unsigned int i_tags)
+{
+    memset(p_selected, p_tags == NULL, 256);
+    for (unsigned int i = 0; p_tags && i < i_tags; i++)
+        p_selected[p_tags[i]] = 1;
+}
+
+/*****************************************************************************
+ * dvbpsi_DecodeAllDescriptors
+ *****************************************************************************/
+unsigned int dvbpsi_DecodeAllDescriptors(dvbpsi_descriptor_t *p_descriptor,
+                                         uint32_t i_private_data_specifier,
+                                         const uint8_t *p_tags, unsigned int i_tags)
+{
+    uint8_t p_selected[256];
+    dvbpsi_descriptors_select(p_selected, p_tags, i_tags);
+    return dvbpsi_descriptors_decode(p_descriptor, i_private_data_specifier, p_selected);
+}
+
+/*****************************************************************************
+ * dvbpsi_descriptors_decode
+ *****************************************************************************/
+unsigned int dvbpsi_descriptors_decode(dvbpsi_descriptor_t *p_descriptor,
+                                       uint32_t i_private_data_specifier,
+                                       const uint8_t p_selected[256])
+{
+    unsigned int i_decoded = 0;
+    for (; p_descriptor; p_descriptor = p_descriptor->p_next)
+    {
+        /* private_data_specifier_descriptor */
+        if (p_descriptor->i_tag == 0x5f && p_descriptor->i_length >= 4)
+            i_private_data_specifier = ((uint32_t)p_descriptor->p_data[0] << 24)
+                                     | ((uint32_t)p_descriptor->p_data[1] << 16)
+                                     | ((uint32_t)p_descriptor->p_data[2] << 8)
+                                     | p_descriptor->p_data[3];
+
+        if (p_selected[p_descriptor->i_tag]
+         && dvbpsi_DecodeDescriptor(p_descriptor, i_private_data_specifier))
+            i_decoded++;
+    }
+    return i_decoded;
+}
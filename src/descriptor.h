@@ -83,6 +83,9 @@ typedef struct dvbpsi_descriptor_s
 {
   uint8_t                       i_tag;          /*!< descriptor_tag */
   uint8_t                       i_length;       /*!< descriptor_length */
+  bool                          b_arena;        /*!< allocated in the arena
+                                                     of its table, set by
+                                                     libdvbpsi */
 
   uint8_t *                     p_data;         /*!< content */
 
@@ -171,6 +174,92 @@ bool dvbpsi_IsDescriptorDecoded(dvbpsi_descriptor_t *p_descriptor);
  */
 void *dvbpsi_DuplicateDecodedDescriptor(void *p_decoded, ssize_t i_size);
 
+/*****************************************************************************
+ * dvbpsi_descriptor_decoder_t
+ *****************************************************************************/
+/*!
+ * \typedef void *(*dvbpsi_descriptor_decoder_t)(dvbpsi_descriptor_t *p_descriptor)
+ * \brief Descriptor decoder, dvbpsi_DecodeShortEventDr() for instance.
+ *
+ * A decoder returns the decoded descriptor, which it attaches to
+ * p_descriptor->p_decoded, or NULL if the descriptor can not be decoded.
+ * The decoded descriptor is then freed with p_descriptor. Decoders which do
+ * not attach their result, such as the compact decoders
+ * dvbpsi_DecodeShortEventCompactDr() and the like, are not decoders of this
+ * type.
+ */
+typedef void *(*dvbpsi_descriptor_decoder_t)(dvbpsi_descriptor_t *p_descriptor);
+
+/*****************************************************************************
+ * dvbpsi_RegisterDescriptorDecoder
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_RegisterDescriptorDecoder(uint8_t i_tag,
+                                    uint32_t i_private_data_specifier,
+                                    dvbpsi_descriptor_decoder_t pf_decode);
+ * \brief Set the decoder used by dvbpsi_DecodeDescriptor() for a tag.
+ *
+ * All the decoders of libdvbpsi are registered for their tag. With a
+ * private_data_specifier other than 0, the decoder only applies to the
+ * private tags 0x80 to 0xfe when that private_data_specifier is in force,
+ * replacing the decoder registered with 0. The decoders are shared by the
+ * whole library: register them before decoding descriptors.
+ *
+ * pf_decode must attach the decoded descriptor to p_descriptor->p_decoded,
+ * dvbpsi_DecodeAllDescriptors() drops the pointers it returns and a result
+ * which is not attached leaks. Wrap a decoder which does not attach its
+ * result, a compact decoder for instance, in one which does.
+ * \param i_tag descriptor tag
+ * \param i_private_data_specifier private_data_specifier, or 0 for any
+ * \param pf_decode the decoder, or NULL to leave these descriptors undecoded
+ * \return true on success, false if the tag is not private or there are too
+ * many private_data_specifier decoders.
+ */
+bool dvbpsi_RegisterDescriptorDecoder(uint8_t i_tag, uint32_t i_private_data_specifier,
+                                      dvbpsi_descriptor_decoder_t pf_decode);
+
+/*****************************************************************************
+ * dvbpsi_DecodeDescriptor
+ *****************************************************************************/
+/*!
+ * \fn void *dvbpsi_DecodeDescriptor(dvbpsi_descriptor_t *p_descriptor,
+                                   uint32_t i_private_data_specifier);
+ * \brief Decode a descriptor with the decoder registered for its tag.
+ * \param p_descriptor pointer to the descriptor structure
+ * \param i_private_data_specifier private_data_specifier in force, 0 if none
+ * \return the decoded descriptor, NULL if it has no decoder or can not be
+ * decoded.
+ */
+void *dvbpsi_DecodeDescriptor(dvbpsi_descriptor_t *p_descriptor,
+                              uint32_t i_private_data_specifier);
+
+/*****************************************************************************
+ * dvbpsi_DecodeAllDescriptors
+ *****************************************************************************/
+/*!
+ * \fn unsigned int dvbpsi_DecodeAllDescriptors(dvbpsi_descriptor_t *p_descriptor,
+                                              uint32_t i_private_data_specifier,
+                                              const uint8_t *p_tags,
+                                              unsigned int i_tags);
+ * \brief Decode the descriptors of a descriptor loop.
+ *
+ * The private_data_specifier_descriptors (tag 0x5f) of the loop change the
+ * private_data_specifier in force for the descriptors which follow them.
+ * The decoded descriptors are found in their p_decoded member.
+ * \param p_descriptor first descriptor of the loop, p_first_descriptor of a
+ * table for instance. The descriptors of a whole PMT, SDT, EIT, NIT or BAT
+ * are decoded with dvbpsi_pmt_decode_descriptors() and the like.
+ * \param i_private_data_specifier private_data_specifier in force at the
+ * start of the loop, 0 if none
+ * \param p_tags tags of the descriptors to decode, NULL to decode all of
+ * them
+ * \param i_tags number of tags in p_tags
+ * \return the number of decoded descriptors.
+ */
+unsigned int dvbpsi_DecodeAllDescriptors(dvbpsi_descriptor_t *p_descriptor,
+                                         uint32_t i_private_data_specifier,
+                                         const uint8_t *p_tags, unsigned int i_tags);
+
 #ifdef __cplusplus
 };
 #endif
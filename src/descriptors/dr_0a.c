@@ -122,3 +122,34 @@ dvbpsi_descriptor_t * dvbpsi_GenISO639Dr(dvbpsi_iso639_dr_t * p_decoded,
     return p_descriptor;
 }
 
+/*****************************************************************************
+ * dvbpsi_DecodeISO639CompactDr
+ *****************************************************************************/
+dvbpsi_iso639_compact_dr_t * dvbpsi_DecodeISO639CompactDr(dvbpsi_descriptor_t * p_descriptor)
+{
+    /* Check the tag */
+    if (!dvbpsi_CanDecodeAsDescriptor(p_descriptor, 0x0a))
+        return NULL;
+
+    if ((p_descriptor->i_length < 1) ||
+        (p_descriptor->i_length % 4 != 0))
+        return NULL;
+
+    /* Allocate memory, the codes follow the structure */
+    const int i_count = p_descriptor->i_length / 4;
+    dvbpsi_iso639_compact_dr_t *p_decoded;
+    p_decoded = malloc(sizeof(dvbpsi_iso639_compact_dr_t)
+                       + i_count * sizeof(dvbpsi_iso639_code_t));
+    if (!p_decoded)
+        return NULL;
+
+    p_decoded->i_code_count = i_count;
+    p_decoded->code = (dvbpsi_iso639_code_t *)(p_decoded + 1);
+    for (int i = 0; i < i_count; i++)
+    {
+        memcpy(p_decoded->code[i].iso_639_code, &p_descriptor->p_data[i*4], 3);
+        p_decoded->code[i].i_audio_type = p_descriptor->p_data[i*4+3];
+    }
+
+    return p_decoded;
+}
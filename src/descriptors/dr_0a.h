@@ -41,6 +41,23 @@ extern "C" {
 
 #define DR_0A_API_VER 2                     /*!< descriptor 0a API version */
 
+/*****************************************************************************
+ * dvbpsi_iso639_code_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_iso639_code_s
+ * \brief One language of an "ISO 639 language" descriptor.
+ */
+/*!
+ * \typedef struct dvbpsi_iso639_code_s dvbpsi_iso639_code_t
+ * \brief dvbpsi_iso639_code_t type definition.
+ */
+typedef struct dvbpsi_iso639_code_s
+{
+  iso_639_language_code_t  iso_639_code; /*!< ISO_639_language_code */
+  uint8_t                  i_audio_type; /*!< audio_type */
+} dvbpsi_iso639_code_t;
+
 /*****************************************************************************
  * dvbpsi_iso639_dr_t
  *****************************************************************************/
@@ -59,10 +76,7 @@ typedef struct dvbpsi_iso639_dr_s
 {
   uint8_t       i_code_count;           /*!< length of the i_iso_639_code
                                              array */
-  struct {
-    iso_639_language_code_t  iso_639_code; /*!< ISO_639_language_code */
-    uint8_t                  i_audio_type; /*!< audio_type */
-  } code[64];                              /*!< list of ISO 639 codes */
+  dvbpsi_iso639_code_t code[64];        /*!< list of ISO 639 codes */
 
 } dvbpsi_iso639_dr_t;
 
@@ -97,6 +111,41 @@ dvbpsi_iso639_dr_t* dvbpsi_DecodeISO639Dr(dvbpsi_descriptor_t * p_descriptor);
 dvbpsi_descriptor_t * dvbpsi_GenISO639Dr(dvbpsi_iso639_dr_t * p_decoded,
                                          bool b_duplicate);
 
+/*****************************************************************************
+ * dvbpsi_iso639_compact_dr_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_iso639_compact_dr_s
+ * \brief Compact "ISO 639 language" descriptor structure.
+ *
+ * Same fields as dvbpsi_iso639_dr_t, with the code array sized to the
+ * number of languages of the descriptor.
+ */
+/*!
+ * \typedef struct dvbpsi_iso639_compact_dr_s dvbpsi_iso639_compact_dr_t
+ * \brief dvbpsi_iso639_compact_dr_t type definition.
+ */
+typedef struct dvbpsi_iso639_compact_dr_s
+{
+  uint8_t               i_code_count;   /*!< length of the code array */
+  dvbpsi_iso639_code_t *code;           /*!< list of ISO 639 codes */
+
+} dvbpsi_iso639_compact_dr_t;
+
+
+/*****************************************************************************
+ * dvbpsi_DecodeISO639CompactDr
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_iso639_compact_dr_t * dvbpsi_DecodeISO639CompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor)
+ * \brief "ISO 639 language" descriptor decoder giving the compact form.
+ * \param p_descriptor pointer to the descriptor structure
+ * \return a pointer to a new compact "ISO 639 language" descriptor structure, or NULL.
+ * It is not attached to the descriptor and is released with free().
+ */
+dvbpsi_iso639_compact_dr_t * dvbpsi_DecodeISO639CompactDr(dvbpsi_descriptor_t * p_descriptor);
+
 
 #ifdef __cplusplus
 };
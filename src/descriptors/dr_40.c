@@ -103,3 +103,30 @@ dvbpsi_descriptor_t * dvbpsi_GenNetworkNameDr(
 
     return p_descriptor;
 }
+
+/*****************************************************************************
+ * dvbpsi_DecodeNetworkNameCompactDr
+ *****************************************************************************/
+dvbpsi_network_name_compact_dr_t* dvbpsi_DecodeNetworkNameCompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor)
+{
+    /* Check the tag */
+    if (!dvbpsi_CanDecodeAsDescriptor(p_descriptor, 0x40))
+        return NULL;
+
+    /* Allocate memory, the name follows the structure */
+    dvbpsi_network_name_compact_dr_t * p_decoded;
+    p_decoded = malloc(sizeof(dvbpsi_network_name_compact_dr_t) + p_descriptor->i_length);
+    if (!p_decoded)
+        return NULL;
+
+    /* Decode data */
+    p_decoded->i_name_length = p_descriptor->i_length;
+    p_decoded->i_name_byte = (uint8_t *)(p_decoded + 1);
+    if (p_decoded->i_name_length)
+        memcpy(p_decoded->i_name_byte,
+               p_descriptor->p_data,
+               p_decoded->i_name_length);
+
+    return p_decoded;
+}
@@ -95,6 +95,42 @@ dvbpsi_descriptor_t * dvbpsi_GenNetworkNameDr(
                                         dvbpsi_network_name_dr_t * p_decoded,
                                         bool b_duplicate);
 
+/*****************************************************************************
+ * dvbpsi_network_name_compact_dr_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_network_name_compact_dr_s
+ * \brief Compact "network name" descriptor structure.
+ *
+ * Same fields as dvbpsi_network_name_dr_t, with the name sized to its
+ * length.
+ */
+/*!
+ * \typedef struct dvbpsi_network_name_compact_dr_s dvbpsi_network_name_compact_dr_t
+ * \brief dvbpsi_network_name_compact_dr_t type definition.
+ */
+typedef struct dvbpsi_network_name_compact_dr_s
+{
+  uint8_t      i_name_length;            /*!< length of the i_name_byte array */
+  uint8_t     *i_name_byte;              /*!< the name of the delivery system */
+
+} dvbpsi_network_name_compact_dr_t;
+
+
+/*****************************************************************************
+ * dvbpsi_DecodeNetworkNameCompactDr
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_network_name_compact_dr_t * dvbpsi_DecodeNetworkNameCompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor)
+ * \brief "network name" descriptor decoder giving the compact form.
+ * \param p_descriptor pointer to the descriptor structure
+ * \return a pointer to a new compact "network name" descriptor structure, or NULL.
+ * It is not attached to the descriptor and is released with free().
+ */
+dvbpsi_network_name_compact_dr_t * dvbpsi_DecodeNetworkNameCompactDr(dvbpsi_descriptor_t * p_descriptor);
+
+
 #ifdef __cplusplus
 };
 #endif
@@ -118,3 +118,39 @@ dvbpsi_descriptor_t * dvbpsi_GenServiceListDr(
 
     return p_descriptor;
 }
+
+/*****************************************************************************
+ * dvbpsi_DecodeServiceListCompactDr
+ *****************************************************************************/
+dvbpsi_service_list_compact_dr_t* dvbpsi_DecodeServiceListCompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor)
+{
+    /* Check the tag */
+    if (p_descriptor->i_tag != 0x41)
+        return NULL;
+
+    /* Check the length */
+    unsigned int service_count = p_descriptor->i_length / 3;
+    if ((p_descriptor->i_length < 1) ||
+        (p_descriptor->i_length % 3 != 0))
+      return NULL;
+
+    /* Allocate memory, the services follow the structure */
+    dvbpsi_service_list_compact_dr_t * p_decoded;
+    p_decoded = malloc(sizeof(dvbpsi_service_list_compact_dr_t)
+                       + service_count * sizeof(dvbpsi_service_list_entry_t));
+    if (!p_decoded)
+        return NULL;
+
+    /* Decode data */
+    p_decoded->i_service_count = service_count;
+    p_decoded->i_service = (dvbpsi_service_list_entry_t *)(p_decoded + 1);
+    for (uint8_t i = 0; i < p_decoded->i_service_count; i++ )
+    {
+        p_decoded->i_service[i].i_service_id = ((uint16_t)(p_descriptor->p_data[i*3]) << 8)
+                                             | p_descriptor->p_data[i*3+1];
+        p_decoded->i_service[i].i_service_type = p_descriptor->p_data[i*3+2];
+    }
+
+    return p_decoded;
+}
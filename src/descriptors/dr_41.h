@@ -39,7 +39,24 @@ extern "C" {
 #endif
 
 /*****************************************************************************
- * dvbpsi_network_name_dr_t
+ * dvbpsi_service_list_entry_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_service_list_entry_s
+ * \brief One service of a "service list" descriptor.
+ */
+/*!
+ * \typedef struct dvbpsi_service_list_entry_s dvbpsi_service_list_entry_t
+ * \brief dvbpsi_service_list_entry_t type definition.
+ */
+typedef struct dvbpsi_service_list_entry_s
+{
+  uint16_t     i_service_id;            /*!< service id */
+  uint8_t      i_service_type;          /*!< service type */
+} dvbpsi_service_list_entry_t;
+
+/*****************************************************************************
+ * dvbpsi_service_list_dr_t
  *****************************************************************************/
 /*!
  * \struct dvbpsi_service_list_dr_s
@@ -56,10 +73,7 @@ typedef struct dvbpsi_service_list_dr_s
 {
   uint8_t       i_service_count;            /*!< length of the i_service_list
   	                                             array */
-  struct {
-      uint16_t     i_service_id;            /*!< service id */
-      uint8_t      i_service_type;          /*!< service type */
-  } i_service[64];                          /*!< array of services */
+  dvbpsi_service_list_entry_t i_service[64]; /*!< array of services */
 
 } dvbpsi_service_list_dr_t;
 
@@ -95,6 +109,43 @@ dvbpsi_descriptor_t * dvbpsi_GenServiceListDr(
 		                        dvbpsi_service_list_dr_t * p_decoded,
                                         bool b_duplicate);
 
+/*****************************************************************************
+ * dvbpsi_service_list_compact_dr_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_service_list_compact_dr_s
+ * \brief Compact "service list" descriptor structure.
+ *
+ * Same fields as dvbpsi_service_list_dr_t, with the service array sized to
+ * the number of services of the descriptor, up to 85.
+ */
+/*!
+ * \typedef struct dvbpsi_service_list_compact_dr_s dvbpsi_service_list_compact_dr_t
+ * \brief dvbpsi_service_list_compact_dr_t type definition.
+ */
+typedef struct dvbpsi_service_list_compact_dr_s
+{
+  uint8_t                      i_service_count; /*!< length of the i_service
+                                                     array */
+  dvbpsi_service_list_entry_t *i_service;       /*!< array of services */
+
+} dvbpsi_service_list_compact_dr_t;
+
+
+/*****************************************************************************
+ * dvbpsi_DecodeServiceListCompactDr
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_service_list_compact_dr_t * dvbpsi_DecodeServiceListCompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor)
+ * \brief "service list" descriptor decoder giving the compact form.
+ * \param p_descriptor pointer to the descriptor structure
+ * \return a pointer to a new compact "service list" descriptor structure, or NULL.
+ * It is not attached to the descriptor and is released with free().
+ */
+dvbpsi_service_list_compact_dr_t * dvbpsi_DecodeServiceListCompactDr(dvbpsi_descriptor_t * p_descriptor);
+
+
 #ifdef __cplusplus
 };
 #endif
@@ -105,3 +105,30 @@ dvbpsi_descriptor_t * dvbpsi_GenBouquetNameDr(dvbpsi_bouquet_name_dr_t *p_decode
 
     return p_descriptor;
 }
+
+/*****************************************************************************
+ * dvbpsi_DecodeBouquetNameCompactDr
+ *****************************************************************************/
+dvbpsi_bouquet_name_compact_dr_t * dvbpsi_DecodeBouquetNameCompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor)
+{
+    /* Check the tag */
+    if (!dvbpsi_CanDecodeAsDescriptor(p_descriptor, 0x47))
+        return NULL;
+
+    /* Allocate memory, the name follows the structure */
+    dvbpsi_bouquet_name_compact_dr_t * p_decoded;
+    p_decoded = malloc(sizeof(dvbpsi_bouquet_name_compact_dr_t) + p_descriptor->i_length);
+    if (!p_decoded)
+        return NULL;
+
+    /* Decode data */
+    p_decoded->i_name_length = p_descriptor->i_length;
+    p_decoded->i_char = (uint8_t *)(p_decoded + 1);
+    if (p_decoded->i_name_length)
+        memcpy(p_decoded->i_char,
+               p_descriptor->p_data,
+               p_decoded->i_name_length);
+
+    return p_decoded;
+}
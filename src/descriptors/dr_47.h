@@ -95,6 +95,41 @@ dvbpsi_descriptor_t * dvbpsi_GenBouquetNameDr(
                                         dvbpsi_bouquet_name_dr_t * p_decoded,
                                         bool b_duplicate);
 
+/*****************************************************************************
+ * dvbpsi_bouquet_name_compact_dr_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_bouquet_name_compact_dr_s
+ * \brief Compact "bouquet name" descriptor structure.
+ *
+ * Same fields as dvbpsi_bouquet_name_dr_t, with the name sized to its
+ * length.
+ */
+/*!
+ * \typedef struct dvbpsi_bouquet_name_compact_dr_s dvbpsi_bouquet_name_compact_dr_t
+ * \brief dvbpsi_bouquet_name_compact_dr_t type definition.
+ */
+typedef struct dvbpsi_bouquet_name_compact_dr_s
+{
+  uint8_t      i_name_length;       /*!< length of the i_char array */
+  uint8_t     *i_char;              /*!< char */
+
+} dvbpsi_bouquet_name_compact_dr_t;
+
+
+/*****************************************************************************
+ * dvbpsi_DecodeBouquetNameCompactDr
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_bouquet_name_compact_dr_t * dvbpsi_DecodeBouquetNameCompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor)
+ * \brief "bouquet name" descriptor decoder giving the compact form.
+ * \param p_descriptor pointer to the descriptor structure
+ * \return a pointer to a new compact "bouquet name" descriptor structure, or NULL.
+ * It is not attached to the descriptor and is released with free().
+ */
+dvbpsi_bouquet_name_compact_dr_t * dvbpsi_DecodeBouquetNameCompactDr(dvbpsi_descriptor_t * p_descriptor);
+
 
 #ifdef __cplusplus
 };
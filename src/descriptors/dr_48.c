@@ -151,3 +151,50 @@ dvbpsi_descriptor_t * dvbpsi_GenServiceDr(dvbpsi_service_dr_t * p_decoded,
 
     return p_descriptor;
 }
+
+/*****************************************************************************
+ * dvbpsi_DecodeServiceCompactDr
+ *****************************************************************************/
+dvbpsi_service_compact_dr_t * dvbpsi_DecodeServiceCompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor)
+{
+    /* Check the tag */
+    if (!dvbpsi_CanDecodeAsDescriptor(p_descriptor, 0x48))
+        return NULL;
+
+    if (p_descriptor->i_length < 3)
+        return NULL;
+
+    /* Check which names fit in the descriptor */
+    const uint8_t *p_data = p_descriptor->p_data;
+    uint8_t i_provider_length = p_data[1];
+    uint8_t i_name_length = 0;
+    if (i_provider_length + 3 > p_descriptor->i_length)
+        i_provider_length = 0;
+    else
+    {
+        i_name_length = p_data[2 + i_provider_length];
+        if (i_provider_length + 3 + i_name_length > p_descriptor->i_length)
+            i_name_length = 0;
+    }
+
+    /* Allocate memory, the names follow the structure */
+    dvbpsi_service_compact_dr_t * p_decoded;
+    p_decoded = malloc(sizeof(dvbpsi_service_compact_dr_t)
+                       + i_provider_length + i_name_length);
+    if (!p_decoded)
+        return NULL;
+
+    p_decoded->i_service_type = p_data[0];
+    p_decoded->i_service_provider_name_length = i_provider_length;
+    p_decoded->i_service_provider_name = (uint8_t *)(p_decoded + 1);
+    p_decoded->i_service_name_length = i_name_length;
+    p_decoded->i_service_name = p_decoded->i_service_provider_name + i_provider_length;
+
+    if (i_provider_length)
+        memcpy(p_decoded->i_service_provider_name, p_data + 2, i_provider_length);
+    if (i_name_length)
+        memcpy(p_decoded->i_service_name, p_data + 3 + i_provider_length, i_name_length);
+
+    return p_decoded;
+}
@@ -100,6 +100,46 @@ dvbpsi_descriptor_t * dvbpsi_GenServiceDr(
                                         dvbpsi_service_dr_t * p_decoded,
                                         bool b_duplicate);
 
+/*****************************************************************************
+ * dvbpsi_service_compact_dr_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_service_compact_dr_s
+ * \brief Compact "service" descriptor structure.
+ *
+ * Same fields as dvbpsi_service_dr_t, with the names sized to their
+ * lengths. A name which does not fit in the descriptor is left empty.
+ */
+/*!
+ * \typedef struct dvbpsi_service_compact_dr_s dvbpsi_service_compact_dr_t
+ * \brief dvbpsi_service_compact_dr_t type definition.
+ */
+typedef struct dvbpsi_service_compact_dr_s
+{
+  uint8_t      i_service_type;              /*!< service_type*/
+  uint8_t      i_service_provider_name_length; /*!< length of the
+                                                i_service_provider_name array*/
+  uint8_t     *i_service_provider_name;     /*!< name of the service provider */
+  uint8_t      i_service_name_length;       /*!< length of the
+                                              i_service_name array*/
+  uint8_t     *i_service_name;              /*!< name of the service */
+
+} dvbpsi_service_compact_dr_t;
+
+
+/*****************************************************************************
+ * dvbpsi_DecodeServiceCompactDr
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_service_compact_dr_t * dvbpsi_DecodeServiceCompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor)
+ * \brief "service" descriptor decoder giving the compact form.
+ * \param p_descriptor pointer to the descriptor structure
+ * \return a pointer to a new compact "service" descriptor structure, or NULL.
+ * It is not attached to the descriptor and is released with free().
+ */
+dvbpsi_service_compact_dr_t * dvbpsi_DecodeServiceCompactDr(dvbpsi_descriptor_t * p_descriptor);
+
 
 #ifdef __cplusplus
 };
@@ -121,3 +121,40 @@ dvbpsi_descriptor_t * dvbpsi_GenCountryAvailabilityDr(
 
     return p_descriptor;
 }
+
+/*****************************************************************************
+ * dvbpsi_DecodeCountryAvailabilityCompactDr
+ *****************************************************************************/
+dvbpsi_country_availability_compact_dr_t* dvbpsi_DecodeCountryAvailabilityCompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor)
+{
+    /* Check the tag */
+    if (p_descriptor->i_tag != 0x49)
+        return NULL;
+
+    /* Check the length */
+    if ((p_descriptor->i_length < 1) ||
+        ((p_descriptor->i_length-1) % 3 != 0))
+        return NULL;
+
+    /* Allocate memory, the codes follow the structure */
+    const unsigned int code_count = (p_descriptor->i_length-1) / 3;
+    dvbpsi_country_availability_compact_dr_t * p_decoded;
+    p_decoded = malloc(sizeof(dvbpsi_country_availability_compact_dr_t)
+                       + code_count * sizeof(dvbpsi_country_code_t));
+    if (!p_decoded)
+        return NULL;
+
+    /* Decode data */
+    p_decoded->i_code_count = code_count;
+    p_decoded->b_country_availability_flag = p_descriptor->p_data[0] & 0x80;
+    p_decoded->code = (dvbpsi_country_code_t *)(p_decoded + 1);
+    for (uint8_t i = 0; i < p_decoded->i_code_count; i++)
+    {
+        p_decoded->code[i].iso_639_code[0] = p_descriptor->p_data[1+i*3];
+        p_decoded->code[i].iso_639_code[1] = p_descriptor->p_data[2+i*3];
+        p_decoded->code[i].iso_639_code[2] = p_descriptor->p_data[3+i*3];
+    }
+
+    return p_decoded;
+}
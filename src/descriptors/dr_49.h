@@ -38,6 +38,21 @@
 extern "C" {
 #endif
 
+/*****************************************************************************
+ * dvbpsi_country_code_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_country_code_s
+ * \brief One country of a "country availability" descriptor.
+ */
+/*!
+ * \typedef struct dvbpsi_country_code_s dvbpsi_country_code_t
+ * \brief dvbpsi_country_code_t type definition.
+ */
+typedef struct dvbpsi_country_code_s
+{
+  iso_639_language_code_t  iso_639_code;        /*!< ISO_639 language code */
+} dvbpsi_country_code_t;
 
 /*****************************************************************************
  * dvbpsi_country_availability_dr_t
@@ -62,9 +77,7 @@ typedef struct dvbpsi_country_availability_dr_s
   bool          b_country_availability_flag;    /*!< country availability flag */
   uint8_t       i_code_count;                   /*!< length of the i_iso_639_code
                                                 array */
-  struct {
-    iso_639_language_code_t  iso_639_code;      /*!< ISO_639 language code */
-  } code[84];                                   /*!< ISO_639_language_code array */
+  dvbpsi_country_code_t code[84];               /*!< ISO_639_language_code array */
 
 } dvbpsi_country_availability_dr_t;
 
@@ -100,6 +113,43 @@ dvbpsi_descriptor_t * dvbpsi_GenCountryAvailabilityDr(
 		                        dvbpsi_country_availability_dr_t * p_decoded,
                                         bool b_duplicate);
 
+/*****************************************************************************
+ * dvbpsi_country_availability_compact_dr_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_country_availability_compact_dr_s
+ * \brief Compact "country availability" descriptor structure.
+ *
+ * Same fields as dvbpsi_country_availability_dr_t, with the code array sized
+ * to the number of countries of the descriptor.
+ */
+/*!
+ * \typedef struct dvbpsi_country_availability_compact_dr_s dvbpsi_country_availability_compact_dr_t
+ * \brief dvbpsi_country_availability_compact_dr_t type definition.
+ */
+typedef struct dvbpsi_country_availability_compact_dr_s
+{
+  bool                   b_country_availability_flag; /*!< country availability flag */
+  uint8_t                i_code_count;          /*!< length of the code array */
+  dvbpsi_country_code_t *code;                  /*!< ISO_639_language_code array */
+
+} dvbpsi_country_availability_compact_dr_t;
+
+/*****************************************************************************
+ * dvbpsi_DecodeCountryAvailabilityCompactDr
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_country_availability_compact_dr_t * dvbpsi_DecodeCountryAvailabilityCompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor)
+ * \brief "country availability" descriptor decoder giving the compact form.
+ * \param p_descriptor pointer to the descriptor structure
+ * \return a pointer to a new compact "country availability" descriptor
+ * structure, or NULL. It is not attached to the descriptor and is released
+ * with free().
+ */
+dvbpsi_country_availability_compact_dr_t* dvbpsi_DecodeCountryAvailabilityCompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor);
+
 #ifdef __cplusplus
 };
 #endif
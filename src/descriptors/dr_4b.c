@@ -122,3 +122,43 @@ dvbpsi_descriptor_t * dvbpsi_GenNVODReferenceDr(dvbpsi_nvod_ref_dr_t * p_decoded
 
     return p_descriptor;
 }
+
+/*****************************************************************************
+ * dvbpsi_DecodeNVODReferenceCompactDr
+ *****************************************************************************/
+dvbpsi_nvod_ref_compact_dr_t* dvbpsi_DecodeNVODReferenceCompactDr(dvbpsi_descriptor_t * p_descriptor)
+{
+    /* Check the tag */
+    if (p_descriptor->i_tag != 0x4B)
+        return NULL;
+
+    /* Check the length */
+    if (p_descriptor->i_length < 6)
+        return NULL;
+    if (p_descriptor->i_length % 6!=0)
+        return NULL;
+
+    /* Allocate memory, the references follow the structure */
+    const int i_references = p_descriptor->i_length / 6;
+    dvbpsi_nvod_ref_compact_dr_t * p_decoded;
+    p_decoded = malloc(sizeof(dvbpsi_nvod_ref_compact_dr_t)
+                       + i_references * sizeof(dvbpsi_nvod_ref_t));
+    if (!p_decoded)
+        return NULL;
+
+    /* Decode data */
+    p_decoded->i_references = i_references;
+    p_decoded->p_nvod_refs = (dvbpsi_nvod_ref_t *)(p_decoded + 1);
+    for (int i = 0; i < i_references; i++)
+    {
+      int pos = i*6;
+      p_decoded->p_nvod_refs[i].i_transport_stream_id = p_descriptor->p_data[pos] << 8
+                                                      | p_descriptor->p_data[pos+1];
+      p_decoded->p_nvod_refs[i].i_original_network_id = p_descriptor->p_data[pos+2] << 8
+                                                      | p_descriptor->p_data[pos+3];
+      p_decoded->p_nvod_refs[i].i_service_id = p_descriptor->p_data[pos+4] << 8
+                                                      | p_descriptor->p_data[pos+5];
+    }
+
+    return p_decoded;
+}
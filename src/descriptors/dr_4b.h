@@ -110,6 +110,40 @@ dvbpsi_nvod_ref_dr_t* dvbpsi_DecodeNVODReferenceDr(dvbpsi_descriptor_t * p_descr
 dvbpsi_descriptor_t *dvbpsi_GenNVODReferenceDr(dvbpsi_nvod_ref_dr_t * p_decoded,
                                          bool b_duplicate);
 
+/*****************************************************************************
+ * dvbpsi_nvod_ref_compact_dr_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_nvod_ref_compact_dr_s
+ * \brief Compact "NVOD reference" descriptor structure.
+ *
+ * Same fields as dvbpsi_nvod_ref_dr_t, with the reference array sized to
+ * the number of references of the descriptor.
+ */
+/*!
+ * \typedef struct dvbpsi_nvod_ref_compact_dr_s dvbpsi_nvod_ref_compact_dr_t
+ * \brief dvbpsi_nvod_ref_compact_dr_t type definition.
+ */
+typedef struct dvbpsi_nvod_ref_compact_dr_s
+{
+  uint8_t               i_references;           /*!< number of nvod references */
+  dvbpsi_nvod_ref_t    *p_nvod_refs;            /*!< NVOD references */
+} dvbpsi_nvod_ref_compact_dr_t;
+
+/*****************************************************************************
+ * dvbpsi_DecodeNVODReferenceCompactDr
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_nvod_ref_compact_dr_t * dvbpsi_DecodeNVODReferenceCompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor)
+ * \brief "NVOD reference" descriptor decoder giving the compact form.
+ * \param p_descriptor pointer to the descriptor structure
+ * \return a pointer to a new compact "NVOD reference" descriptor structure, or NULL.
+ * It is not attached to the descriptor and is released with free().
+ */
+dvbpsi_nvod_ref_compact_dr_t * dvbpsi_DecodeNVODReferenceCompactDr(dvbpsi_descriptor_t * p_descriptor);
+
+
 #ifdef __cplusplus
 };
 #endif
@@ -121,3 +121,45 @@ dvbpsi_descriptor_t * dvbpsi_GenShortEventDr(dvbpsi_short_event_dr_t * p_decoded
 
     return p_descriptor;
 }
+
+/*****************************************************************************
+ * dvbpsi_DecodeShortEventCompactDr
+ *****************************************************************************/
+dvbpsi_short_event_compact_dr_t * dvbpsi_DecodeShortEventCompactDr(dvbpsi_descriptor_t * p_descriptor)
+{
+  dvbpsi_short_event_compact_dr_t * p_decoded;
+  int i_len1;
+  int i_len2;
+
+  /* Check the tag */
+  if (!dvbpsi_CanDecodeAsDescriptor(p_descriptor, 0x4d) ||
+      p_descriptor->i_length < 5 )
+    return NULL;
+
+  /* Check length */
+  i_len1 = p_descriptor->p_data[3];
+  if (p_descriptor->i_length < 5 + i_len1)
+    return NULL;
+  i_len2 = p_descriptor->p_data[4+i_len1];
+
+  if (p_descriptor->i_length < 5 + i_len1 + i_len2)
+    return NULL;
+
+  /* Allocate memory, the name and text follow the structure */
+  p_decoded = malloc(sizeof(dvbpsi_short_event_compact_dr_t) + i_len1 + i_len2);
+  if (!p_decoded)
+      return NULL;
+
+  /* Decode data */
+  memcpy( p_decoded->i_iso_639_code, &p_descriptor->p_data[0], 3 );
+  p_decoded->i_event_name_length = i_len1;
+  p_decoded->i_event_name = (uint8_t *)(p_decoded + 1);
+  if (i_len1 > 0)
+      memcpy( p_decoded->i_event_name, &p_descriptor->p_data[3+1], i_len1 );
+  p_decoded->i_text_length = i_len2;
+  p_decoded->i_text = p_decoded->i_event_name + i_len1;
+  if (i_len2 > 0)
+      memcpy( p_decoded->i_text, &p_descriptor->p_data[4+i_len1+1], i_len2 );
+
+  return p_decoded;
+}
@@ -93,6 +93,44 @@ dvbpsi_short_event_dr_t* dvbpsi_DecodeShortEventDr(dvbpsi_descriptor_t * p_descr
 dvbpsi_descriptor_t * dvbpsi_GenShortEventDr(dvbpsi_short_event_dr_t * p_decoded,
                                              bool b_duplicate);
 
+/*****************************************************************************
+ * dvbpsi_short_event_compact_dr_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_short_event_compact_dr_s
+ * \brief Compact "short event" descriptor structure.
+ *
+ * Same fields as dvbpsi_short_event_dr_t, with the event name and text
+ * sized to their lengths.
+ */
+/*!
+ * \typedef struct dvbpsi_short_event_compact_dr_s dvbpsi_short_event_compact_dr_t
+ * \brief dvbpsi_short_event_compact_dr_t type definition.
+ */
+typedef struct dvbpsi_short_event_compact_dr_s
+{
+  uint8_t  i_iso_639_code[3];   /*!< ISO 639 language code */
+  int      i_event_name_length; /*!< length of event name */
+  uint8_t *i_event_name;        /*!< "short event" name */
+  int      i_text_length;       /*!< text length */
+  uint8_t *i_text;              /*!< "short event" text */
+
+} dvbpsi_short_event_compact_dr_t;
+
+
+/*****************************************************************************
+ * dvbpsi_DecodeShortEventCompactDr
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_short_event_compact_dr_t * dvbpsi_DecodeShortEventCompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor)
+ * \brief "short event" descriptor decoder giving the compact form.
+ * \param p_descriptor pointer to the descriptor structure
+ * \return a pointer to a new compact "short event" descriptor structure, or NULL.
+ * It is not attached to the descriptor and is released with free().
+ */
+dvbpsi_short_event_compact_dr_t * dvbpsi_DecodeShortEventCompactDr(dvbpsi_descriptor_t * p_descriptor);
+
 
 #ifdef __cplusplus
 };
@@ -156,3 +156,81 @@ dvbpsi_descriptor_t * dvbpsi_GenExtendedEventDr(dvbpsi_extended_event_dr_t * p_d
 
     return p_descriptor;
 }
+
+/*****************************************************************************
+ * dvbpsi_DecodeExtendedEventCompactDr
+ *****************************************************************************/
+dvbpsi_extended_event_compact_dr_t * dvbpsi_DecodeExtendedEventCompactDr(dvbpsi_descriptor_t * p_descriptor)
+{
+    /* Check the tag */
+    if (!dvbpsi_CanDecodeAsDescriptor(p_descriptor, 0x4e) ||
+            p_descriptor->i_length < 6 )
+        return NULL;
+
+    const uint8_t *p_data = p_descriptor->p_data;
+    const int i_len = p_data[4];
+    if (6 + i_len > p_descriptor->i_length)
+        return NULL;
+
+    /* Count the items and check that they fit in the item loop */
+    int i_entry_count = 0;
+    const uint8_t *p = &p_data[5];
+    const uint8_t *p_end = &p_data[5+i_len];
+    while (p < p_end)
+    {
+        if (p + 1 + p[0] >= p_end)
+            return NULL;
+        p += 1 + p[0];
+        if (p + 1 + p[0] > p_end)
+            return NULL;
+        p += 1 + p[0];
+        i_entry_count++;
+    }
+
+    const int i_text_length = p_data[5+i_len];
+    if (6 + i_len + i_text_length > p_descriptor->i_length)
+        return NULL;
+
+    /* Allocate memory, the item arrays, the items and the text follow the
+     * structure */
+    dvbpsi_extended_event_compact_dr_t * p_decoded;
+    p_decoded = malloc(sizeof(dvbpsi_extended_event_compact_dr_t)
+                       + i_entry_count * (2 * sizeof(uint8_t *) + 2)
+                       + i_len - 2 * i_entry_count + i_text_length);
+    if (!p_decoded)
+        return NULL;
+
+    /* Decode */
+    p_decoded->i_descriptor_number = (p_data[0] >> 4)&0xf;
+    p_decoded->i_last_descriptor_number = p_data[0]&0x0f;
+    memcpy( &p_decoded->i_iso_639_code[0], &p_data[1], 3 );
+    p_decoded->i_entry_count = i_entry_count;
+    p_decoded->i_item_description = (uint8_t **)(p_decoded + 1);
+    p_decoded->i_item = p_decoded->i_item_description + i_entry_count;
+    p_decoded->i_item_description_length = (uint8_t *)(p_decoded->i_item + i_entry_count);
+    p_decoded->i_item_length = p_decoded->i_item_description_length + i_entry_count;
+
+    uint8_t *p_buffer = p_decoded->i_item_length + i_entry_count;
+    p = &p_data[5];
+    for (int i = 0; i < i_entry_count; i++)
+    {
+        p_decoded->i_item_description_length[i] = p[0];
+        p_decoded->i_item_description[i] = p_buffer;
+        memcpy( p_buffer, &p[1], p[0] );
+        p_buffer += p[0];
+        p += 1 + p[0];
+
+        p_decoded->i_item_length[i] = p[0];
+        p_decoded->i_item[i] = p_buffer;
+        memcpy( p_buffer, &p[1], p[0] );
+        p_buffer += p[0];
+        p += 1 + p[0];
+    }
+
+    p_decoded->i_text_length = i_text_length;
+    p_decoded->i_text = p_buffer;
+    if( i_text_length > 0 )
+        memcpy( p_buffer, &p_data[5+i_len+1], i_text_length );
+
+    return p_decoded;
+}
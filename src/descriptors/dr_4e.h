@@ -102,6 +102,51 @@ dvbpsi_extended_event_dr_t* dvbpsi_DecodeExtendedEventDr(dvbpsi_descriptor_t * p
 dvbpsi_descriptor_t * dvbpsi_GenExtendedEventDr(dvbpsi_extended_event_dr_t * p_decoded,
                                                 bool b_duplicate);
 
+/*****************************************************************************
+ * dvbpsi_extended_event_compact_dr_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_extended_event_compact_dr_s
+ * \brief Compact "extended event" descriptor structure.
+ *
+ * Same fields as dvbpsi_extended_event_dr_t, with the item arrays sized to
+ * the entry count and the items and text sized to their lengths.
+ */
+/*!
+ * \typedef struct dvbpsi_extended_event_compact_dr_s dvbpsi_extended_event_compact_dr_t
+ * \brief dvbpsi_extended_event_compact_dr_t type definition.
+ */
+typedef struct dvbpsi_extended_event_compact_dr_s
+{
+  uint8_t  i_descriptor_number;             /*!< descriptor number */
+  uint8_t  i_last_descriptor_number;        /*!< last descriptor number */
+
+  uint8_t  i_iso_639_code[3];               /*!< 3 letter ISO 639 language code */
+
+  int      i_entry_count;                   /*!< entry count */
+  uint8_t *i_item_description_length;       /*!< length of item_description */
+  uint8_t **i_item_description;             /*!< item description */
+  uint8_t *i_item_length;                   /*!< length of item */
+  uint8_t **i_item;                         /*!< items */
+
+  int      i_text_length;                   /*!< text length */
+  uint8_t *i_text;                          /*!< text */
+} dvbpsi_extended_event_compact_dr_t;
+
+
+/*****************************************************************************
+ * dvbpsi_DecodeExtendedEventCompactDr
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_extended_event_compact_dr_t * dvbpsi_DecodeExtendedEventCompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor)
+ * \brief "extended event" descriptor decoder giving the compact form.
+ * \param p_descriptor pointer to the descriptor structure
+ * \return a pointer to a new compact "extended event" descriptor structure, or NULL.
+ * It is not attached to the descriptor and is released with free().
+ */
+dvbpsi_extended_event_compact_dr_t * dvbpsi_DecodeExtendedEventCompactDr(dvbpsi_descriptor_t * p_descriptor);
+
 
 #ifdef __cplusplus
 };
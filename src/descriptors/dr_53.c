@@ -111,3 +111,34 @@ dvbpsi_descriptor_t * dvbpsi_GenCAIdentifierDr(dvbpsi_ca_identifier_dr_t *p_deco
 
     return p_descriptor;
 }
+
+/*****************************************************************************
+ * dvbpsi_DecodeCAIdentifierCompactDr
+ *****************************************************************************/
+dvbpsi_ca_identifier_compact_dr_t * dvbpsi_DecodeCAIdentifierCompactDr(dvbpsi_descriptor_t *p_descriptor)
+{
+    /* Check the tag */
+    if (!dvbpsi_CanDecodeAsDescriptor(p_descriptor, 0x53))
+        return NULL;
+
+    if (p_descriptor->i_length < 1)
+        return NULL;
+
+    /* Allocate memory, the identifiers follow the structure */
+    const int i_number = p_descriptor->i_length / 2;
+    dvbpsi_ca_identifier_compact_dr_t * p_decoded;
+    p_decoded = malloc(sizeof(dvbpsi_ca_identifier_compact_dr_t)
+                       + i_number * sizeof(dvbpsi_ca_system_t));
+    if (!p_decoded)
+        return NULL;
+
+    p_decoded->i_number = i_number;
+    p_decoded->p_system = (dvbpsi_ca_system_t *)(p_decoded + 1);
+    for (int i = 0; i < i_number; i++)
+    {
+        p_decoded->p_system[i].i_ca_system_id =  p_descriptor->p_data[2 * i] << 8;
+        p_decoded->p_system[i].i_ca_system_id |= p_descriptor->p_data[2 * i + 1];
+    }
+
+    return p_decoded;
+}
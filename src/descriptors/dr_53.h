@@ -116,6 +116,40 @@ dvbpsi_ca_identifier_dr_t* dvbpsi_DecodeCAIdentifierDr(dvbpsi_descriptor_t *p_de
 dvbpsi_descriptor_t *dvbpsi_GenCAIdentifierDr(dvbpsi_ca_identifier_dr_t *p_decoded,
                                               bool b_duplicate);
 
+/*****************************************************************************
+ * dvbpsi_ca_identifier_compact_dr_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_ca_identifier_compact_dr_s
+ * \brief Compact "CA identifier" descriptor structure.
+ *
+ * Same fields as dvbpsi_ca_identifier_dr_t, with the system array sized to
+ * the number of CA system identifiers of the descriptor.
+ */
+/*!
+ * \typedef struct dvbpsi_ca_identifier_compact_dr_s dvbpsi_ca_identifier_compact_dr_t
+ * \brief dvbpsi_ca_identifier_compact_dr_t type definition.
+ */
+typedef struct dvbpsi_ca_identifier_compact_dr_s
+{
+    uint8_t             i_number;               /*!< number of CA system identifiers */
+    dvbpsi_ca_system_t *p_system;               /*!< CA system identifiers */
+
+} dvbpsi_ca_identifier_compact_dr_t;
+
+/*****************************************************************************
+ * dvbpsi_DecodeCAIdentifierCompactDr
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_ca_identifier_compact_dr_t * dvbpsi_DecodeCAIdentifierCompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor)
+ * \brief "CA identifier" descriptor decoder giving the compact form.
+ * \param p_descriptor pointer to the descriptor structure
+ * \return a pointer to a new compact "CA identifier" descriptor structure, or NULL.
+ * It is not attached to the descriptor and is released with free().
+ */
+dvbpsi_ca_identifier_compact_dr_t * dvbpsi_DecodeCAIdentifierCompactDr(dvbpsi_descriptor_t * p_descriptor);
+
 
 #ifdef __cplusplus
 };
@@ -114,3 +114,36 @@ dvbpsi_descriptor_t * dvbpsi_GenContentDr(
 
     return p_descriptor;
 }
+
+/*****************************************************************************
+ * dvbpsi_DecodeContentCompactDr
+ *****************************************************************************/
+dvbpsi_content_compact_dr_t * dvbpsi_DecodeContentCompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor)
+{
+    /* Check the tag */
+    if (!dvbpsi_CanDecodeAsDescriptor(p_descriptor, 0x54))
+        return NULL;
+
+    /* Check the length */
+    if (p_descriptor->i_length % 2)
+        return NULL;
+
+    /* Allocate memory, the contents follow the structure */
+    const int i_contents_number = p_descriptor->i_length / 2;
+    dvbpsi_content_compact_dr_t * p_decoded;
+    p_decoded = malloc(sizeof(dvbpsi_content_compact_dr_t)
+                       + i_contents_number * sizeof(dvbpsi_content_t));
+    if (!p_decoded)
+        return NULL;
+
+    p_decoded->i_contents_number = i_contents_number;
+    p_decoded->p_content = (dvbpsi_content_t *)(p_decoded + 1);
+    for (int i = 0; i < i_contents_number; i++)
+    {
+        p_decoded->p_content[i].i_type = p_descriptor->p_data[2 * i];
+        p_decoded->p_content[i].i_user_byte = p_descriptor->p_data[2 * i + 1];
+    }
+
+    return p_decoded;
+}
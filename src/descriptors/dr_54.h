@@ -253,6 +253,42 @@ dvbpsi_descriptor_t * dvbpsi_GenContentDr(
                                         bool b_duplicate);
 
 
+/*****************************************************************************
+ * dvbpsi_content_compact_dr_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_content_compact_dr_s
+ * \brief Compact "content" descriptor structure.
+ *
+ * Same fields as dvbpsi_content_dr_t, with the content array sized to the
+ * number of contents of the descriptor, which may exceed
+ * DVBPSI_CONTENT_DR_MAX.
+ */
+/*!
+ * \typedef struct dvbpsi_content_compact_dr_s dvbpsi_content_compact_dr_t
+ * \brief dvbpsi_content_compact_dr_t type definition.
+ */
+typedef struct dvbpsi_content_compact_dr_s
+{
+  uint8_t           i_contents_number;  /*!< number of content */
+  dvbpsi_content_t *p_content;          /*!< content table */
+
+} dvbpsi_content_compact_dr_t;
+
+/*****************************************************************************
+ * dvbpsi_DecodeContentCompactDr
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_content_compact_dr_t * dvbpsi_DecodeContentCompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor)
+ * \brief "content" descriptor decoder giving the compact form.
+ * \param p_descriptor pointer to the descriptor structure
+ * \return a pointer to a new compact "content" descriptor structure, or NULL.
+ * It is not attached to the descriptor and is released with free().
+ */
+dvbpsi_content_compact_dr_t* dvbpsi_DecodeContentCompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor);
+
 #ifdef __cplusplus
 };
 #endif
@@ -133,3 +133,40 @@ dvbpsi_descriptor_t * dvbpsi_GenParentalRatingDr(
 
     return p_descriptor;
 }
+
+/*****************************************************************************
+ * dvbpsi_DecodeParentalRatingCompactDr
+ *****************************************************************************/
+dvbpsi_parental_rating_compact_dr_t * dvbpsi_DecodeParentalRatingCompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor)
+{
+    /* Check the tag */
+    if (!dvbpsi_CanDecodeAsDescriptor(p_descriptor, 0x55))
+        return NULL;
+
+    /* Check the length */
+    if (p_descriptor->i_length % 4)
+        return NULL;
+
+    /* Allocate memory, the ratings follow the structure */
+    const int i_ratings_number = p_descriptor->i_length / 4;
+    dvbpsi_parental_rating_compact_dr_t * p_decoded;
+    p_decoded = malloc(sizeof(dvbpsi_parental_rating_compact_dr_t)
+                       + i_ratings_number * sizeof(dvbpsi_parental_rating_t));
+    if (!p_decoded)
+        return NULL;
+
+    p_decoded->i_ratings_number = i_ratings_number;
+    p_decoded->p_parental_rating = (dvbpsi_parental_rating_t *)(p_decoded + 1);
+    for (int i = 0; i < i_ratings_number; i++)
+    {
+        p_decoded->p_parental_rating[i].i_country_code =
+                ((uint32_t)p_descriptor->p_data[4 * i] << 16)
+                | ((uint32_t)p_descriptor->p_data[4 * i + 1] << 8)
+                | p_descriptor->p_data[4 * i + 2];
+
+        p_decoded->p_parental_rating[i].i_rating = p_descriptor->p_data[4 * i + 3];
+    }
+
+    return p_decoded;
+}
@@ -121,6 +121,41 @@ dvbpsi_descriptor_t * dvbpsi_GenParentalRatingDr(
                                         bool b_duplicate);
 
 
+/*****************************************************************************
+ * dvbpsi_parental_rating_compact_dr_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_parental_rating_compact_dr_s
+ * \brief Compact "parental_rating" descriptor structure.
+ *
+ * Same fields as dvbpsi_parental_rating_dr_t, with the rating array sized
+ * to the number of ratings of the descriptor.
+ */
+/*!
+ * \typedef struct dvbpsi_parental_rating_compact_dr_s dvbpsi_parental_rating_compact_dr_t
+ * \brief dvbpsi_parental_rating_compact_dr_t type definition.
+ */
+typedef struct dvbpsi_parental_rating_compact_dr_s
+{
+  uint8_t                   i_ratings_number;   /*!< number of rating */
+  dvbpsi_parental_rating_t *p_parental_rating;  /*!< parental rating table */
+
+} dvbpsi_parental_rating_compact_dr_t;
+
+/*****************************************************************************
+ * dvbpsi_DecodeParentalRatingCompactDr
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_parental_rating_compact_dr_t * dvbpsi_DecodeParentalRatingCompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor)
+ * \brief "parental_rating" descriptor decoder giving the compact form.
+ * \param p_descriptor pointer to the descriptor structure
+ * \return a pointer to a new compact "parental_rating" descriptor structure,
+ * or NULL. It is not attached to the descriptor and is released with free().
+ */
+dvbpsi_parental_rating_compact_dr_t* dvbpsi_DecodeParentalRatingCompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor);
+
 #ifdef __cplusplus
 };
 #endif
@@ -102,3 +102,44 @@ uint32_t dvbpsi_Bcd8ToUint32(uint32_t bcd)
 
     return i_decoded;
 }
+
+/*****************************************************************************
+ * dvbpsi_DecodeFrequencyListCompactDr
+ *****************************************************************************/
+dvbpsi_frequency_list_compact_dr_t *dvbpsi_DecodeFrequencyListCompactDr(dvbpsi_descriptor_t *p_descriptor)
+{
+    dvbpsi_frequency_list_compact_dr_t *p_decoded;
+    int i;
+    /* Check the tag */
+    if (p_descriptor->i_tag != 0x62)
+        return NULL;
+
+    /* Check length */
+    if ((p_descriptor->i_length - 1) % 4)
+        return NULL;
+
+    /* Allocate memory, the frequencies follow the structure */
+    const int i_number = (p_descriptor->i_length - 1) / 4;
+    p_decoded = malloc(sizeof(dvbpsi_frequency_list_compact_dr_t) + i_number * sizeof(uint32_t));
+    if (!p_decoded)
+        return NULL;
+
+    p_decoded->i_number_of_frequencies = i_number;
+    p_decoded->p_center_frequencies = (uint32_t *)(p_decoded + 1);
+    p_decoded->i_coding_type = p_descriptor->p_data[0] & 0x3;
+
+    for (i = 0; i < i_number; i ++)
+    {
+        p_decoded->p_center_frequencies[i] = ((uint32_t)p_descriptor->p_data[(i * 4) + 1] << 24) |
+                                             (p_descriptor->p_data[(i * 4) + 2] << 16) |
+                                             (p_descriptor->p_data[(i * 4) + 3] <<  8) |
+                                              p_descriptor->p_data[(i * 4) + 4];
+
+        if ((p_decoded->i_coding_type == 1) || (p_decoded->i_coding_type == 2))
+        {
+            p_decoded->p_center_frequencies[i] = dvbpsi_Bcd8ToUint32(p_decoded->p_center_frequencies[i]);
+        }
+    }
+
+    return p_decoded;
+}
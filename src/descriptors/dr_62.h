@@ -78,6 +78,41 @@ dvbpsi_frequency_list_dr_t *dvbpsi_DecodeFrequencyListDr(dvbpsi_descriptor_t *p_
  */
 uint32_t dvbpsi_Bcd8ToUint32(uint32_t bcd);
 
+/*****************************************************************************
+ * dvbpsi_frequency_list_compact_dr_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_frequency_list_compact_dr_s
+ * \brief Compact Frequency List Descriptor
+ *
+ * Same fields as dvbpsi_frequency_list_dr_t, with the frequency array sized
+ * to the number of frequencies of the descriptor.
+ */
+/*!
+ * \typedef struct dvbpsi_frequency_list_compact_dr_s dvbpsi_frequency_list_compact_dr_t
+ * \brief dvbpsi_frequency_list_compact_dr_t type definition.
+ */
+typedef struct dvbpsi_frequency_list_compact_dr_s
+{
+    uint8_t i_coding_type;             /*!< Coding type, 1 = Satellite, 2 = Cable, 3 = Terrestrial */
+    uint8_t i_number_of_frequencies;   /*!< Number of center frequencies present */
+    uint32_t *p_center_frequencies;    /*!< Center frequency as defined by a delivery_system_descriptor */
+} dvbpsi_frequency_list_compact_dr_t;
+
+/*****************************************************************************
+ * dvbpsi_DecodeFrequencyListCompactDr
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_frequency_list_compact_dr_t * dvbpsi_DecodeFrequencyListCompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor)
+ * \brief Decode a Frequency List descriptor (tag 0x62) into the compact form.
+ * \param p_descriptor pointer to the descriptor structure
+ * \return a pointer to a new compact Frequency List descriptor structure, or NULL.
+ * It is not attached to the descriptor and is released with free().
+ */
+dvbpsi_frequency_list_compact_dr_t * dvbpsi_DecodeFrequencyListCompactDr(dvbpsi_descriptor_t * p_descriptor);
+
+
 #ifdef __cplusplus
 };
 #endif
@@ -117,3 +117,41 @@ dvbpsi_descriptor_t* dvbpsi_GenLCNDr(dvbpsi_lcn_dr_t* p_decoded,
     return p_descriptor;
 }
 
+/*****************************************************************************
+ * dvbpsi_DecodeLCNCompactDr
+ *****************************************************************************/
+dvbpsi_lcn_compact_dr_t *dvbpsi_DecodeLCNCompactDr(dvbpsi_descriptor_t *p_descriptor)
+{
+    dvbpsi_lcn_compact_dr_t *p_decoded;
+    int i;
+
+    /* Check the tag */
+    if (p_descriptor->i_tag != 0x83)
+        return NULL;
+
+    /* Check length */
+    if (p_descriptor->i_length % 4)
+        return NULL;
+
+    /* Allocate memory, the entries follow the structure */
+    const int i_number = p_descriptor->i_length / 4;
+    p_decoded = malloc(sizeof(dvbpsi_lcn_compact_dr_t) + i_number * sizeof(dvbpsi_lcn_entry_t));
+    if (!p_decoded)
+        return NULL;
+
+    p_decoded->i_number_of_entries = i_number;
+    p_decoded->p_entries = (dvbpsi_lcn_entry_t *)(p_decoded + 1);
+
+    for (i = 0; i < i_number; i ++)
+    {
+        p_decoded->p_entries[i].i_service_id = (p_descriptor->p_data[i * 4] << 8) |
+                                                p_descriptor->p_data[(i * 4) + 1];
+
+        p_decoded->p_entries[i].b_visible_service_flag = (p_descriptor->p_data[(i * 4) + 2] >> 7) & 1;
+
+        p_decoded->p_entries[i].i_logical_channel_number = ((p_descriptor->p_data[(i * 4) + 2] << 8) |
+                                                             p_descriptor->p_data[(i * 4) + 3]) & 0x3ff;
+    }
+
+    return p_decoded;
+}
@@ -100,6 +100,40 @@ dvbpsi_lcn_dr_t *dvbpsi_DecodeLCNDr(dvbpsi_descriptor_t *p_descriptor);
  */
 dvbpsi_descriptor_t* dvbpsi_GenLCNDr(dvbpsi_lcn_dr_t* p_decoded, bool b_duplicate);
 
+/*****************************************************************************
+ * dvbpsi_lcn_compact_dr_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_lcn_compact_dr_s
+ * \brief Compact Logical Channel Number Descriptor
+ *
+ * Same fields as dvbpsi_lcn_dr_t, with the entry array sized to the number
+ * of entries of the descriptor.
+ */
+/*!
+ * \typedef struct dvbpsi_lcn_compact_dr_s dvbpsi_lcn_compact_dr_t
+ * \brief dvbpsi_lcn_compact_dr_t type definition.
+ */
+typedef struct dvbpsi_lcn_compact_dr_s
+{
+    uint8_t i_number_of_entries;     /*!< Number of LCN entries present. */
+    dvbpsi_lcn_entry_t *p_entries;   /*!< Array of LCN entries. */
+} dvbpsi_lcn_compact_dr_t;
+
+/*****************************************************************************
+ * dvbpsi_DecodeLCNCompactDr
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_lcn_compact_dr_t * dvbpsi_DecodeLCNCompactDr(
+                                        dvbpsi_descriptor_t * p_descriptor)
+ * \brief Decode a Logical Channel Number descriptor (tag 0x83) into the compact form.
+ * \param p_descriptor pointer to the descriptor structure
+ * \return a pointer to a new compact Logical Channel Number descriptor structure, or NULL.
+ * It is not attached to the descriptor and is released with free().
+ */
+dvbpsi_lcn_compact_dr_t * dvbpsi_DecodeLCNCompactDr(dvbpsi_descriptor_t * p_descriptor);
+
+
 #ifdef __cplusplus
 };
 #endif
@@ -32,6 +32,7 @@
 #include <stdarg.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <time.h>
 
 #if defined(HAVE_INTTYPES_H)
 #include <inttypes.h>
@@ -39,11 +40,56 @@
 #include <stdint.h>
 #endif
 
+#if !defined(HAVE_CLOCK_GETTIME) && defined(HAVE_SYS_TIME_H)
+#include <sys/time.h>
+#endif
+
 #include <assert.h>
 
 #include "dvbpsi.h"
 #include "dvbpsi_private.h"
 #include "psi.h"
+#include "log.h"
+
+/*****************************************************************************
+ * dvbpsi_log_event
+ *****************************************************************************
+ * Record an event in the log ring of the handle, if any.
+ *****************************************************************************/
+static inline void dvbpsi_log_event(dvbpsi_t *p_dvbpsi, const dvbpsi_log_code_t i_code,
+                                    const uint16_t i_pid, const uint8_t i_table_id,
+                                    const uint32_t i_arg0, const uint32_t i_arg1)
+{
+#ifdef HAVE_ATOMIC_BUILTINS
+    if (p_dvbpsi->p_log_ring)
+        dvbpsi_log_ring_push(p_dvbpsi->p_log_ring, p_dvbpsi, i_code, i_pid,
+                             i_table_id, i_arg0, i_arg1);
+#else
+    (void)p_dvbpsi; (void)i_code; (void)i_pid; (void)i_table_id;
+    (void)i_arg0; (void)i_arg1;
+#endif
+}
+
+/*****************************************************************************
+ * dvbpsi_clock
+ *****************************************************************************
+ * Monotonic time in µs.
+ *****************************************************************************/
+int64_t dvbpsi_clock(void)
+{
+#if defined(HAVE_CLOCK_GETTIME)
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0)
+        return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+    return 0;
+#elif defined(HAVE_SYS_TIME_H)
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+#else
+    return (int64_t)time(NULL) * 1000000;
+#endif
+}
 
 /*****************************************************************************
  * dvbpsi_new
@@ -54,6 +100,13 @@ dvbpsi_t *dvbpsi_new(dvbpsi_message_cb callback, enum dvbpsi_msg_level level)
     if (p_dvbpsi == NULL)
         return NULL;
 
+    p_dvbpsi->p_pool = dvbpsi_section_pool_new();
+    if (p_dvbpsi->p_pool == NULL)
+    {
+        free(p_dvbpsi);
+        return NULL;
+    }
+
     p_dvbpsi->p_decoder  = NULL;
     p_dvbpsi->pf_message = callback;
     p_dvbpsi->i_msg_level = level;
@@ -68,6 +121,10 @@ void dvbpsi_delete(dvbpsi_t *p_dvbpsi)
     if (p_dvbpsi) {
         assert(p_dvbpsi->p_decoder == NULL);
         p_dvbpsi->pf_message = NULL;
+        dvbpsi_section_pool_release(p_dvbpsi->p_pool);
+        p_dvbpsi->p_pool = NULL;
+        dvbpsi_section_cache_enable(p_dvbpsi, 0);
+        dvbpsi_section_filter_clear(p_dvbpsi);
     }
     free(p_dvbpsi);
 }
@@ -111,10 +168,19 @@ void dvbpsi_decoder_reset(dvbpsi_decoder_t* p_decoder, const bool b_force)
     /* Force redecoding */
     if (b_force)
         p_decoder->b_current_valid = false;
+    else if (p_decoder->b_current_valid && p_decoder->p_sections)
+    {
+        /* Remember the table which has just been decoded */
+        p_decoder->i_current_table_id = p_decoder->p_sections->i_table_id;
+        p_decoder->i_current_extension = p_decoder->p_sections->i_extension;
+        p_decoder->i_current_version = p_decoder->p_sections->i_version;
+        p_decoder->b_current_next_indicator = p_decoder->p_sections->b_current_next;
+    }
 
     /* Clear the section array */
     dvbpsi_DeletePSISections(p_decoder->p_sections);
     p_decoder->p_sections = NULL;
+    memset(p_decoder->i_sections_received, 0, sizeof(p_decoder->i_sections_received));
 }
 
 /*****************************************************************************
@@ -124,43 +190,38 @@ bool dvbpsi_decoder_psi_sections_completed(dvbpsi_decoder_t* p_decoder)
 {
     assert(p_decoder);
 
-    bool b_complete = false;
-
-    dvbpsi_psi_section_t *p = p_decoder->p_sections;
-    unsigned int prev_nr = 0;
-    while (p)
+    /* All the sections from 0 to last_section_number */
+    const unsigned int i_last = p_decoder->i_last_section_number;
+    for (unsigned int i = 0; i <= i_last / 32; i++)
     {
-        assert(prev_nr < 256);
-        if (prev_nr != p->i_number)
-            break;
-        if (p_decoder->i_last_section_number == p->i_number)
-            b_complete = true;
-        p = p->p_next;
-        prev_nr++;
+        const uint32_t i_mask = (i < i_last / 32) ? 0xffffffff
+                                                  : 0xffffffff >> (31 - i_last % 32);
+        if ((p_decoder->i_sections_received[i] & i_mask) != i_mask)
+            return false;
     }
-
-    return b_complete;
+    return true;
 }
 
 /*****************************************************************************
- * dvbpsi_decoder_psi_section_add
+ * dvbpsi_psi_sections_insert
  *****************************************************************************/
-bool dvbpsi_decoder_psi_section_add(dvbpsi_decoder_t *p_decoder, dvbpsi_psi_section_t *p_section)
+bool dvbpsi_psi_sections_insert(dvbpsi_psi_section_t **pp_sections,
+                                dvbpsi_psi_section_t *p_section)
 {
-    assert(p_decoder);
+    assert(pp_sections);
     assert(p_section);
     assert(p_section->p_next == NULL);
 
     /* Empty list */
-    if (!p_decoder->p_sections)
+    if (!*pp_sections)
     {
-        p_decoder->p_sections = p_section;
+        *pp_sections = p_section;
         p_section->p_next = NULL;
         return false;
     }
 
     /* Insert in right place */
-    dvbpsi_psi_section_t *p = p_decoder->p_sections;
+    dvbpsi_psi_section_t *p = *pp_sections;
     dvbpsi_psi_section_t *p_prev = NULL;
     bool b_overwrite = false;
 
@@ -183,7 +244,7 @@ bool dvbpsi_decoder_psi_section_add(dvbpsi_decoder_t *p_decoder, dvbpsi_psi_sect
                 p->p_next = NULL;
                 dvbpsi_DeletePSISections(p);
                 p = p_section;
-                p_decoder->p_sections = p;
+                *pp_sections = p;
                 b_overwrite = true;
             }
             goto out;
@@ -199,7 +260,7 @@ bool dvbpsi_decoder_psi_section_add(dvbpsi_decoder_t *p_decoder, dvbpsi_psi_sect
             else
             {
                 p_section->p_next = p;
-                p_decoder->p_sections = p_section;
+                *pp_sections = p_section;
             }
             goto out;
         }
@@ -219,6 +280,140 @@ out:
     return b_overwrite;
 }
 
+/*****************************************************************************
+ * dvbpsi_decoder_sections_prev
+ *****************************************************************************
+ * Highest section number below i_number in p_sections, -1 if none.
+ *****************************************************************************/
+static int dvbpsi_decoder_sections_prev(const dvbpsi_decoder_t *p_decoder,
+                                        const unsigned int i_number)
+{
+    int i = i_number / 32;
+    uint32_t i_bits = p_decoder->i_sections_received[i]
+                    & (((uint32_t)1 << (i_number % 32)) - 1);
+    while (i_bits == 0)
+    {
+        if (--i < 0)
+            return -1;
+        i_bits = p_decoder->i_sections_received[i];
+    }
+    int i_bit = 31;
+    while (!(i_bits & ((uint32_t)1 << i_bit)))
+        i_bit--;
+    return i * 32 + i_bit;
+}
+
+/*****************************************************************************
+ * dvbpsi_decoder_sections_index
+ *****************************************************************************
+ * Make pp_sections_index large enough for section i_number, false on
+ * allocation failure.
+ *****************************************************************************/
+static bool dvbpsi_decoder_sections_index(dvbpsi_decoder_t *p_decoder,
+                                          const dvbpsi_psi_section_t *p_section)
+{
+    if (p_section->i_number < p_decoder->i_sections_index_size)
+        return true;
+
+    /* Usually sized once from last_section_number. The index of the sections
+     * already in the list is rebuilt, they may have been added without it. */
+    unsigned int i_size = 256;
+    if (p_decoder->p_sections == NULL && p_decoder->i_sections_index_size == 0)
+        i_size = 1 + (p_section->i_last_number > p_section->i_number
+                      ? p_section->i_last_number : p_section->i_number);
+
+    dvbpsi_psi_section_t **pp_index = realloc(p_decoder->pp_sections_index,
+                                              i_size * sizeof(dvbpsi_psi_section_t *));
+    if (pp_index == NULL)
+        return false;
+    p_decoder->pp_sections_index = pp_index;
+    p_decoder->i_sections_index_size = i_size;
+
+    for (dvbpsi_psi_section_t *p = p_decoder->p_sections; p; p = p->p_next)
+        pp_index[p->i_number] = p;
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_decoder_psi_section_add
+ *****************************************************************************/
+bool dvbpsi_decoder_psi_section_add(dvbpsi_decoder_t *p_decoder, dvbpsi_psi_section_t *p_section)
+{
+    assert(p_decoder);
+    assert(p_section);
+    assert(p_section->p_next == NULL);
+
+    const unsigned int i_number = p_section->i_number;
+    uint32_t *p_word = &p_decoder->i_sections_received[i_number / 32];
+    const uint32_t i_bit = (uint32_t)1 << (i_number % 32);
+
+    if (!dvbpsi_decoder_sections_index(p_decoder, p_section))
+    {
+        /* Out of memory, walk the list */
+        *p_word |= i_bit;
+        return dvbpsi_psi_sections_insert(&p_decoder->p_sections, p_section);
+    }
+
+    dvbpsi_psi_section_t **pp_index = p_decoder->pp_sections_index;
+    const int i_prev = dvbpsi_decoder_sections_prev(p_decoder, i_number);
+    dvbpsi_psi_section_t **pp_link = (i_prev < 0) ? &p_decoder->p_sections
+                                                  : &pp_index[i_prev]->p_next;
+    bool b_overwrite = false;
+
+    if (*p_word & i_bit)
+    {
+        /* Replace */
+        dvbpsi_psi_section_t *p_old = pp_index[i_number];
+        assert(*pp_link == p_old);
+        p_section->p_next = p_old->p_next;
+        p_old->p_next = NULL;
+        dvbpsi_DeletePSISections(p_old);
+        b_overwrite = true;
+    }
+    else
+        p_section->p_next = *pp_link;
+
+    *pp_link = p_section;
+    pp_index[i_number] = p_section;
+    *p_word |= i_bit;
+    return b_overwrite;
+}
+
+/*****************************************************************************
+ * dvbpsi_decoder_decode_on_arrival
+ *****************************************************************************/
+bool dvbpsi_decoder_decode_on_arrival(const dvbpsi_t *p_dvbpsi,
+                                      const dvbpsi_decoder_t *p_decoder)
+{
+    assert(p_dvbpsi);
+    assert(p_decoder);
+
+    /* Sections kept: the table was started without decoding on arrival */
+    if (p_decoder->p_sections)
+        return false;
+    for (unsigned int i = 0; i < ARRAY_SIZE(p_decoder->i_sections_received); i++)
+        if (p_decoder->i_sections_received[i])
+            return true;
+    return p_dvbpsi->b_decode_on_arrival;
+}
+
+/*****************************************************************************
+ * dvbpsi_decoder_psi_section_mark
+ *****************************************************************************/
+bool dvbpsi_decoder_psi_section_mark(dvbpsi_decoder_t *p_decoder,
+                                     const dvbpsi_psi_section_t *p_section)
+{
+    assert(p_decoder);
+    assert(p_section);
+    assert(p_decoder->p_sections == NULL);
+
+    uint32_t *p_word = &p_decoder->i_sections_received[p_section->i_number / 32];
+    const uint32_t i_bit = (uint32_t)1 << (p_section->i_number % 32);
+    const bool b_received = (*p_word & i_bit) != 0;
+    *p_word |= i_bit;
+    return b_received;
+}
+
 /*****************************************************************************
  * dvbpsi_decoder_delete
  *****************************************************************************/
@@ -231,6 +426,7 @@ void dvbpsi_decoder_delete(dvbpsi_decoder_t *p_decoder)
         dvbpsi_DeletePSISections(p_decoder->p_sections);
         p_decoder->p_sections = NULL;
     }
+    free(p_decoder->pp_sections_index);
 
     dvbpsi_DeletePSISections(p_decoder->p_current_section);
     free(p_decoder);
@@ -248,11 +444,256 @@ bool dvbpsi_decoder_present(dvbpsi_t *p_dvbpsi)
 }
 
 /*****************************************************************************
- * dvbpsi_packet_push
+ * dvbpsi_decoder_sections_own
+ *****************************************************************************/
+void dvbpsi_decoder_sections_own(dvbpsi_t *p_dvbpsi, dvbpsi_decoder_t *p_decoder)
+{
+    assert(p_decoder);
+
+    if (!dvbpsi_OwnPSISections(p_decoder->p_sections))
+    {
+        dvbpsi_error(p_dvbpsi, "PSI decoder", "failed to copy kept sections");
+        /* The table being built misses these sections: drop it and let
+         * the table decoder start over on its next section */
+        dvbpsi_decoder_reset(p_decoder, true);
+        p_decoder->b_discontinuity = true;
+    }
+}
+
+/*****************************************************************************
+ * dvbpsi_packet_section_new
  *****************************************************************************
- * Injection of a TS packet into a PSI decoder.
+ * Creation of a section for reassembly, taken from the pool of the handle
+ * if any. The section data is a view on p_data until the section gets a
+ * buffer of its own.
  *****************************************************************************/
-bool dvbpsi_packet_push(dvbpsi_t *p_dvbpsi, uint8_t* p_data)
+static dvbpsi_psi_section_t *dvbpsi_packet_section_new(dvbpsi_t *p_dvbpsi,
+                                                       uint8_t *p_data)
+{
+    dvbpsi_psi_section_t *p_section;
+
+    if (p_dvbpsi->p_pool)
+        p_section = dvbpsi_section_pool_get(p_dvbpsi->p_pool);
+    else
+        p_section = (dvbpsi_psi_section_t*)calloc(1, sizeof(dvbpsi_psi_section_t));
+    if (p_section == NULL)
+        return NULL;
+
+    p_section->p_data = p_data;
+    p_section->p_payload_end = p_data;
+    p_section->b_data_view = true;
+    p_section->p_next = NULL;
+
+    return p_section;
+}
+
+/*****************************************************************************
+ * dvbpsi_section_decoder_idle
+ *****************************************************************************
+ * Does the decoder of the section with syntax indicator starting at p_header
+ * hold a complete table with the same table_id and table_id_extension, and
+ * no table being built? Behind a demux this is the subtable decoder, or the
+ * range decoder of the table_id. *pi_version and *pb_current_next are then
+ * those of the table.
+ *****************************************************************************/
+static bool dvbpsi_section_decoder_idle(dvbpsi_t *p_dvbpsi, const uint8_t *p_header,
+                                        uint8_t *pi_version, bool *pb_current_next)
+{
+    dvbpsi_decoder_t *p_decoder = p_dvbpsi->p_decoder;
+    const uint8_t i_table_id = p_header[0];
+    const uint16_t i_extension = ((uint16_t)p_header[3] << 8) | p_header[4];
+
+    dvbpsi_decoder_t *p_subdec = dvbpsi_demux_decoder_find(p_decoder, i_table_id,
+                                                           i_extension);
+    if (p_subdec)
+        p_decoder = p_subdec;
+    else if (dvbpsi_demux_range_idle(p_decoder, i_table_id, i_extension,
+                                     pi_version, pb_current_next))
+        return true;
+
+    if (!p_decoder->b_current_valid || p_decoder->p_sections
+     || p_decoder->i_current_table_id != i_table_id
+     || p_decoder->i_current_extension != i_extension)
+        return false;
+
+    /* Sections decoded on arrival are only marked as received */
+    for (unsigned int i = 0; i < ARRAY_SIZE(p_decoder->i_sections_received); i++)
+        if (p_decoder->i_sections_received[i])
+            return false;
+
+    *pi_version = p_decoder->i_current_version;
+    *pb_current_next = p_decoder->b_current_next_indicator;
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_packet_section_known
+ *****************************************************************************
+ * Is the section starting at p_header, of which at least 8 bytes are
+ * available, a repetition of the current table of its decoder?
+ *****************************************************************************/
+static bool dvbpsi_packet_section_known(dvbpsi_t *p_dvbpsi, const uint8_t *p_header)
+{
+    /* Only sections with the syntax indicator have a version. After a
+     * discontinuity the table decoders start over. */
+    if (!(p_header[1] & 0x80) || p_dvbpsi->p_decoder->b_discontinuity)
+        return false;
+
+    /* The table decoders ignore such sections when no table is being built */
+    uint8_t i_version;
+    bool b_current_next;
+    return dvbpsi_section_decoder_idle(p_dvbpsi, p_header, &i_version, &b_current_next)
+        && i_version == ((p_header[5] & 0x3e) >> 1)
+        && b_current_next == (p_header[5] & 0x1);
+}
+
+/*****************************************************************************
+ * dvbpsi_packet_section_skip
+ *****************************************************************************
+ * Can a section whose first i_available bytes are in this TS packet be
+ * dropped before reassembly? Returns the counter of the reason, or NULL.
+ *****************************************************************************/
+static uint64_t *dvbpsi_packet_section_skip(dvbpsi_t *p_dvbpsi, const uint8_t *p_header,
+                                            const size_t i_available)
+{
+    if (p_dvbpsi->p_filters
+     && !dvbpsi_section_filters_match(p_dvbpsi->p_filters, p_header, i_available))
+        return &p_dvbpsi->counters.i_filtered;
+
+    /* The demux keys the sections without syntax indicator by table_id only */
+    const bool b_syntax = p_header[1] & 0x80;
+    if (i_available >= (b_syntax ? 5 : 3)
+     && dvbpsi_demux_section_ignored(p_dvbpsi->p_decoder, p_header[0],
+                                     b_syntax ? ((uint16_t)p_header[3] << 8) | p_header[4] : 0))
+        return &p_dvbpsi->counters.i_ignored;
+
+    if (i_available >= 8 && dvbpsi_packet_section_known(p_dvbpsi, p_header))
+        return &p_dvbpsi->counters.i_repeated;
+
+    return NULL;
+}
+
+/*****************************************************************************
+ * dvbpsi_packet_section_complete
+ *****************************************************************************
+ * Check a complete section and give it to the decoder.
+ *****************************************************************************/
+static void dvbpsi_packet_section_complete(dvbpsi_t *p_dvbpsi,
+                                           dvbpsi_decoder_t *p_decoder,
+                                           dvbpsi_psi_section_t *p_section,
+                                           const uint16_t i_pid)
+{
+    bool b_valid_crc32 = false;
+    bool has_crc32;
+    uint8_t i_current_version;
+    bool b_current_next;
+
+    p_section->i_table_id = p_section->p_data[0];
+    p_section->b_syntax_indicator = p_section->p_data[1] & 0x80;
+    p_section->b_private_indicator = p_section->p_data[1] & 0x40;
+
+    /* Update the end of the payload if CRC_32 is present */
+    has_crc32 = dvbpsi_has_CRC32(p_section);
+
+    p_dvbpsi->counters.i_bytes += 3 + p_section->i_length;
+
+    /* Sections the filters could not decide on in their first TS packet */
+    if (p_dvbpsi->p_filters
+     && !dvbpsi_section_filters_match(p_dvbpsi->p_filters, p_section->p_data,
+                                      3 + p_section->i_length))
+    {
+        p_dvbpsi->counters.i_filtered++;
+        dvbpsi_DeletePSISections(p_section);
+        p_decoder->p_current_section = NULL;
+        return;
+    }
+
+    /* Drop the sections identical to one already given to the decoder, as
+     * long as it has nothing to build: a decoder which was reset needs them.
+     * After a discontinuity the next section goes to the decoder, which
+     * starts over and clears the flag. The CRC_32 is not checked, a
+     * corrupted repetition with the CRC_32 of its entry counts as a hit. */
+    if (p_dvbpsi->p_section_cache && !p_decoder->b_discontinuity
+     && p_section->b_syntax_indicator && has_crc32
+     && dvbpsi_section_cache_lookup(p_dvbpsi->p_section_cache, p_section)
+     && dvbpsi_section_decoder_idle(p_dvbpsi, p_section->p_data,
+                                    &i_current_version, &b_current_next))
+    {
+        p_dvbpsi->counters.i_cache_hits++;
+        dvbpsi_DeletePSISections(p_section);
+        p_decoder->p_current_section = NULL;
+        return;
+    }
+
+    if (p_section->b_syntax_indicator || has_crc32)
+        p_section->p_payload_end -= 4;
+
+    /* Check CRC32 if present */
+    if (has_crc32)
+        b_valid_crc32 = dvbpsi_ValidPSISection(p_section);
+
+    if (!has_crc32 || b_valid_crc32)
+    {
+        /* PSI section is valid */
+        if (p_section->b_syntax_indicator)
+        {
+            p_section->i_extension =  (p_section->p_data[3] << 8)
+                                     | p_section->p_data[4];
+            p_section->i_version = (p_section->p_data[5] & 0x3e) >> 1;
+            p_section->b_current_next = p_section->p_data[5] & 0x1;
+            p_section->i_number = p_section->p_data[6];
+            p_section->i_last_number = p_section->p_data[7];
+            p_section->p_payload_start = p_section->p_data + 8;
+        }
+        else
+        {
+            p_section->i_extension = 0;
+            p_section->i_version = 0;
+            p_section->b_current_next = true;
+            p_section->i_number = 0;
+            p_section->i_last_number = 0;
+            p_section->p_payload_start = p_section->p_data + 3;
+        }
+        if (p_dvbpsi->p_section_cache && p_section->b_syntax_indicator && has_crc32)
+            dvbpsi_section_cache_add(p_dvbpsi->p_section_cache, p_section);
+
+        p_dvbpsi->counters.i_sections++;
+        p_decoder->p_current_section = NULL;
+        if (p_decoder->pf_gather)
+            p_decoder->pf_gather(p_dvbpsi, p_section);
+        else
+            dvbpsi_DeletePSISections(p_section);
+
+        /* The TS packet goes away when dvbpsi_packet_push() returns */
+        if (p_dvbpsi->b_zero_copy)
+            dvbpsi_decoder_sections_own(p_dvbpsi, p_decoder);
+    }
+    else
+    {
+        if (has_crc32 && !b_valid_crc32)
+        {
+            p_dvbpsi->counters.i_crc_errors++;
+            dvbpsi_log_event(p_dvbpsi, DVBPSI_LOG_CRC_ERROR, i_pid,
+                             p_section->p_data[0], 0, 0);
+            dvbpsi_error(p_dvbpsi, "misc PSI", "Bad CRC_32 table 0x%x !!!",
+                                   p_section->p_data[0]);
+        }
+        else
+            dvbpsi_error(p_dvbpsi, "misc PSI", "table 0x%x", p_section->p_data[0]);
+
+        /* PSI section isn't valid => trash it */
+        dvbpsi_DeletePSISections(p_section);
+        p_decoder->p_current_section = NULL;
+    }
+}
+
+/*****************************************************************************
+ * dvbpsi_packet_decode
+ *****************************************************************************
+ * Section reassembly for one TS packet, the sync byte has been checked by
+ * the caller.
+ *****************************************************************************/
+bool dvbpsi_packet_decode(dvbpsi_t *p_dvbpsi, uint8_t* p_data)
 {
     uint8_t i_expected_counter;           /* Expected continuity counter */
     dvbpsi_psi_section_t* p_section;      /* Current section */
@@ -262,17 +703,11 @@ bool dvbpsi_packet_push(dvbpsi_t *p_dvbpsi, uint8_t* p_data)
                                              section is handled */
     int i_available;                      /* Byte count available in the
                                              packet */
+    const uint16_t i_pid = ((uint16_t)(p_data[1] & 0x1f) << 8) | p_data[2];
 
     dvbpsi_decoder_t *p_decoder = p_dvbpsi->p_decoder;
     assert(p_decoder);
 
-    /* TS start code */
-    if (p_data[0] != 0x47)
-    {
-        dvbpsi_error(p_dvbpsi, "PSI decoder", "not a TS packet");
-        return false;
-    }
-
     /* Continuity check */
     bool b_first = (p_decoder->i_continuity_counter == DVBPSI_INVALID_CC);
     if (b_first)
@@ -285,19 +720,25 @@ bool dvbpsi_packet_push(dvbpsi_t *p_dvbpsi, uint8_t* p_data)
         if (i_expected_counter == ((p_decoder->i_continuity_counter + 1) & 0xf)
             && !p_decoder->b_discontinuity)
         {
+            p_dvbpsi->counters.i_duplicates++;
+            dvbpsi_log_event(p_dvbpsi, DVBPSI_LOG_DUPLICATE, i_pid, 0xff,
+                             p_decoder->i_continuity_counter, i_expected_counter);
             dvbpsi_error(p_dvbpsi, "PSI decoder",
                      "TS duplicate (received %d, expected %d) for PID %d",
                      p_decoder->i_continuity_counter, i_expected_counter,
-                     ((uint16_t)(p_data[1] & 0x1f) << 8) | p_data[2]);
+                     i_pid);
             return false;
         }
 
         if (i_expected_counter != p_decoder->i_continuity_counter)
         {
+            p_dvbpsi->counters.i_cc_errors++;
+            dvbpsi_log_event(p_dvbpsi, DVBPSI_LOG_CC_ERROR, i_pid, 0xff,
+                             p_decoder->i_continuity_counter, i_expected_counter);
             dvbpsi_error(p_dvbpsi, "PSI decoder",
                      "TS discontinuity (received %d, expected %d) for PID %d",
                      p_decoder->i_continuity_counter, i_expected_counter,
-                     ((uint16_t)(p_data[1] & 0x1f) << 8) | p_data[2]);
+                     i_pid);
             p_decoder->b_discontinuity = true;
             if (p_decoder->p_current_section)
             {
@@ -326,31 +767,19 @@ bool dvbpsi_packet_push(dvbpsi_t *p_dvbpsi, uint8_t* p_data)
 
     p_section = p_decoder->p_current_section;
 
-    /* If the psi decoder needs a beginning of a section and a new section
-       begins in the packet then initialize the dvbpsi_psi_section_t structure */
+    /* If the psi decoder needs a beginning of a section then go to the
+       new section of the packet */
     if (p_section == NULL)
     {
-        if (p_new_pos)
-        {
-            /* Allocation of the structure */
-            p_decoder->p_current_section
-                        = p_section
-                        = dvbpsi_NewPSISection(p_decoder->i_section_max_size);
-            if (!p_section)
-                return false;
-            /* Update the position in the packet */
-            p_payload_pos = p_new_pos;
-            /* New section is being handled */
-            p_new_pos = NULL;
-            /* Just need the header to know how long is the section */
-            p_decoder->i_need = 3;
-            p_decoder->b_complete_header = false;
-        }
-        else
+        if (p_new_pos == NULL)
         {
             /* No new section => return */
             return false;
         }
+        /* Update the position in the packet */
+        p_payload_pos = p_new_pos;
+        /* New section is being handled */
+        p_new_pos = NULL;
     }
 
     /* Remaining bytes in the payload */
@@ -358,7 +787,63 @@ bool dvbpsi_packet_push(dvbpsi_t *p_dvbpsi, uint8_t* p_data)
 
     while (i_available > 0)
     {
-        if (i_available >= p_decoder->i_need)
+        if (p_section == NULL)
+        {
+            /* A new section begins at p_payload_pos */
+            uint16_t i_length = 0;
+            if (i_available >= 3)
+                i_length = ((uint16_t)(p_payload_pos[1] & 0xf)) << 8
+                                | p_payload_pos[2];
+
+            uint64_t *pi_dropped = NULL;
+            if (i_available >= 3
+             && i_length <= p_decoder->i_section_max_size - 3)
+                pi_dropped = dvbpsi_packet_section_skip(p_dvbpsi, p_payload_pos,
+                                                        i_available);
+            if (pi_dropped)
+            {
+                /* Not wanted or repetition of the current table, skip it
+                   without copy nor CRC check. If it goes on in the next TS
+                   packets, these are ignored until a new section begins. */
+                (*pi_dropped)++;
+                if (i_length + 3 > i_available)
+                {
+                    i_available = 0;
+                    continue;
+                }
+                p_payload_pos += 3 + i_length;
+                i_available -= 3 + i_length;
+            }
+            else if (p_dvbpsi->b_zero_copy && i_available >= 3
+             && i_length <= p_decoder->i_section_max_size - 3
+             && i_length + 3 <= i_available)
+            {
+                /* The whole section is in this packet, don't copy it */
+                p_section = dvbpsi_packet_section_new(p_dvbpsi, p_payload_pos);
+                if (!p_section)
+                    return false;
+                p_section->i_length = i_length;
+                p_section->p_payload_end += 3 + i_length;
+                p_payload_pos += 3 + i_length;
+                i_available -= 3 + i_length;
+            }
+            else
+            {
+                /* Allocation of the structure, the data is allocated
+                   once the header tells how long the section is */
+                p_decoder->p_current_section
+                            = p_section
+                            = dvbpsi_packet_section_new(p_dvbpsi,
+                                                        p_decoder->i_header);
+                if (!p_section)
+                    return false;
+                /* Just need the header to know how long is the section */
+                p_decoder->i_need = 3;
+                p_decoder->b_complete_header = false;
+                continue;
+            }
+        }
+        else if (i_available >= p_decoder->i_need)
         {
             /* There are enough bytes in this packet to complete the
                header/section */
@@ -378,22 +863,18 @@ bool dvbpsi_packet_push(dvbpsi_t *p_dvbpsi, uint8_t* p_data)
                 /* Check that the section isn't too long */
                 if (p_decoder->i_need > p_decoder->i_section_max_size - 3)
                 {
+                    p_dvbpsi->counters.i_oversize++;
+                    dvbpsi_log_event(p_dvbpsi, DVBPSI_LOG_OVERSIZE, i_pid,
+                                     p_section->p_data[0], p_decoder->i_need, 0);
                     dvbpsi_error(p_dvbpsi, "PSI decoder", "PSI section too long");
                     dvbpsi_DeletePSISections(p_section);
-                    p_decoder->p_current_section = NULL;
+                    p_decoder->p_current_section = p_section = NULL;
                     /* If there is a new section not being handled then go forward
                        in the packet */
                     if (p_new_pos)
                     {
-                        p_decoder->p_current_section
-                                    = p_section
-                                    = dvbpsi_NewPSISection(p_decoder->i_section_max_size);
-                        if (!p_section)
-                            return false;
                         p_payload_pos = p_new_pos;
                         p_new_pos = NULL;
-                        p_decoder->i_need = 3;
-                        p_decoder->b_complete_header = false;
                         i_available = 188 + p_data - p_payload_pos;
                     }
                     else
@@ -401,90 +882,17 @@ bool dvbpsi_packet_push(dvbpsi_t *p_dvbpsi, uint8_t* p_data)
                         i_available = 0;
                     }
                 }
-            }
-            else
-            {
-                bool b_valid_crc32 = false;
-                bool has_crc32;
-
-                /* PSI section is complete */
-                p_section->i_table_id = p_section->p_data[0];
-                p_section->b_syntax_indicator = p_section->p_data[1] & 0x80;
-                p_section->b_private_indicator = p_section->p_data[1] & 0x40;
-
-                /* Update the end of the payload if CRC_32 is present */
-                has_crc32 = dvbpsi_has_CRC32(p_section);
-                if (p_section->b_syntax_indicator || has_crc32)
-                    p_section->p_payload_end -= 4;
-
-                /* Check CRC32 if present */
-                if (has_crc32)
-                    b_valid_crc32 = dvbpsi_ValidPSISection(p_section);
-
-                if (!has_crc32 || b_valid_crc32)
-                {
-                    /* PSI section is valid */
-                    if (p_section->b_syntax_indicator)
-                    {
-                        p_section->i_extension =  (p_section->p_data[3] << 8)
-                                                 | p_section->p_data[4];
-                        p_section->i_version = (p_section->p_data[5] & 0x3e) >> 1;
-                        p_section->b_current_next = p_section->p_data[5] & 0x1;
-                        p_section->i_number = p_section->p_data[6];
-                        p_section->i_last_number = p_section->p_data[7];
-                        p_section->p_payload_start = p_section->p_data + 8;
-                    }
-                    else
-                    {
-                        p_section->i_extension = 0;
-                        p_section->i_version = 0;
-                        p_section->b_current_next = true;
-                        p_section->i_number = 0;
-                        p_section->i_last_number = 0;
-                        p_section->p_payload_start = p_section->p_data + 3;
-                    }
-                    if (p_decoder->pf_gather)
-                        p_decoder->pf_gather(p_dvbpsi, p_section);
-                    p_decoder->p_current_section = NULL;
-                }
-                else
+                else if (!dvbpsi_section_data_alloc(p_section,
+                                                    3 + p_section->i_length, 3))
                 {
-                    if (has_crc32 && !dvbpsi_ValidPSISection(p_section))
-                        dvbpsi_error(p_dvbpsi, "misc PSI", "Bad CRC_32 table 0x%x !!!",
-                                               p_section->p_data[0]);
-                    else
-                        dvbpsi_error(p_dvbpsi, "misc PSI", "table 0x%x", p_section->p_data[0]);
-
-                    /* PSI section isn't valid => trash it */
+                    dvbpsi_error(p_dvbpsi, "PSI decoder", "out of memory");
+                    dvbpsi_log_event(p_dvbpsi, DVBPSI_LOG_OUT_OF_MEMORY, i_pid,
+                                     p_section->p_data[0], 0, 0);
                     dvbpsi_DeletePSISections(p_section);
                     p_decoder->p_current_section = NULL;
+                    return false;
                 }
-
-                /* A TS packet may contain any number of sections, only the first
-                 * new one is flagged by the pointer_field. If the next payload
-                 * byte isn't 0xff then a new section starts. */
-                if (p_new_pos == NULL && i_available && *p_payload_pos != 0xff)
-                    p_new_pos = p_payload_pos;
-
-                /* If there is a new section not being handled then go forward
-                   in the packet */
-                if (p_new_pos)
-                {
-                    p_decoder->p_current_section
-                              = p_section
-                              = dvbpsi_NewPSISection(p_decoder->i_section_max_size);
-                    if (!p_section)
-                        return false;
-                    p_payload_pos = p_new_pos;
-                    p_new_pos = NULL;
-                    p_decoder->i_need = 3;
-                    p_decoder->b_complete_header = false;
-                    i_available = 188 + p_data - p_payload_pos;
-                }
-                else
-                {
-                    i_available = 0;
-                }
+                continue;
             }
         }
         else
@@ -495,12 +903,179 @@ bool dvbpsi_packet_push(dvbpsi_t *p_dvbpsi, uint8_t* p_data)
             p_section->p_payload_end += i_available;
             p_decoder->i_need -= i_available;
             i_available = 0;
+            continue;
+        }
+
+        /* PSI section is complete */
+        if (p_section)
+        {
+            dvbpsi_packet_section_complete(p_dvbpsi, p_decoder, p_section, i_pid);
+            p_section = NULL;
+        }
+
+        /* A TS packet may contain any number of sections, only the first
+         * new one is flagged by the pointer_field. If the next payload
+         * byte isn't 0xff then a new section starts. */
+        if (p_new_pos == NULL && i_available && *p_payload_pos != 0xff)
+            p_new_pos = p_payload_pos;
+
+        /* If there is a new section not being handled then go forward
+           in the packet */
+        if (p_new_pos)
+        {
+            p_payload_pos = p_new_pos;
+            p_new_pos = NULL;
+            i_available = 188 + p_data - p_payload_pos;
+        }
+        else
+        {
+            i_available = 0;
         }
     }
     return true;
 }
 #undef DVBPSI_INVALID_CC
 
+/*****************************************************************************
+ * dvbpsi_packet_push
+ *****************************************************************************
+ * Injection of a TS packet into a PSI decoder.
+ *****************************************************************************/
+bool dvbpsi_packet_push(dvbpsi_t *p_dvbpsi, uint8_t* p_data)
+{
+    assert(p_dvbpsi->p_decoder);
+
+    /* TS start code */
+    if (p_data[0] != 0x47)
+    {
+        dvbpsi_error(p_dvbpsi, "PSI decoder", "not a TS packet");
+        return false;
+    }
+
+    return dvbpsi_packet_decode(p_dvbpsi, p_data);
+}
+
+/*****************************************************************************
+ * dvbpsi_packets_push
+ *****************************************************************************
+ * Injection of a buffer of TS packets into a PSI decoder.
+ *****************************************************************************/
+bool dvbpsi_packets_push(dvbpsi_t *p_dvbpsi, const uint16_t i_pid,
+                         uint8_t *p_data, const size_t i_packets,
+                         dvbpsi_packets_stats_t *p_stats)
+{
+    return dvbpsi_packets_push_stride(p_dvbpsi, i_pid, p_data, i_packets,
+                                      DVBPSI_STRIDE_TS, p_stats);
+}
+
+/*****************************************************************************
+ * dvbpsi_packets_push_stride
+ *****************************************************************************
+ * Injection of a buffer of 188, 192 or 204 bytes packets into a PSI decoder.
+ * The TS packets are decoded where they are, the TP_extra_header or the
+ * Reed-Solomon parity bytes are skipped.
+ *****************************************************************************/
+bool dvbpsi_packets_push_stride(dvbpsi_t *p_dvbpsi, const uint16_t i_pid,
+                                uint8_t *p_data, const size_t i_packets,
+                                const dvbpsi_packet_stride_t i_stride,
+                                dvbpsi_packets_stats_t *p_stats)
+{
+    dvbpsi_packets_stats_t stats = { 0, 0, 0, 0, 0, 0 };
+    const size_t i_offset = dvbpsi_packet_stride_offset(i_stride);
+
+    assert(p_dvbpsi);
+    assert(p_dvbpsi->p_decoder);
+    assert(i_stride == DVBPSI_STRIDE_TS || i_stride == DVBPSI_STRIDE_M2TS
+        || i_stride == DVBPSI_STRIDE_RS);
+
+    uint8_t *p_end = p_data + i_packets * i_stride;
+    for (uint8_t *p_packet = p_data; p_packet < p_end; p_packet += i_stride)
+    {
+        uint8_t *p = p_packet + i_offset;
+
+        stats.i_packets++;
+
+        /* TS start code */
+        if (p[0] != 0x47)
+        {
+            stats.i_sync_errors++;
+            continue;
+        }
+
+        if ((((uint16_t)(p[1] & 0x1f) << 8) | p[2]) != i_pid)
+        {
+            stats.i_skipped++;
+            continue;
+        }
+
+        if (i_stride == DVBPSI_STRIDE_M2TS)
+            p_dvbpsi->i_arrival_time = dvbpsi_m2ts_arrival_time(p_packet);
+
+        stats.i_pushed++;
+        if (dvbpsi_packet_decode(p_dvbpsi, p))
+            stats.i_handled++;
+    }
+
+    if (stats.i_sync_errors > 0)
+    {
+        dvbpsi_error(p_dvbpsi, "PSI decoder", "%u TS packets without sync byte",
+                     stats.i_sync_errors);
+        dvbpsi_log_event(p_dvbpsi, DVBPSI_LOG_SYNC_ERRORS, i_pid, 0xff,
+                         stats.i_sync_errors, 0);
+    }
+
+    if (p_stats)
+        *p_stats = stats;
+    return (stats.i_sync_errors == 0);
+}
+
+/*****************************************************************************
+ * dvbpsi_stream_push
+ *****************************************************************************
+ * Injection of a buffer of transport stream bytes into a PSI decoder.
+ *****************************************************************************/
+size_t dvbpsi_stream_push(dvbpsi_t *p_dvbpsi, const uint16_t i_pid,
+                          uint8_t *p_data, const size_t i_size,
+                          const dvbpsi_packet_stride_t i_stride,
+                          dvbpsi_packets_stats_t *p_stats)
+{
+    dvbpsi_packets_stats_t stats = { 0, 0, 0, 0, 0, 0 };
+    size_t i_pos = 0;
+
+    assert(p_dvbpsi);
+    assert(p_dvbpsi->p_decoder);
+
+    while (i_pos < i_size)
+    {
+        dvbpsi_packets_stats_t run;
+        size_t i_packets;
+
+        size_t i_lost = dvbpsi_packets_sync(p_data + i_pos, i_size - i_pos,
+                                            i_stride, &i_packets);
+        stats.i_lost_bytes += i_lost;
+        i_pos += i_lost;
+        if (i_packets == 0)
+            break;
+
+        dvbpsi_packets_push_stride(p_dvbpsi, i_pid, p_data + i_pos, i_packets,
+                                   i_stride, &run);
+        dvbpsi_packets_stats_add(&stats, &run);
+        i_pos += i_packets * i_stride;
+    }
+
+    if (stats.i_lost_bytes > 0)
+    {
+        dvbpsi_warning(p_dvbpsi, "PSI decoder", "lost %u bytes out of %zu",
+                       stats.i_lost_bytes, i_size);
+        dvbpsi_log_event(p_dvbpsi, DVBPSI_LOG_LOST_BYTES, i_pid, 0xff,
+                         stats.i_lost_bytes, i_size);
+    }
+
+    if (p_stats)
+        *p_stats = stats;
+    return i_pos;
+}
+
 /*****************************************************************************
  * Message error level:
  * -1 is disabled,
@@ -517,8 +1092,7 @@ bool dvbpsi_packet_push(dvbpsi_t *p_dvbpsi, uint8_t* p_data)
 #ifdef HAVE_VARIADIC_MACROS
 void dvbpsi_message(dvbpsi_t *dvbpsi, const dvbpsi_msg_level_t level, const char *fmt, ...)
 {
-    if ((dvbpsi->i_msg_level > DVBPSI_MSG_NONE) &&
-        (level <= dvbpsi->i_msg_level))
+    if (dvbpsi_message_enabled(dvbpsi, level))
     {
         va_list ap;
         va_start(ap, fmt);
@@ -534,10 +1108,8 @@ void dvbpsi_message(dvbpsi_t *dvbpsi, const dvbpsi_msg_level_t level, const char
         int err = vsnprintf(msg, DVBPSI_MSG_SIZE, DVBPSI_MSG_FORMAT fmt, ap);
 #endif
         va_end(ap);
-        if (err > 0) {
-            if (dvbpsi->pf_message)
-                dvbpsi->pf_message(dvbpsi, level, msg);
-        }
+        if (err > 0)
+            dvbpsi->pf_message(dvbpsi, level, msg);
         free(msg);
     }
 }
@@ -601,8 +1173,7 @@ void dvbpsi_message(dvbpsi_t *dvbpsi, const dvbpsi_msg_level_t level, const char
 
 void dvbpsi_error(dvbpsi_t *dvbpsi, const char *src, const char *fmt, ...)
 {
-    if ((dvbpsi->i_msg_level > DVBPSI_MSG_NONE) &&
-        (DVBPSI_MSG_ERROR <= dvbpsi->i_msg_level))
+    if (dvbpsi_message_enabled(dvbpsi, DVBPSI_MSG_ERROR))
     {
         DVBPSI_MSG_COMMON(DVBPSI_MSG_ERROR)
     }
@@ -610,8 +1181,7 @@ void dvbpsi_error(dvbpsi_t *dvbpsi, const char *src, const char *fmt, ...)
 
 void dvbpsi_warning(dvbpsi_t *dvbpsi, const char *src, const char *fmt, ...)
 {
-    if ((dvbpsi->i_msg_level > DVBPSI_MSG_NONE) &&
-        (DVBPSI_MSG_WARN <= dvbpsi->i_msg_level))
+    if (dvbpsi_message_enabled(dvbpsi, DVBPSI_MSG_WARN))
     {
         DVBPSI_MSG_COMMON(DVBPSI_MSG_WARN)
     }
@@ -619,8 +1189,7 @@ void dvbpsi_warning(dvbpsi_t *dvbpsi, const char *src, const char *fmt, ...)
 
 void dvbpsi_debug(dvbpsi_t *dvbpsi, const char *src, const char *fmt, ...)
 {
-    if ((dvbpsi->i_msg_level > DVBPSI_MSG_NONE) &&
-        (DVBPSI_MSG_DEBUG <= dvbpsi->i_msg_level))
+    if (dvbpsi_message_enabled(dvbpsi, DVBPSI_MSG_DEBUG))
     {
         DVBPSI_MSG_COMMON(DVBPSI_MSG_DEBUG)
     }
@@ -56,6 +56,40 @@ extern "C" {
 # define DVBPSI_GCC_VERSION(maj,min) (0)
 #endif
 
+/*****************************************************************************
+ * dvbpsi_counters_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_counters_s
+ * \brief Events counted by a dvbpsi_t handle during section reassembly.
+ *
+ * The counters are updated whatever the log level and never reset by
+ * libdvbpsi, the application may read or clear dvbpsi_t::counters at any
+ * time between two push calls.
+ */
+/*!
+ * \typedef struct dvbpsi_counters_s dvbpsi_counters_t
+ * \brief dvbpsi_counters_t type definition.
+ */
+typedef struct dvbpsi_counters_s
+{
+    uint64_t    i_cc_errors;    /*!< TS discontinuities */
+    uint64_t    i_duplicates;   /*!< duplicate TS packets */
+    uint64_t    i_crc_errors;   /*!< sections with a bad CRC_32 */
+    uint64_t    i_oversize;     /*!< sections longer than the decoder maximum */
+    uint64_t    i_repeated;     /*!< repeated sections dropped before
+                                     reassembly by their version */
+    uint64_t    i_cache_hits;   /*!< repeated sections dropped by the
+                                     section cache, their CRC_32 is not
+                                     checked */
+    uint64_t    i_filtered;     /*!< sections dropped by the section
+                                     filters */
+    uint64_t    i_ignored;      /*!< sections of subtables ignored by the
+                                     demux */
+    uint64_t    i_sections;     /*!< sections given to the decoder */
+    uint64_t    i_bytes;        /*!< bytes of complete sections */
+} dvbpsi_counters_t;
+
 /*****************************************************************************
  * dvbpsi_t
  *****************************************************************************/
@@ -134,6 +168,34 @@ typedef struct dvbpsi_decoder_s dvbpsi_decoder_t;
  *
  * This structure provides a handle to libdvbpsi API and should be used instead
  * of dvbpsi_decoder_t.
+ *
+ * When dvbpsi_s::b_zero_copy is set, a section which is completely contained
+ * in one TS packet is given to the decoder without copying it:
+ * dvbpsi_psi_section_t::p_data points into the TS packet. The TS packet
+ * buffer must stay unchanged until dvbpsi_packet_push() returns. Sections
+ * kept by a decoder in dvbpsi_decoder_t::p_sections are copied before
+ * dvbpsi_packet_push() returns, other decoders must call
+ * dvbpsi_OwnPSISections() on the sections they keep.
+ *
+ * When dvbpsi_s::b_decode_on_arrival is set, the EIT, NIT, BAT, SDT and
+ * ATSC VCT decoders decode each section into the table being built as soon
+ * as it arrives and free it, instead of keeping all the sections until the
+ * table is complete. Only the section numbers received are remembered. The
+ * entries of the table are then in the order the sections arrived in, not
+ * in section_number order. A table already being built when the flag
+ * changes is finished in the mode it was started in.
+ *
+ * When dvbpsi_s::b_arena_tables is set, the PMT, SDT, EIT, NIT, BAT and
+ * ATSC VCT decoders build each table in a few large blocks of memory owned
+ * by the table instead of allocating each element and descriptor: the
+ * table delete function releases them at once. The lists of such a table
+ * must only be changed with the functions of the table, not freed directly.
+ *
+ * When dvbpsi_s::b_zero_copy_descriptors is set too, such a table also
+ * keeps the data of the sections it was decoded from and the
+ * dvbpsi_descriptor_t::p_data of its descriptors point into it instead of
+ * being copied one by one. The section buffers are taken over by the table,
+ * sections whose data is a view are copied once.
  */
 /*!
  * \typedef struct dvbpsi_s dvbpsi_t
@@ -147,6 +209,36 @@ struct dvbpsi_s
     dvbpsi_message_cb             pf_message;           /*!< Log message callback */
     enum dvbpsi_msg_level         i_msg_level;          /*!< Log level */
 
+    /* Section assembly */
+    bool                          b_zero_copy;          /*!< Sections contained
+                                                          in one TS packet are not
+                                                          copied, false by default */
+    bool                          b_decode_on_arrival;  /*!< Sections of multi
+                                                          section tables are decoded
+                                                          when they arrive, false by
+                                                          default */
+    bool                          b_arena_tables;       /*!< Decoded tables are
+                                                          allocated in one arena,
+                                                          false by default */
+    bool                          b_zero_copy_descriptors; /*!< Descriptors of
+                                                          arena tables point into
+                                                          the sections kept by the
+                                                          table, false by default */
+    struct dvbpsi_section_pool_s *p_pool;               /*!< private: recycled
+                                                          sections */
+    struct dvbpsi_section_cache_s *p_section_cache;     /*!< private: see
+                                                          dvbpsi_section_cache_enable() */
+    struct dvbpsi_section_filters_s *p_filters;         /*!< private: see
+                                                          dvbpsi_section_filter_add() */
+    dvbpsi_counters_t             counters;             /*!< reassembly events */
+    struct dvbpsi_log_ring_s     *p_log_ring;           /*!< ring receiving the
+                                                          reassembly events, see
+                                                          log.h, NULL by default */
+    uint32_t                      i_arrival_time;       /*!< arrival_time_stamp
+                                                          of the last TS packet
+                                                          pushed with
+                                                          DVBPSI_STRIDE_M2TS */
+
     /* private data pointer for use by caller, not by libdvbpsi itself ! */
     void                         *p_sys;                /*!< pointer to private data
                                                           from caller. Do not use
@@ -198,6 +290,256 @@ void dvbpsi_delete(dvbpsi_t *p_dvbpsi);
  */
 bool dvbpsi_packet_push(dvbpsi_t *p_dvbpsi, uint8_t* p_data);
 
+/*****************************************************************************
+ * dvbpsi_packets_stats_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_packets_stats_s
+ * \brief Counters for one call to dvbpsi_packets_push().
+ *
+ * The counters are reset at the start of each dvbpsi_packets_push() call.
+ */
+/*!
+ * \typedef struct dvbpsi_packets_stats_s dvbpsi_packets_stats_t
+ * \brief dvbpsi_packets_stats_t type definition.
+ */
+typedef struct dvbpsi_packets_stats_s
+{
+    unsigned int    i_packets;      /*!< TS packets examined */
+    unsigned int    i_pushed;       /*!< TS packets passed to a decoder */
+    unsigned int    i_handled;      /*!< pushed TS packets that were handled */
+    unsigned int    i_skipped;      /*!< TS packets of PIDs without decoder */
+    unsigned int    i_sync_errors;  /*!< TS packets without 0x47 sync byte */
+    unsigned int    i_lost_bytes;   /*!< bytes skipped to find the sync byte */
+} dvbpsi_packets_stats_t;
+
+/*****************************************************************************
+ * dvbpsi_packet_stride_t
+ *****************************************************************************/
+/*!
+ * \enum dvbpsi_packet_stride
+ * \brief Size and layout of the packets of a buffer of TS packets
+ */
+enum dvbpsi_packet_stride
+{
+    DVBPSI_STRIDE_TS   = 188, /*!< TS packets */
+    DVBPSI_STRIDE_M2TS = 192, /*!< TS packets after a 4 bytes TP_extra_header
+                                   (BDAV MPEG-2 transport stream, M2TS) */
+    DVBPSI_STRIDE_RS   = 204, /*!< TS packets followed by 16 bytes of
+                                   Reed-Solomon parity */
+};
+/*!
+ * \typedef enum dvbpsi_packet_stride dvbpsi_packet_stride_t
+ * \brief dvbpsi_packet_stride_t type definition.
+ */
+typedef enum dvbpsi_packet_stride dvbpsi_packet_stride_t;
+
+/*****************************************************************************
+ * dvbpsi_packets_push
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_packets_push(dvbpsi_t *p_dvbpsi, const uint16_t i_pid,
+                                uint8_t *p_data, const size_t i_packets,
+                                dvbpsi_packets_stats_t *p_stats)
+ * \brief Injection of a buffer of contiguous TS packets into a PSI decoder.
+ * \param p_dvbpsi handle to dvbpsi with attached decoder
+ * \param i_pid only TS packets with this PID are given to the decoder
+ * \param p_data pointer to i_packets * 188 bytes of TS packets
+ * \param i_packets number of TS packets in p_data
+ * \param p_stats pointer to counters for this call, may be NULL
+ * \return true when all packets have been examined, false when a packet
+ * without sync byte was found.
+ *
+ * Walks the buffer once and behaves as if dvbpsi_packet_push() was called for
+ * each TS packet carrying i_pid. Packets without sync byte are skipped.
+ */
+bool dvbpsi_packets_push(dvbpsi_t *p_dvbpsi, const uint16_t i_pid,
+                         uint8_t *p_data, const size_t i_packets,
+                         dvbpsi_packets_stats_t *p_stats);
+
+/*****************************************************************************
+ * dvbpsi_packets_push_stride
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_packets_push_stride(dvbpsi_t *p_dvbpsi, const uint16_t i_pid,
+                                       uint8_t *p_data, const size_t i_packets,
+                                       const dvbpsi_packet_stride_t i_stride,
+                                       dvbpsi_packets_stats_t *p_stats)
+ * \brief Injection of a buffer of contiguous 188, 192 or 204 bytes packets
+ * into a PSI decoder.
+ * \param p_dvbpsi handle to dvbpsi with attached decoder
+ * \param i_pid only TS packets with this PID are given to the decoder
+ * \param p_data pointer to i_packets * i_stride bytes of packets
+ * \param i_packets number of packets in p_data
+ * \param i_stride size and layout of the packets
+ * \param p_stats pointer to counters for this call, may be NULL
+ * \return true when all packets have been examined, false when a packet
+ * without sync byte was found.
+ *
+ * Same as dvbpsi_packets_push(), the TS packets are decoded in place. With
+ * DVBPSI_STRIDE_M2TS, dvbpsi_t::i_arrival_time holds the 30 bits
+ * arrival_time_stamp of the TS packet being decoded, it can be read from
+ * the table callbacks.
+ */
+bool dvbpsi_packets_push_stride(dvbpsi_t *p_dvbpsi, const uint16_t i_pid,
+                                uint8_t *p_data, const size_t i_packets,
+                                const dvbpsi_packet_stride_t i_stride,
+                                dvbpsi_packets_stats_t *p_stats);
+
+/*****************************************************************************
+ * dvbpsi_packets_sync
+ *****************************************************************************/
+/*!
+ * \fn size_t dvbpsi_packets_sync(const uint8_t *p_data, const size_t i_size,
+                                  const dvbpsi_packet_stride_t i_stride,
+                                  size_t *pi_packets)
+ * \brief Find the packets in a buffer of transport stream bytes.
+ * \param p_data pointer to the buffer
+ * \param i_size size of the buffer in bytes
+ * \param i_stride size and layout of the packets
+ * \param pi_packets pointer to the number of complete packets in a row found
+ * at the returned offset, 0 if none
+ * \return offset of the first packet. When *pi_packets is 0, the bytes before
+ * the offset hold no packet and the bytes after it must be given again
+ * with the following bytes of the stream.
+ *
+ * The synchronisation is acquired on 3 sync bytes in a row at i_stride, so
+ * the last packet starts of the buffer are only checked once it is given
+ * again with the following bytes. The packets found stop at the first
+ * packet without sync byte.
+ */
+size_t dvbpsi_packets_sync(const uint8_t *p_data, const size_t i_size,
+                           const dvbpsi_packet_stride_t i_stride, size_t *pi_packets);
+
+/*****************************************************************************
+ * dvbpsi_stream_push
+ *****************************************************************************/
+/*!
+ * \fn size_t dvbpsi_stream_push(dvbpsi_t *p_dvbpsi, const uint16_t i_pid,
+                                 uint8_t *p_data, const size_t i_size,
+                                 const dvbpsi_packet_stride_t i_stride,
+                                 dvbpsi_packets_stats_t *p_stats)
+ * \brief Injection of a buffer of transport stream bytes into a PSI decoder.
+ * \param p_dvbpsi handle to dvbpsi with attached decoder
+ * \param i_pid only TS packets with this PID are given to the decoder
+ * \param p_data pointer to the buffer, it does not need to start at a packet
+ * \param i_size size of the buffer in bytes
+ * \param i_stride size and layout of the packets
+ * \param p_stats pointer to counters for this call, may be NULL
+ * \return number of bytes used. The remaining bytes, less than a few
+ * packets, must be given again with the following bytes of the stream.
+ *
+ * Finds the packets with dvbpsi_packets_sync(), resynchronising after each
+ * packet without sync byte, and gives them to dvbpsi_packets_push_stride().
+ * The skipped bytes are counted in dvbpsi_packets_stats_t::i_lost_bytes.
+ */
+size_t dvbpsi_stream_push(dvbpsi_t *p_dvbpsi, const uint16_t i_pid,
+                          uint8_t *p_data, const size_t i_size,
+                          const dvbpsi_packet_stride_t i_stride,
+                          dvbpsi_packets_stats_t *p_stats);
+
+/*****************************************************************************
+ * dvbpsi_section_cache_enable
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_section_cache_enable(dvbpsi_t *p_dvbpsi,
+                                        const unsigned int i_entries)
+ * \brief Enable or disable the section cache of a handle.
+ * \param p_dvbpsi handle to dvbpsi
+ * \param i_entries number of sections remembered, rounded up to a power of
+ * two and at most 2^20. 0 disables the cache.
+ * \return true on success, false on failure. The cache is disabled on
+ * failure.
+ *
+ * The cache remembers the section_length and CRC_32 of the last valid section
+ * received for each (table_id, table_id_extension, section_number). A
+ * section with the same length and CRC_32 is dropped without checking its
+ * CRC_32 and without being given to the decoder, whatever its version, when
+ * the decoder holds a complete table with this table_id and
+ * table_id_extension and is not building one. A decoder which was reset
+ * receives all the sections again. The cache is kept across TS
+ * discontinuities, but the first section following one always goes to the
+ * decoder so that it starts over and delivers the table again.
+ *
+ * The dropped sections are counted in dvbpsi_counters_t::i_cache_hits. As
+ * their CRC_32 is not checked, a corrupted repetition which kept the length
+ * and CRC_32 of its entry is counted there and not in
+ * dvbpsi_counters_t::i_crc_errors.
+ */
+bool dvbpsi_section_cache_enable(dvbpsi_t *p_dvbpsi, const unsigned int i_entries);
+
+/*****************************************************************************
+ * dvbpsi_section_cache_flush
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_section_cache_flush(dvbpsi_t *p_dvbpsi)
+ * \brief Forget all sections remembered by the section cache of a handle.
+ * \param p_dvbpsi handle to dvbpsi
+ * \return nothing
+ */
+void dvbpsi_section_cache_flush(dvbpsi_t *p_dvbpsi);
+
+/*!
+ * \def DVBPSI_FILTER_SIZE
+ * \brief Number of section bytes compared by a section filter
+ */
+#define DVBPSI_FILTER_SIZE 16
+
+/*****************************************************************************
+ * dvbpsi_section_filter_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_section_filter_s
+ * \brief Section filter, same layout as dmx_filter_t of the Linux DVB API.
+ *
+ * Byte 0 is compared with the table_id, bytes 1 to 15 with the section bytes
+ * following the section_length field. Only the bits set in i_mask are
+ * compared. Bits cleared in i_mode must be equal to i_filter (positive
+ * match), at least one of the bits set in i_mode must differ from i_filter
+ * (negative match).
+ */
+/*!
+ * \typedef struct dvbpsi_section_filter_s dvbpsi_section_filter_t
+ * \brief dvbpsi_section_filter_t type definition.
+ */
+typedef struct dvbpsi_section_filter_s
+{
+    uint8_t     i_filter[DVBPSI_FILTER_SIZE];   /*!< value of the bits */
+    uint8_t     i_mask[DVBPSI_FILTER_SIZE];     /*!< bits compared */
+    uint8_t     i_mode[DVBPSI_FILTER_SIZE];     /*!< negative match bits */
+} dvbpsi_section_filter_t;
+
+/*****************************************************************************
+ * dvbpsi_section_filter_add
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_section_filter_add(dvbpsi_t *p_dvbpsi,
+                                      const dvbpsi_section_filter_t *p_filter)
+ * \brief Add a section filter to a handle.
+ * \param p_dvbpsi handle to dvbpsi
+ * \param p_filter pointer to the filter, it is copied
+ * \return true on success, false on failure.
+ *
+ * When a handle has filters, only the sections matching at least one of them
+ * are given to its decoder. A section is checked as soon as its first TS
+ * packet holds the filtered bytes: the rest of a section which does not match
+ * is skipped in the TS payload, it is neither allocated nor copied. The other
+ * sections are checked once complete.
+ */
+bool dvbpsi_section_filter_add(dvbpsi_t *p_dvbpsi,
+                               const dvbpsi_section_filter_t *p_filter);
+
+/*****************************************************************************
+ * dvbpsi_section_filter_clear
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_section_filter_clear(dvbpsi_t *p_dvbpsi)
+ * \brief Remove all section filters of a handle.
+ * \param p_dvbpsi handle to dvbpsi
+ * \return nothing
+ */
+void dvbpsi_section_filter_clear(dvbpsi_t *p_dvbpsi);
+
 /*****************************************************************************
  * dvbpsi_psi_section_t
  *****************************************************************************/
@@ -245,6 +587,19 @@ typedef void (* dvbpsi_callback_gather_t)(dvbpsi_t *p_dvbpsi,  /*!< pointer to d
     dvbpsi_callback_gather_t  pf_gather;/*!< PSI decoder's callback */            \
     int      i_section_max_size;   /*!< Max size of a section for this decoder */ \
     int      i_need;               /*!< Bytes needed */                           \
+    uint8_t  i_header[3];          /*!< Section header until section_length      \
+                                        is known */                               \
+    uint8_t  i_current_table_id;   /*!< table_id of the current table */          \
+    uint16_t i_current_extension;  /*!< table_id_extension of the current table */\
+    uint8_t  i_current_version;    /*!< version_number of the current table */    \
+    bool     b_current_next_indicator; /*!< current_next_indicator of the        \
+                                            current table */                      \
+    uint32_t i_sections_received[8]; /*!< Bitmap of the section_number of the   \
+                                          sections in p_sections */               \
+    dvbpsi_psi_section_t **pp_sections_index; /*!< p_sections indexed by         \
+                                          section_number, valid for the bits     \
+                                          set in i_sections_received */           \
+    uint16_t i_sections_index_size; /*!< Entries of pp_sections_index */         \
 /**@}*/
 
 /*****************************************************************************
@@ -310,6 +665,13 @@ void dvbpsi_decoder_delete(dvbpsi_decoder_t *p_decoder);
  * \param b_force  If 'b_force' is true then dvbpsi_decoder_t::b_current_valid
  * is set to false, invalidating the current section.
  * \return nothing
+ *
+ * Otherwise, when the sections of a valid table are being reset, the table
+ * identification is kept in dvbpsi_decoder_t::i_current_table_id and the
+ * following members. The decoders which decode the sections on arrival and
+ * keep none set these members themselves when a table is complete.
+ * Repetitions of sections of this table are then dropped by
+ * dvbpsi_packet_push() before being copied and checked.
  */
 void dvbpsi_decoder_reset(dvbpsi_decoder_t* p_decoder, const bool b_force);
 
@@ -333,6 +695,11 @@ bool dvbpsi_decoder_psi_sections_completed(dvbpsi_decoder_t* p_decoder);
  * \param p_decoder pointer to dvbpsi_decoder_t with decoder
  * \param p_section PSI section to add to dvbpsi_decoder_t::p_sections list
  * \return true if it overwrites a earlier section, false otherwise
+ *
+ * The list stays sorted by section_number. The received section numbers are
+ * tracked in a bitmap and the sections in an array indexed by their number,
+ * so that adding a section and dvbpsi_decoder_psi_sections_completed() do not
+ * walk the list.
  */
 bool dvbpsi_decoder_psi_section_add(dvbpsi_decoder_t *p_decoder, dvbpsi_psi_section_t *p_section);
 
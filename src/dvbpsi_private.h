@@ -32,6 +32,335 @@
 
 #define ARRAY_SIZE(x) (sizeof(x) / sizeof((x)[0]))
 
+/*****************************************************************************
+ * dvbpsi_packet_decode
+ *****************************************************************************
+ * Section reassembly for one TS packet, the caller has checked the sync
+ * byte. Shared by dvbpsi_packet_push() and the TS packet router.
+ *****************************************************************************/
+bool dvbpsi_packet_decode(dvbpsi_t *p_dvbpsi, uint8_t* p_data);
+
+/*****************************************************************************
+ * dvbpsi_clock
+ *****************************************************************************
+ * Monotonic time in µs.
+ *****************************************************************************/
+int64_t dvbpsi_clock(void);
+
+/*****************************************************************************
+ * dvbpsi_packet_stride_offset
+ *****************************************************************************
+ * Offset of the TS packet in a packet of i_stride bytes.
+ *****************************************************************************/
+static inline size_t dvbpsi_packet_stride_offset(const dvbpsi_packet_stride_t i_stride)
+{
+    return (i_stride == DVBPSI_STRIDE_M2TS) ? 4 : 0;
+}
+
+/*****************************************************************************
+ * dvbpsi_m2ts_arrival_time
+ *****************************************************************************
+ * arrival_time_stamp of the TP_extra_header preceding an M2TS TS packet.
+ *****************************************************************************/
+static inline uint32_t dvbpsi_m2ts_arrival_time(const uint8_t *p_header)
+{
+    return ((uint32_t)(p_header[0] & 0x3f) << 24) | ((uint32_t)p_header[1] << 16)
+         | ((uint32_t)p_header[2] << 8) | p_header[3];
+}
+
+/*****************************************************************************
+ * dvbpsi_packets_stats_add
+ *****************************************************************************
+ * Add the counters of p_src to p_dst.
+ *****************************************************************************/
+static inline void dvbpsi_packets_stats_add(dvbpsi_packets_stats_t *p_dst,
+                                            const dvbpsi_packets_stats_t *p_src)
+{
+    p_dst->i_packets += p_src->i_packets;
+    p_dst->i_pushed += p_src->i_pushed;
+    p_dst->i_handled += p_src->i_handled;
+    p_dst->i_skipped += p_src->i_skipped;
+    p_dst->i_sync_errors += p_src->i_sync_errors;
+    p_dst->i_lost_bytes += p_src->i_lost_bytes;
+}
+
+/*****************************************************************************
+ * dvbpsi_demux_decoder_find
+ *****************************************************************************
+ * Finds the decoder of subtable (i_table_id, i_extension) when p_decoder is
+ * a demux attached with dvbpsi_AttachDemux(), returns NULL otherwise.
+ *****************************************************************************/
+dvbpsi_decoder_t *dvbpsi_demux_decoder_find(dvbpsi_decoder_t *p_decoder,
+                                            const uint8_t i_table_id,
+                                            const uint16_t i_extension);
+
+/*****************************************************************************
+ * dvbpsi_demux_range_idle
+ *****************************************************************************
+ * True when p_decoder is a demux whose range decoder for i_table_id holds a
+ * complete table of subtable (i_table_id, i_extension) and builds none of
+ * it. *pi_version and *pb_current_next are then those of the table.
+ *****************************************************************************/
+bool dvbpsi_demux_range_idle(dvbpsi_decoder_t *p_decoder,
+                             const uint8_t i_table_id, const uint16_t i_extension,
+                             uint8_t *pi_version, bool *pb_current_next);
+
+/*****************************************************************************
+ * dvbpsi_demux_section_ignored
+ *****************************************************************************
+ * True when p_decoder is a demux without decoder for subtable
+ * (i_table_id, i_extension) and this subtable is ignored, see
+ * dvbpsi_demux_ignore().
+ *****************************************************************************/
+bool dvbpsi_demux_section_ignored(dvbpsi_decoder_t *p_decoder,
+                                  const uint8_t i_table_id,
+                                  const uint16_t i_extension);
+
+/*****************************************************************************
+ * dvbpsi_decoder_section_received
+ *****************************************************************************
+ * Is section i_number in the sections kept by p_decoder?
+ *****************************************************************************/
+static inline bool dvbpsi_decoder_section_received(const dvbpsi_decoder_t *p_decoder,
+                                                   const uint8_t i_number)
+{
+    return (p_decoder->i_sections_received[i_number / 32] >> (i_number % 32)) & 1;
+}
+
+/*****************************************************************************
+ * dvbpsi_decoder_current_set
+ *****************************************************************************
+ * Remember the identification of the table p_decoder has just completed,
+ * whether its sections were kept or decoded on arrival. See
+ * dvbpsi_decoder_reset().
+ *****************************************************************************/
+static inline void dvbpsi_decoder_current_set(dvbpsi_decoder_t *p_decoder,
+                                              const uint8_t i_table_id,
+                                              const uint16_t i_extension,
+                                              const uint8_t i_version,
+                                              const bool b_current_next)
+{
+    p_decoder->i_current_table_id = i_table_id;
+    p_decoder->i_current_extension = i_extension;
+    p_decoder->i_current_version = i_version;
+    p_decoder->b_current_next_indicator = b_current_next;
+}
+
+/*****************************************************************************
+ * dvbpsi_decoder_decode_on_arrival
+ *****************************************************************************
+ * Should the next section of the table built by p_decoder be decoded at
+ * once and not kept? A table started in one mode is finished in that mode,
+ * the mode of a new table is dvbpsi_t::b_decode_on_arrival.
+ *****************************************************************************/
+bool dvbpsi_decoder_decode_on_arrival(const dvbpsi_t *p_dvbpsi,
+                                      const dvbpsi_decoder_t *p_decoder);
+
+/*****************************************************************************
+ * dvbpsi_decoder_psi_section_mark
+ *****************************************************************************
+ * Record that p_section of the table has been received without keeping it,
+ * returns true when a section with the same number had already been
+ * received. Used for decoding on arrival instead of
+ * dvbpsi_decoder_psi_section_add().
+ *****************************************************************************/
+bool dvbpsi_decoder_psi_section_mark(dvbpsi_decoder_t *p_decoder,
+                                     const dvbpsi_psi_section_t *p_section);
+
+/*****************************************************************************
+ * dvbpsi_psi_sections_insert
+ *****************************************************************************
+ * Insert p_section in the list *pp_sections sorted by section_number. A
+ * section with the same number is replaced and deleted, true is returned
+ * then. Used by decoders keeping the sections of several subtables.
+ *****************************************************************************/
+bool dvbpsi_psi_sections_insert(dvbpsi_psi_section_t **pp_sections,
+                                dvbpsi_psi_section_t *p_section);
+
+/*****************************************************************************
+ * dvbpsi_crc32
+ *****************************************************************************
+ * Update the MPEG-2 CRC_32 i_crc with i_size bytes of p_data, using the
+ * fastest implementation available on this CPU.
+ *****************************************************************************/
+uint32_t dvbpsi_crc32(uint32_t i_crc, const uint8_t *p_data, size_t i_size);
+
+/*****************************************************************************
+ * dvbpsi_section_pool_t
+ *****************************************************************************
+ * Per handle freelists of section structures and of section data buffers
+ * in power of two size classes. Sections taken from the pool return to it
+ * in dvbpsi_DeletePSISections(), the pool is freed once the handle has
+ * released it and all its sections are back.
+ *****************************************************************************/
+typedef struct dvbpsi_section_pool_s dvbpsi_section_pool_t;
+
+dvbpsi_section_pool_t *dvbpsi_section_pool_new(void);
+void dvbpsi_section_pool_release(dvbpsi_section_pool_t *p_pool);
+
+/*****************************************************************************
+ * dvbpsi_section_pool_get
+ *****************************************************************************
+ * Get a cleared section without data.
+ *****************************************************************************/
+dvbpsi_psi_section_t *dvbpsi_section_pool_get(dvbpsi_section_pool_t *p_pool);
+
+/*****************************************************************************
+ * dvbpsi_section_data_alloc
+ *****************************************************************************
+ * Give a section whose p_data is a view a buffer of i_size bytes of its own,
+ * taken from its pool if any, and copy the first i_copy bytes of the view.
+ *****************************************************************************/
+bool dvbpsi_section_data_alloc(dvbpsi_psi_section_t *p_section,
+                               const size_t i_size, const size_t i_copy);
+
+/*****************************************************************************
+ * dvbpsi_section_cache_t
+ *****************************************************************************
+ * Fingerprints of the last valid sections of a handle, see
+ * dvbpsi_section_cache_enable(). Both functions take a complete section with
+ * section_syntax_indicator and CRC_32.
+ *****************************************************************************/
+typedef struct dvbpsi_section_cache_s dvbpsi_section_cache_t;
+
+bool dvbpsi_section_cache_lookup(dvbpsi_section_cache_t *p_cache,
+                                 const dvbpsi_psi_section_t *p_section);
+void dvbpsi_section_cache_add(dvbpsi_section_cache_t *p_cache,
+                              const dvbpsi_psi_section_t *p_section);
+
+/*****************************************************************************
+ * dvbpsi_section_filters_t
+ *****************************************************************************
+ * Section filters of a handle, see dvbpsi_section_filter_add().
+ * dvbpsi_section_filters_match() takes the first i_size bytes of a section,
+ * it returns false when no filter matches them and true when a filter
+ * matches or when the missing bytes of the section may still match.
+ *****************************************************************************/
+typedef struct dvbpsi_section_filters_s dvbpsi_section_filters_t;
+
+bool dvbpsi_section_filters_match(const dvbpsi_section_filters_t *p_filters,
+                                  const uint8_t *p_section, size_t i_size);
+
+/*****************************************************************************
+ * dvbpsi_descriptor_append
+ *****************************************************************************
+ * Append p_descriptor to the descriptor list *pp_first in constant time.
+ * *pp_last is the tail kept by the caller while it fills the list, NULL
+ * when unknown, and is set to p_descriptor. The end of the list is searched
+ * from it.
+ *****************************************************************************/
+struct dvbpsi_descriptor_s;
+
+void dvbpsi_descriptor_append(struct dvbpsi_descriptor_s **pp_first,
+                              struct dvbpsi_descriptor_s **pp_last,
+                              struct dvbpsi_descriptor_s *p_descriptor);
+
+/*****************************************************************************
+ * dvbpsi_descriptors_select/dvbpsi_descriptors_decode
+ *****************************************************************************
+ * dvbpsi_DecodeAllDescriptors() in two steps, so that all the descriptor
+ * loops of a table are decoded with one selection of tags. p_selected[tag]
+ * is not 0 for the tags to decode, all of them when p_tags is NULL.
+ *****************************************************************************/
+void dvbpsi_descriptors_select(uint8_t p_selected[256],
+                               const uint8_t *p_tags, const unsigned int i_tags);
+unsigned int dvbpsi_descriptors_decode(struct dvbpsi_descriptor_s *p_descriptor,
+                                       uint32_t i_private_data_specifier,
+                                       const uint8_t p_selected[256]);
+
+/*****************************************************************************
+ * dvbpsi_arena_t
+ *****************************************************************************
+ * Memory of a table decoded with dvbpsi_t::b_arena_tables: the table, its
+ * elements and its descriptors are carved out of a few large chunks freed
+ * together by dvbpsi_arena_delete(). dvbpsi_arena_alloc() gives zeroed
+ * memory and uses calloc() when p_arena is NULL, dvbpsi_arena_free() only
+ * frees objects of a NULL arena. The descriptor functions are the
+ * equivalents of dvbpsi_NewDescriptor(), dvbpsi_descriptor_append() and
+ * dvbpsi_DeleteDescriptors(), the latter frees the decoded descriptors and
+ * the descriptors the application added to the table outside of the arena.
+ *
+ * An arena created with b_keep_sections (dvbpsi_t::b_zero_copy_descriptors)
+ * keeps the data of the sections given to dvbpsi_arena_section_keep(): it
+ * takes over the buffer of the section, or copies a section whose data is a
+ * view, and the section becomes a view on the kept data. The descriptors
+ * created afterwards from the payload of the last section kept point into
+ * it instead of being copied.
+ *****************************************************************************/
+typedef struct dvbpsi_arena_s dvbpsi_arena_t;
+
+dvbpsi_arena_t *dvbpsi_arena_new(const bool b_keep_sections);
+void dvbpsi_arena_delete(dvbpsi_arena_t *p_arena);
+
+void dvbpsi_arena_section_keep(dvbpsi_arena_t *p_arena, dvbpsi_psi_section_t *p_section);
+
+void *dvbpsi_arena_alloc(dvbpsi_arena_t *p_arena, size_t i_size);
+void dvbpsi_arena_free(dvbpsi_arena_t *p_arena, void *p_object);
+
+struct dvbpsi_descriptor_s *dvbpsi_arena_descriptor_new(dvbpsi_arena_t *p_arena,
+                                                        uint8_t i_tag, uint8_t i_length,
+                                                        uint8_t *p_data);
+struct dvbpsi_descriptor_s *dvbpsi_arena_descriptor_add(dvbpsi_arena_t *p_arena,
+                                                        struct dvbpsi_descriptor_s **pp_first,
+                                                        struct dvbpsi_descriptor_s **pp_last,
+                                                        uint8_t i_tag, uint8_t i_length,
+                                                        uint8_t *p_data);
+void dvbpsi_arena_descriptors_delete(dvbpsi_arena_t *p_arena,
+                                     struct dvbpsi_descriptor_s *p_descriptor);
+
+/*****************************************************************************
+ * dvbpsi_delta_state_t
+ *****************************************************************************
+ * Fingerprints of the last table of a decoder with a delta callback. The
+ * decoder adds the elements of each new table with dvbpsi_delta_element_add()
+ * and dvbpsi_delta_descriptors_add(), and the fields of the table itself with
+ * dvbpsi_delta_table_add(), then dvbpsi_delta_compute() gives the
+ * changes since the previous table, valid until the next call. When it
+ * fails, the next table is compared with the same previous table.
+ *****************************************************************************/
+typedef struct dvbpsi_delta_state_s dvbpsi_delta_state_t;
+struct dvbpsi_delta_s;
+
+#define DVBPSI_DELTA_HASH_INIT UINT64_C(0xcbf29ce484222325)
+
+dvbpsi_delta_state_t *dvbpsi_delta_state_new(void);
+void dvbpsi_delta_state_delete(dvbpsi_delta_state_t *p_state);
+
+uint64_t dvbpsi_delta_hash(uint64_t i_hash, const uint8_t *p_data, size_t i_size);
+uint64_t dvbpsi_delta_hash_descriptors(uint64_t i_hash,
+                                       const struct dvbpsi_descriptor_s *p_descriptor);
+
+void dvbpsi_delta_element_add(dvbpsi_delta_state_t *p_state, const uint32_t i_key,
+                              const uint64_t i_hash, const void *p_element);
+void dvbpsi_delta_descriptors_add(dvbpsi_delta_state_t *p_state,
+                                  const struct dvbpsi_descriptor_s *p_descriptor);
+void dvbpsi_delta_table_add(dvbpsi_delta_state_t *p_state, const uint64_t i_hash,
+                            const void *p_table);
+bool dvbpsi_delta_compute(dvbpsi_delta_state_t *p_state,
+                          const struct dvbpsi_delta_s **pp_deltas,
+                          unsigned int *pi_deltas);
+
+/*****************************************************************************
+ * dvbpsi_log_ring_push
+ *****************************************************************************
+ * Record an event of p_dvbpsi in a log ring (see log.h), the record is
+ * dropped when the ring is full. Only available with HAVE_ATOMIC_BUILTINS.
+ *****************************************************************************/
+void dvbpsi_log_ring_push(struct dvbpsi_log_ring_s *p_ring, dvbpsi_t *p_dvbpsi,
+                          const unsigned int i_code, const uint16_t i_pid,
+                          const uint8_t i_table_id,
+                          const uint32_t i_arg0, const uint32_t i_arg1);
+
+/*****************************************************************************
+ * dvbpsi_decoder_sections_own
+ *****************************************************************************
+ * Copy the sections kept by p_decoder which still point into the TS packet.
+ * When this fails the kept sections are dropped and p_decoder is flagged
+ * with a discontinuity, so that the table being built is dropped too and
+ * gathered again. Used in zero-copy mode after a section has been gathered.
+ *****************************************************************************/
+void dvbpsi_decoder_sections_own(dvbpsi_t *p_dvbpsi, dvbpsi_decoder_t *p_decoder);
+
 /*****************************************************************************
  * Error management
  *
@@ -39,15 +368,32 @@
  * "libdvbpsi [error | warning | debug] (<component>): <msg>"
  *****************************************************************************/
 
+/* Messages are only formatted when the handle has a callback for their level,
+ * the events of the packet path are also counted in dvbpsi_t::counters */
+static inline bool dvbpsi_message_enabled(dvbpsi_t *dvbpsi, const int level)
+{
+    return dvbpsi->pf_message && (dvbpsi->i_msg_level > DVBPSI_MSG_NONE)
+        && (level <= dvbpsi->i_msg_level);
+}
+
 #ifdef HAVE_VARIADIC_MACROS
 void dvbpsi_message(dvbpsi_t *dvbpsi, const int level, const char *fmt, ...);
 
-#  define dvbpsi_error(hnd, src, str, x...)                             \
-        dvbpsi_message(hnd, DVBPSI_MSG_ERROR, "libdvbpsi error (%s): " str, src, ##x)
+#  define dvbpsi_error(hnd, src, str, x...)                                  \
+    do {                                                                     \
+        if (dvbpsi_message_enabled(hnd, DVBPSI_MSG_ERROR))                   \
+            dvbpsi_message(hnd, DVBPSI_MSG_ERROR, "libdvbpsi error (%s): " str, src, ##x); \
+    } while (0)
 #  define dvbpsi_warning(hnd, src, str, x...)                                \
-        dvbpsi_message(hnd, DVBPSI_MSG_WARN, "libdvbpsi warning (%s): " str, src, ##x)
+    do {                                                                     \
+        if (dvbpsi_message_enabled(hnd, DVBPSI_MSG_WARN))                    \
+            dvbpsi_message(hnd, DVBPSI_MSG_WARN, "libdvbpsi warning (%s): " str, src, ##x); \
+    } while (0)
 #  define dvbpsi_debug(hnd, src, str, x...)                                  \
-        dvbpsi_message(hnd, DVBPSI_MSG_DEBUG, "libdvbpsi debug (%s): " str, src, ##x)
+    do {                                                                     \
+        if (dvbpsi_message_enabled(hnd, DVBPSI_MSG_DEBUG))                   \
+            dvbpsi_message(hnd, DVBPSI_MSG_DEBUG, "libdvbpsi debug (%s): " str, src, ##x); \
+    } while (0)
 #else
 void dvbpsi_error(dvbpsi_t *dvbpsi, const char *src, const char *fmt, ...);
 void dvbpsi_warning(dvbpsi_t *dvbpsi, const char *src, const char *fmt, ...);
@@ -0,0 +1,172 @@
+/*****************************************************************************
+ * filter.c: section filters
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+#include <assert.h>
+
+#include "dvbpsi.h"
+#include "dvbpsi_private.h"
+
+/* Filter byte 0 is the table_id, the following ones start after the
+ * section_length field. */
+#define DVBPSI_FILTER_HEADER (DVBPSI_FILTER_SIZE + 2)
+
+/*****************************************************************************
+ * dvbpsi_section_filters_s
+ *****************************************************************************
+ * Filters of a handle with their bytes at the position of the section bytes
+ * they are compared with.
+ *****************************************************************************/
+typedef struct dvbpsi_section_filter_entry_s
+{
+    uint8_t     i_value[DVBPSI_FILTER_HEADER];
+    uint8_t     i_positive[DVBPSI_FILTER_HEADER];   /* mask & ~mode */
+    uint8_t     i_negative[DVBPSI_FILTER_HEADER];   /* mask & mode */
+    size_t      i_header;   /* section bytes up to the last masked one */
+    bool        b_negative; /* some bits are compared in negative mode */
+} dvbpsi_section_filter_entry_t;
+
+struct dvbpsi_section_filters_s
+{
+    unsigned int                    i_filters;
+
+    dvbpsi_section_filter_entry_t  *p_filters;
+};
+
+/*****************************************************************************
+ * dvbpsi_section_filter_add
+ *****************************************************************************/
+bool dvbpsi_section_filter_add(dvbpsi_t *p_dvbpsi,
+                               const dvbpsi_section_filter_t *p_filter)
+{
+    assert(p_dvbpsi);
+    assert(p_filter);
+
+    dvbpsi_section_filters_t *p_filters = p_dvbpsi->p_filters;
+    if (p_filters == NULL)
+    {
+        p_filters = calloc(1, sizeof(dvbpsi_section_filters_t));
+        if (p_filters == NULL)
+            return false;
+        p_dvbpsi->p_filters = p_filters;
+    }
+
+    dvbpsi_section_filter_entry_t *p_entries
+            = realloc(p_filters->p_filters, (p_filters->i_filters + 1)
+                                            * sizeof(dvbpsi_section_filter_entry_t));
+    if (p_entries == NULL)
+        return false;
+    p_filters->p_filters = p_entries;
+
+    dvbpsi_section_filter_entry_t *p_entry = &p_entries[p_filters->i_filters];
+    memset(p_entry, 0, sizeof(dvbpsi_section_filter_entry_t));
+    for (int i = 0; i < DVBPSI_FILTER_SIZE; i++)
+    {
+        const size_t j = (i == 0) ? 0 : i + 2;
+        p_entry->i_value[j] = p_filter->i_filter[i];
+        p_entry->i_positive[j] = p_filter->i_mask[i] & ~p_filter->i_mode[i];
+        p_entry->i_negative[j] = p_filter->i_mask[i] & p_filter->i_mode[i];
+        if (p_filter->i_mask[i])
+            p_entry->i_header = j + 1;
+        if (p_entry->i_negative[j])
+            p_entry->b_negative = true;
+    }
+    p_filters->i_filters++;
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_section_filter_clear
+ *****************************************************************************/
+void dvbpsi_section_filter_clear(dvbpsi_t *p_dvbpsi)
+{
+    assert(p_dvbpsi);
+
+    if (p_dvbpsi->p_filters)
+        free(p_dvbpsi->p_filters->p_filters);
+    free(p_dvbpsi->p_filters);
+    p_dvbpsi->p_filters = NULL;
+}
+
+/*****************************************************************************
+ * dvbpsi_section_filters_match
+ *****************************************************************************/
+bool dvbpsi_section_filters_match(const dvbpsi_section_filters_t *p_filters,
+                                  const uint8_t *p_section, size_t i_size)
+{
+    if (i_size < 3)
+        return true;
+
+    /* Bytes past the end of the section are missing, not unknown */
+    const size_t i_total = 3 + ((((size_t)p_section[1] & 0xf) << 8) | p_section[2]);
+    const bool b_complete = (i_size >= i_total);
+    if (b_complete)
+        i_size = i_total;
+
+    for (unsigned int f = 0; f < p_filters->i_filters; f++)
+    {
+        const dvbpsi_section_filter_entry_t *p_entry = &p_filters->p_filters[f];
+        const size_t i_header = p_entry->i_header;
+        const size_t i_compared = (i_size < i_header) ? i_size : i_header;
+        uint8_t i_differ = 0;
+        size_t i;
+
+        for (i = 0; i < i_compared; i++)
+        {
+            const uint8_t i_xor = p_entry->i_value[i] ^ p_section[i];
+            if (i_xor & p_entry->i_positive[i])
+                break;
+            i_differ |= i_xor & p_entry->i_negative[i];
+        }
+        if (i < i_compared)
+            continue;
+
+        if (i_compared < i_header)
+        {
+            /* The next TS packets may still match */
+            if (!b_complete)
+                return true;
+            for (; i < i_header; i++)
+                if (p_entry->i_positive[i])
+                    break;
+            if (i < i_header)
+                continue;
+        }
+
+        if (!p_entry->b_negative || i_differ)
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,307 @@
+/*****************************************************************************
+ * log.c: deferred binary log of section reassembly events
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+#include <assert.h>
+
+#include "dvbpsi.h"
+#include "dvbpsi_private.h"
+#include "log.h"
+
+/*****************************************************************************
+ * dvbpsi_log_ring_s
+ *****************************************************************************
+ * Bounded queue with a sequence number per slot: producers reserve a slot
+ * by advancing i_head, then publish the record by setting the sequence
+ * number of the slot. The consumer frees the slot by moving its sequence
+ * number one turn ahead.
+ *****************************************************************************/
+typedef struct dvbpsi_log_slot_s
+{
+    uint32_t                i_sequence;
+    dvbpsi_log_record_t     record;
+} dvbpsi_log_slot_t;
+
+typedef struct dvbpsi_log_rate_s
+{
+    unsigned int    i_burst;
+    unsigned int    i_per_second;
+    int64_t         i_credit;       /* records allowed, in µs of rate */
+    int64_t         i_last;         /* time of the last record */
+    unsigned int    i_suppressed;
+} dvbpsi_log_rate_t;
+
+struct dvbpsi_log_ring_s
+{
+    uint32_t            i_mask;
+    uint32_t            i_head;         /* next slot to reserve */
+    uint32_t            i_tail;         /* next slot to pop, consumer only */
+    unsigned long       i_overflows;
+
+    dvbpsi_log_rate_t   rates[DVBPSI_LOG_CODES];   /* consumer only */
+
+    dvbpsi_log_slot_t   p_slots[];
+};
+
+/*****************************************************************************
+ * dvbpsi_log_ring_new
+ *****************************************************************************/
+dvbpsi_log_ring_t *dvbpsi_log_ring_new(const unsigned int i_records)
+{
+#ifdef HAVE_ATOMIC_BUILTINS
+    uint32_t i_size = 2;
+    while (i_size < i_records && i_size < (UINT32_C(1) << 24))
+        i_size <<= 1;
+
+    dvbpsi_log_ring_t *p_ring = calloc(1, sizeof(dvbpsi_log_ring_t)
+                                          + i_size * sizeof(dvbpsi_log_slot_t));
+    if (p_ring == NULL)
+        return NULL;
+
+    p_ring->i_mask = i_size - 1;
+    for (uint32_t i = 0; i < i_size; i++)
+        p_ring->p_slots[i].i_sequence = i;
+    return p_ring;
+#else
+    (void)i_records;
+    return NULL;
+#endif
+}
+
+/*****************************************************************************
+ * dvbpsi_log_ring_delete
+ *****************************************************************************/
+void dvbpsi_log_ring_delete(dvbpsi_log_ring_t *p_ring)
+{
+    free(p_ring);
+}
+
+/*****************************************************************************
+ * dvbpsi_log_ring_set_rate
+ *****************************************************************************/
+void dvbpsi_log_ring_set_rate(dvbpsi_log_ring_t *p_ring, const dvbpsi_log_code_t i_code,
+                              const unsigned int i_burst, const unsigned int i_per_second)
+{
+    assert(p_ring);
+
+    if (i_code >= DVBPSI_LOG_CODES)
+        return;
+
+    dvbpsi_log_rate_t *p_rate = &p_ring->rates[i_code];
+    p_rate->i_burst = i_burst;
+    p_rate->i_per_second = i_per_second;
+    p_rate->i_credit = (int64_t)i_burst * 1000000;
+    p_rate->i_last = 0;
+}
+
+#ifdef HAVE_ATOMIC_BUILTINS
+/*****************************************************************************
+ * dvbpsi_log_ring_push
+ *****************************************************************************/
+void dvbpsi_log_ring_push(dvbpsi_log_ring_t *p_ring, dvbpsi_t *p_dvbpsi,
+                          const unsigned int i_code, const uint16_t i_pid,
+                          const uint8_t i_table_id,
+                          const uint32_t i_arg0, const uint32_t i_arg1)
+{
+    uint32_t i_pos = __atomic_load_n(&p_ring->i_head, __ATOMIC_RELAXED);
+    dvbpsi_log_slot_t *p_slot;
+
+    for (;;)
+    {
+        p_slot = &p_ring->p_slots[i_pos & p_ring->i_mask];
+        uint32_t i_sequence = __atomic_load_n(&p_slot->i_sequence, __ATOMIC_ACQUIRE);
+        int32_t i_diff = (int32_t)(i_sequence - i_pos);
+
+        if (i_diff == 0)
+        {
+            if (__atomic_compare_exchange_n(&p_ring->i_head, &i_pos, i_pos + 1,
+                                            true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                break;
+        }
+        else if (i_diff < 0)
+        {
+            /* Full, the consumer has not freed this slot yet */
+            __atomic_fetch_add(&p_ring->i_overflows, 1, __ATOMIC_RELAXED);
+            return;
+        }
+        else
+            i_pos = __atomic_load_n(&p_ring->i_head, __ATOMIC_RELAXED);
+    }
+
+    dvbpsi_log_record_t *p_record = &p_slot->record;
+    p_record->i_time = dvbpsi_clock();
+    p_record->p_dvbpsi = p_dvbpsi;
+    p_record->i_code = i_code;
+    p_record->i_pid = i_pid;
+    p_record->i_table_id = i_table_id;
+    p_record->i_args[0] = i_arg0;
+    p_record->i_args[1] = i_arg1;
+    p_record->i_suppressed = 0;
+
+    __atomic_store_n(&p_slot->i_sequence, i_pos + 1, __ATOMIC_RELEASE);
+}
+#endif
+
+/*****************************************************************************
+ * dvbpsi_log_rate_allow
+ *****************************************************************************
+ * Token bucket of a code, the credit is counted in µs of its rate.
+ *****************************************************************************/
+static bool dvbpsi_log_rate_allow(dvbpsi_log_rate_t *p_rate, const int64_t i_time)
+{
+    if (p_rate->i_per_second == 0)
+        return true;
+
+    const int64_t i_max = (int64_t)(p_rate->i_burst ? p_rate->i_burst : 1) * 1000000;
+    if (i_time > p_rate->i_last)
+    {
+        p_rate->i_credit += (i_time - p_rate->i_last) * p_rate->i_per_second;
+        if (p_rate->i_credit > i_max)
+            p_rate->i_credit = i_max;
+        p_rate->i_last = i_time;
+    }
+
+    if (p_rate->i_credit < 1000000)
+        return false;
+
+    p_rate->i_credit -= 1000000;
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_log_ring_pop
+ *****************************************************************************/
+bool dvbpsi_log_ring_pop(dvbpsi_log_ring_t *p_ring, dvbpsi_log_record_t *p_record)
+{
+    assert(p_ring);
+    assert(p_record);
+
+#ifdef HAVE_ATOMIC_BUILTINS
+    for (;;)
+    {
+        uint32_t i_pos = p_ring->i_tail;
+        dvbpsi_log_slot_t *p_slot = &p_ring->p_slots[i_pos & p_ring->i_mask];
+        uint32_t i_sequence = __atomic_load_n(&p_slot->i_sequence, __ATOMIC_ACQUIRE);
+
+        if ((int32_t)(i_sequence - (i_pos + 1)) < 0)
+            return false;
+
+        *p_record = p_slot->record;
+        p_ring->i_tail = i_pos + 1;
+        __atomic_store_n(&p_slot->i_sequence, i_pos + p_ring->i_mask + 1,
+                         __ATOMIC_RELEASE);
+
+        if (p_record->i_code >= DVBPSI_LOG_CODES)
+            return true;
+
+        dvbpsi_log_rate_t *p_rate = &p_ring->rates[p_record->i_code];
+        if (dvbpsi_log_rate_allow(p_rate, p_record->i_time))
+        {
+            p_record->i_suppressed = p_rate->i_suppressed;
+            p_rate->i_suppressed = 0;
+            return true;
+        }
+        p_rate->i_suppressed++;
+    }
+#else
+    return false;
+#endif
+}
+
+/*****************************************************************************
+ * dvbpsi_log_ring_overflows
+ *****************************************************************************/
+unsigned long dvbpsi_log_ring_overflows(dvbpsi_log_ring_t *p_ring)
+{
+    assert(p_ring);
+
+#ifdef HAVE_ATOMIC_BUILTINS
+    return __atomic_load_n(&p_ring->i_overflows, __ATOMIC_RELAXED);
+#else
+    return p_ring->i_overflows;
+#endif
+}
+
+/*****************************************************************************
+ * dvbpsi_log_record_format
+ *****************************************************************************/
+int dvbpsi_log_record_format(const dvbpsi_log_record_t *p_record,
+                             char *psz_msg, const size_t i_size)
+{
+    char psz_suppressed[48] = "";
+
+    assert(p_record);
+
+    if (p_record->i_suppressed > 0)
+        snprintf(psz_suppressed, sizeof(psz_suppressed),
+                 " (%u similar messages suppressed)", p_record->i_suppressed);
+
+    switch (p_record->i_code)
+    {
+    case DVBPSI_LOG_CC_ERROR:
+        return snprintf(psz_msg, i_size,
+                        "libdvbpsi error (PSI decoder): TS discontinuity (received %u, expected %u) for PID %u%s",
+                        p_record->i_args[0], p_record->i_args[1], p_record->i_pid,
+                        psz_suppressed);
+    case DVBPSI_LOG_DUPLICATE:
+        return snprintf(psz_msg, i_size,
+                        "libdvbpsi error (PSI decoder): TS duplicate (received %u, expected %u) for PID %u%s",
+                        p_record->i_args[0], p_record->i_args[1], p_record->i_pid,
+                        psz_suppressed);
+    case DVBPSI_LOG_CRC_ERROR:
+        return snprintf(psz_msg, i_size,
+                        "libdvbpsi error (misc PSI): Bad CRC_32 table 0x%x for PID %u%s",
+                        p_record->i_table_id, p_record->i_pid, psz_suppressed);
+    case DVBPSI_LOG_OVERSIZE:
+        return snprintf(psz_msg, i_size,
+                        "libdvbpsi error (PSI decoder): PSI section too long (%u bytes) for PID %u%s",
+                        p_record->i_args[0], p_record->i_pid, psz_suppressed);
+    case DVBPSI_LOG_OUT_OF_MEMORY:
+        return snprintf(psz_msg, i_size,
+                        "libdvbpsi error (PSI decoder): out of memory for PID %u%s",
+                        p_record->i_pid, psz_suppressed);
+    case DVBPSI_LOG_SYNC_ERRORS:
+        return snprintf(psz_msg, i_size,
+                        "libdvbpsi error (PSI decoder): %u TS packets without sync byte%s",
+                        p_record->i_args[0], psz_suppressed);
+    case DVBPSI_LOG_LOST_BYTES:
+        return snprintf(psz_msg, i_size,
+                        "libdvbpsi warning (PSI decoder): lost %u bytes out of %u%s",
+                        p_record->i_args[0], p_record->i_args[1], psz_suppressed);
+    default:
+        return snprintf(psz_msg, i_size, "libdvbpsi: unknown event %u%s",
+                        p_record->i_code, psz_suppressed);
+    }
+}
@@ -0,0 +1,205 @@
+/*****************************************************************************
+ * log.h
+ *
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *****************************************************************************/
+
+/*!
+ * \file <log.h>
+ * \brief Deferred binary log of section reassembly events.
+ *
+ * A log ring receives compact records of the events of the handles whose
+ * dvbpsi_t::p_log_ring points to it. Pushing a record never blocks nor
+ * allocates: records are dropped when the ring is full. One consumer thread
+ * pops the records, subject to a per code rate limit, and formats them
+ * with dvbpsi_log_record_format().
+ */
+
+#ifndef _DVBPSI_LOG_H_
+#define _DVBPSI_LOG_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*****************************************************************************
+ * dvbpsi_log_code_t
+ *****************************************************************************/
+/*!
+ * \enum dvbpsi_log_code
+ * \brief Reassembly events recorded in a log ring
+ */
+enum dvbpsi_log_code
+{
+    DVBPSI_LOG_CC_ERROR = 0,    /*!< TS discontinuity, arguments: received and
+                                     expected continuity_counter */
+    DVBPSI_LOG_DUPLICATE,       /*!< duplicate TS packet, arguments: received
+                                     and expected continuity_counter */
+    DVBPSI_LOG_CRC_ERROR,       /*!< section with a bad CRC_32 */
+    DVBPSI_LOG_OVERSIZE,        /*!< section too long, argument: section_length */
+    DVBPSI_LOG_OUT_OF_MEMORY,   /*!< section dropped for lack of memory */
+    DVBPSI_LOG_SYNC_ERRORS,     /*!< TS packets without sync byte in a push,
+                                     argument: number of packets */
+    DVBPSI_LOG_LOST_BYTES,      /*!< bytes skipped to find TS packets in a
+                                     push, arguments: lost and pushed bytes */
+    DVBPSI_LOG_CODES            /*!< number of codes */
+};
+/*!
+ * \typedef enum dvbpsi_log_code dvbpsi_log_code_t
+ * \brief dvbpsi_log_code_t type definition.
+ */
+typedef enum dvbpsi_log_code dvbpsi_log_code_t;
+
+/*!
+ * \def DVBPSI_LOG_NO_PID
+ * \brief dvbpsi_log_record_t::i_pid of events which are not about one PID
+ */
+#define DVBPSI_LOG_NO_PID 0xffff
+
+/*****************************************************************************
+ * dvbpsi_log_record_t
+ *****************************************************************************/
+/*!
+ * \struct dvbpsi_log_record_s
+ * \brief One event of a log ring.
+ */
+/*!
+ * \typedef struct dvbpsi_log_record_s dvbpsi_log_record_t
+ * \brief dvbpsi_log_record_t type definition.
+ */
+typedef struct dvbpsi_log_record_s
+{
+    int64_t         i_time;         /*!< monotonic time of the event in µs */
+    dvbpsi_t       *p_dvbpsi;       /*!< handle of the event, it may have
+                                         been deleted since */
+    uint16_t        i_code;         /*!< dvbpsi_log_code_t */
+    uint16_t        i_pid;          /*!< PID or DVBPSI_LOG_NO_PID */
+    uint8_t         i_table_id;     /*!< table_id, 0xff when unknown */
+    uint32_t        i_args[2];      /*!< code specific arguments */
+
+    unsigned int    i_suppressed;   /*!< records of the same code dropped by
+                                         the rate limit before this one */
+} dvbpsi_log_record_t;
+
+/*****************************************************************************
+ * dvbpsi_log_ring_t
+ *****************************************************************************/
+/*!
+ * \typedef struct dvbpsi_log_ring_s dvbpsi_log_ring_t
+ * \brief Log ring structure abstraction.
+ */
+typedef struct dvbpsi_log_ring_s dvbpsi_log_ring_t;
+
+/*****************************************************************************
+ * dvbpsi_log_ring_new
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_log_ring_t *dvbpsi_log_ring_new(const unsigned int i_records)
+ * \brief Create a log ring without rate limits.
+ * \param i_records number of records the ring holds, rounded up to a power
+ * of two
+ * \return pointer to the ring, NULL on failure or when libdvbpsi was built
+ * without atomic operations.
+ */
+dvbpsi_log_ring_t *dvbpsi_log_ring_new(const unsigned int i_records);
+
+/*****************************************************************************
+ * dvbpsi_log_ring_delete
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_log_ring_delete(dvbpsi_log_ring_t *p_ring)
+ * \brief Delete a log ring.
+ * \param p_ring pointer to the ring
+ * \return nothing
+ *
+ * No handle may point to the ring anymore.
+ */
+void dvbpsi_log_ring_delete(dvbpsi_log_ring_t *p_ring);
+
+/*****************************************************************************
+ * dvbpsi_log_ring_set_rate
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_log_ring_set_rate(dvbpsi_log_ring_t *p_ring,
+                                     const dvbpsi_log_code_t i_code,
+                                     const unsigned int i_burst,
+                                     const unsigned int i_per_second)
+ * \brief Limit the number of records of one code returned by
+ * dvbpsi_log_ring_pop().
+ * \param p_ring pointer to the ring
+ * \param i_code code of the records to limit
+ * \param i_burst number of records returned in a row
+ * \param i_per_second number of records returned per second after a burst,
+ * 0 removes the limit.
+ * \return nothing
+ *
+ * The rate is measured with dvbpsi_log_record_t::i_time. Must be called from
+ * the consumer thread.
+ */
+void dvbpsi_log_ring_set_rate(dvbpsi_log_ring_t *p_ring, const dvbpsi_log_code_t i_code,
+                              const unsigned int i_burst, const unsigned int i_per_second);
+
+/*****************************************************************************
+ * dvbpsi_log_ring_pop
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_log_ring_pop(dvbpsi_log_ring_t *p_ring,
+                                dvbpsi_log_record_t *p_record)
+ * \brief Take the oldest record of a log ring within the rate limits.
+ * \param p_ring pointer to the ring
+ * \param p_record pointer to the record to fill
+ * \return true when a record was taken, false when the ring is empty.
+ *
+ * Only one thread may pop records from a ring at a time.
+ */
+bool dvbpsi_log_ring_pop(dvbpsi_log_ring_t *p_ring, dvbpsi_log_record_t *p_record);
+
+/*****************************************************************************
+ * dvbpsi_log_ring_overflows
+ *****************************************************************************/
+/*!
+ * \fn unsigned long dvbpsi_log_ring_overflows(dvbpsi_log_ring_t *p_ring)
+ * \brief Number of records dropped because the ring was full.
+ * \param p_ring pointer to the ring
+ * \return number of dropped records
+ */
+unsigned long dvbpsi_log_ring_overflows(dvbpsi_log_ring_t *p_ring);
+
+/*****************************************************************************
+ * dvbpsi_log_record_format
+ *****************************************************************************/
+/*!
+ * \fn int dvbpsi_log_record_format(const dvbpsi_log_record_t *p_record,
+                                     char *psz_msg, const size_t i_size)
+ * \brief Format a record as the message libdvbpsi logs for its event.
+ * \param p_record pointer to the record
+ * \param psz_msg pointer to the message buffer
+ * \param i_size size of the message buffer
+ * \return same as snprintf()
+ */
+int dvbpsi_log_record_format(const dvbpsi_log_record_t *p_record,
+                             char *psz_msg, const size_t i_size);
+
+#ifdef __cplusplus
+};
+#endif
+
+#else
+#error "Multiple inclusions of log.h"
+#endif
@@ -29,6 +29,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include <assert.h>
 
@@ -43,100 +44,179 @@
 #include "psi.h"
 
 /*****************************************************************************
- * dvbpsi_crc32_table
+ * dvbpsi_section_pool_s
  *****************************************************************************
- * This table is used to compute a PSI CRC byte per byte instead of bit per
- * bit. It's been generated by 'gen_crc' in the 'misc' directory:
- *
- *   uint32_t table[256];
- *   uint32_t i, j, k;
- *
- *   for(i = 0; i < 256; i++)
- *   {
- *     k = 0;
- *     for (j = (i << 24) | 0x800000; j != 0x80000000; j <<= 1)
- *       k = (k << 1) ^ (((k ^ j) & 0x80000000) ? 0x04c11db7 : 0);
- *     table[i] = k;
- *   }
- *
- * A CRC is computed like this:
- *
- *   initialization
- *   --------------
- *   uint32_t i_crc = 0xffffffff;
- *
- *   for each data byte do
- *   ---------------------
- *   i_crc = (i_crc << 8) ^ dvbpsi_crc32_table[(i_crc >> 24) ^ (data_byte)];
+ * Free data buffers are chained through their first bytes.
  *****************************************************************************/
-static uint32_t dvbpsi_crc32_table[256] =
+#define DVBPSI_SECTION_POOL_CLASSES 5   /* 256, 512, 1024, 2048, 4096 bytes */
+#define DVBPSI_SECTION_POOL_MIN     256
+#define DVBPSI_SECTION_POOL_DEPTH   256 /* free elements kept per list */
+
+struct dvbpsi_section_pool_s
 {
-  0x00000000, 0x04c11db7, 0x09823b6e, 0x0d4326d9,
-  0x130476dc, 0x17c56b6b, 0x1a864db2, 0x1e475005,
-  0x2608edb8, 0x22c9f00f, 0x2f8ad6d6, 0x2b4bcb61,
-  0x350c9b64, 0x31cd86d3, 0x3c8ea00a, 0x384fbdbd,
-  0x4c11db70, 0x48d0c6c7, 0x4593e01e, 0x4152fda9,
-  0x5f15adac, 0x5bd4b01b, 0x569796c2, 0x52568b75,
-  0x6a1936c8, 0x6ed82b7f, 0x639b0da6, 0x675a1011,
-  0x791d4014, 0x7ddc5da3, 0x709f7b7a, 0x745e66cd,
-  0x9823b6e0, 0x9ce2ab57, 0x91a18d8e, 0x95609039,
-  0x8b27c03c, 0x8fe6dd8b, 0x82a5fb52, 0x8664e6e5,
-  0xbe2b5b58, 0xbaea46ef, 0xb7a96036, 0xb3687d81,
-  0xad2f2d84, 0xa9ee3033, 0xa4ad16ea, 0xa06c0b5d,
-  0xd4326d90, 0xd0f37027, 0xddb056fe, 0xd9714b49,
-  0xc7361b4c, 0xc3f706fb, 0xceb42022, 0xca753d95,
-  0xf23a8028, 0xf6fb9d9f, 0xfbb8bb46, 0xff79a6f1,
-  0xe13ef6f4, 0xe5ffeb43, 0xe8bccd9a, 0xec7dd02d,
-  0x34867077, 0x30476dc0, 0x3d044b19, 0x39c556ae,
-  0x278206ab, 0x23431b1c, 0x2e003dc5, 0x2ac12072,
-  0x128e9dcf, 0x164f8078, 0x1b0ca6a1, 0x1fcdbb16,
-  0x018aeb13, 0x054bf6a4, 0x0808d07d, 0x0cc9cdca,
-  0x7897ab07, 0x7c56b6b0, 0x71159069, 0x75d48dde,
-  0x6b93dddb, 0x6f52c06c, 0x6211e6b5, 0x66d0fb02,
-  0x5e9f46bf, 0x5a5e5b08, 0x571d7dd1, 0x53dc6066,
-  0x4d9b3063, 0x495a2dd4, 0x44190b0d, 0x40d816ba,
-  0xaca5c697, 0xa864db20, 0xa527fdf9, 0xa1e6e04e,
-  0xbfa1b04b, 0xbb60adfc, 0xb6238b25, 0xb2e29692,
-  0x8aad2b2f, 0x8e6c3698, 0x832f1041, 0x87ee0df6,
-  0x99a95df3, 0x9d684044, 0x902b669d, 0x94ea7b2a,
-  0xe0b41de7, 0xe4750050, 0xe9362689, 0xedf73b3e,
-  0xf3b06b3b, 0xf771768c, 0xfa325055, 0xfef34de2,
-  0xc6bcf05f, 0xc27dede8, 0xcf3ecb31, 0xcbffd686,
-  0xd5b88683, 0xd1799b34, 0xdc3abded, 0xd8fba05a,
-  0x690ce0ee, 0x6dcdfd59, 0x608edb80, 0x644fc637,
-  0x7a089632, 0x7ec98b85, 0x738aad5c, 0x774bb0eb,
-  0x4f040d56, 0x4bc510e1, 0x46863638, 0x42472b8f,
-  0x5c007b8a, 0x58c1663d, 0x558240e4, 0x51435d53,
-  0x251d3b9e, 0x21dc2629, 0x2c9f00f0, 0x285e1d47,
-  0x36194d42, 0x32d850f5, 0x3f9b762c, 0x3b5a6b9b,
-  0x0315d626, 0x07d4cb91, 0x0a97ed48, 0x0e56f0ff,
-  0x1011a0fa, 0x14d0bd4d, 0x19939b94, 0x1d528623,
-  0xf12f560e, 0xf5ee4bb9, 0xf8ad6d60, 0xfc6c70d7,
-  0xe22b20d2, 0xe6ea3d65, 0xeba91bbc, 0xef68060b,
-  0xd727bbb6, 0xd3e6a601, 0xdea580d8, 0xda649d6f,
-  0xc423cd6a, 0xc0e2d0dd, 0xcda1f604, 0xc960ebb3,
-  0xbd3e8d7e, 0xb9ff90c9, 0xb4bcb610, 0xb07daba7,
-  0xae3afba2, 0xaafbe615, 0xa7b8c0cc, 0xa379dd7b,
-  0x9b3660c6, 0x9ff77d71, 0x92b45ba8, 0x9675461f,
-  0x8832161a, 0x8cf30bad, 0x81b02d74, 0x857130c3,
-  0x5d8a9099, 0x594b8d2e, 0x5408abf7, 0x50c9b640,
-  0x4e8ee645, 0x4a4ffbf2, 0x470cdd2b, 0x43cdc09c,
-  0x7b827d21, 0x7f436096, 0x7200464f, 0x76c15bf8,
-  0x68860bfd, 0x6c47164a, 0x61043093, 0x65c52d24,
-  0x119b4be9, 0x155a565e, 0x18197087, 0x1cd86d30,
-  0x029f3d35, 0x065e2082, 0x0b1d065b, 0x0fdc1bec,
-  0x3793a651, 0x3352bbe6, 0x3e119d3f, 0x3ad08088,
-  0x2497d08d, 0x2056cd3a, 0x2d15ebe3, 0x29d4f654,
-  0xc5a92679, 0xc1683bce, 0xcc2b1d17, 0xc8ea00a0,
-  0xd6ad50a5, 0xd26c4d12, 0xdf2f6bcb, 0xdbee767c,
-  0xe3a1cbc1, 0xe760d676, 0xea23f0af, 0xeee2ed18,
-  0xf0a5bd1d, 0xf464a0aa, 0xf9278673, 0xfde69bc4,
-  0x89b8fd09, 0x8d79e0be, 0x803ac667, 0x84fbdbd0,
-  0x9abc8bd5, 0x9e7d9662, 0x933eb0bb, 0x97ffad0c,
-  0xafb010b1, 0xab710d06, 0xa6322bdf, 0xa2f33668,
-  0xbcb4666d, 0xb8757bda, 0xb5365d03, 0xb1f740b4
+    bool                    b_released;     /* released by the handle */
+    unsigned int            i_used;         /* sections not returned yet */
+
+    dvbpsi_psi_section_t   *p_sections;     /* free section structures */
+    unsigned int            i_sections;
+
+    uint8_t                *p_data[DVBPSI_SECTION_POOL_CLASSES];
+    unsigned int            i_data[DVBPSI_SECTION_POOL_CLASSES];
 };
 
+/*****************************************************************************
+ * dvbpsi_section_pool_new
+ *****************************************************************************/
+dvbpsi_section_pool_t *dvbpsi_section_pool_new(void)
+{
+    return (dvbpsi_section_pool_t *)calloc(1, sizeof(dvbpsi_section_pool_t));
+}
+
+/*****************************************************************************
+ * dvbpsi_section_pool_free
+ *****************************************************************************/
+static void dvbpsi_section_pool_free(dvbpsi_section_pool_t *p_pool)
+{
+    while (p_pool->p_sections)
+    {
+        dvbpsi_psi_section_t *p_next = p_pool->p_sections->p_next;
+        free(p_pool->p_sections);
+        p_pool->p_sections = p_next;
+    }
+
+    for (int i = 0; i < DVBPSI_SECTION_POOL_CLASSES; i++)
+    {
+        while (p_pool->p_data[i])
+        {
+            uint8_t *p_next;
+            memcpy(&p_next, p_pool->p_data[i], sizeof(p_next));
+            free(p_pool->p_data[i]);
+            p_pool->p_data[i] = p_next;
+        }
+    }
+    free(p_pool);
+}
+
+/*****************************************************************************
+ * dvbpsi_section_pool_release
+ *****************************************************************************/
+void dvbpsi_section_pool_release(dvbpsi_section_pool_t *p_pool)
+{
+    if (!p_pool)
+        return;
+
+    p_pool->b_released = true;
+    if (p_pool->i_used == 0)
+        dvbpsi_section_pool_free(p_pool);
+}
+
+/*****************************************************************************
+ * dvbpsi_section_pool_data_get
+ *****************************************************************************
+ * Get a data buffer of at least i_size bytes, buffers bigger than the
+ * biggest class are not pooled.
+ *****************************************************************************/
+static uint8_t *dvbpsi_section_pool_data_get(dvbpsi_section_pool_t *p_pool,
+                                             const size_t i_size, int8_t *pi_class)
+{
+    int i_class = 0;
+    size_t i_class_size = DVBPSI_SECTION_POOL_MIN;
+
+    while (i_class_size < i_size)
+    {
+        i_class++;
+        i_class_size <<= 1;
+    }
+
+    if (i_class >= DVBPSI_SECTION_POOL_CLASSES)
+    {
+        *pi_class = -1;
+        return (uint8_t *)malloc(i_size);
+    }
+
+    *pi_class = i_class;
+    uint8_t *p_data = p_pool->p_data[i_class];
+    if (p_data)
+    {
+        memcpy(&p_pool->p_data[i_class], p_data, sizeof(uint8_t *));
+        p_pool->i_data[i_class]--;
+        return p_data;
+    }
+    return (uint8_t *)malloc(i_class_size);
+}
+
+/*****************************************************************************
+ * dvbpsi_section_pool_data_put
+ *****************************************************************************/
+static void dvbpsi_section_pool_data_put(dvbpsi_section_pool_t *p_pool,
+                                         uint8_t *p_data, const int8_t i_class)
+{
+    if (i_class < 0 || p_pool->b_released ||
+        p_pool->i_data[i_class] >= DVBPSI_SECTION_POOL_DEPTH)
+    {
+        free(p_data);
+        return;
+    }
+
+    memcpy(p_data, &p_pool->p_data[i_class], sizeof(uint8_t *));
+    p_pool->p_data[i_class] = p_data;
+    p_pool->i_data[i_class]++;
+}
+
+/*****************************************************************************
+ * dvbpsi_section_pool_get
+ *****************************************************************************/
+dvbpsi_psi_section_t *dvbpsi_section_pool_get(dvbpsi_section_pool_t *p_pool)
+{
+    assert(p_pool);
+    assert(!p_pool->b_released);
+
+    dvbpsi_psi_section_t *p_section = p_pool->p_sections;
+    if (p_section)
+    {
+        p_pool->p_sections = p_section->p_next;
+        p_pool->i_sections--;
+        memset(p_section, 0, sizeof(dvbpsi_psi_section_t));
+    }
+    else
+    {
+        p_section = (dvbpsi_psi_section_t *)calloc(1, sizeof(dvbpsi_psi_section_t));
+        if (p_section == NULL)
+            return NULL;
+    }
+
+    p_section->p_pool = p_pool;
+    p_section->i_pool_class = -1;
+    p_pool->i_used++;
+    return p_section;
+}
+
+/*****************************************************************************
+ * dvbpsi_section_pool_put
+ *****************************************************************************/
+static void dvbpsi_section_pool_put(dvbpsi_psi_section_t *p_section)
+{
+    dvbpsi_section_pool_t *p_pool = p_section->p_pool;
+
+    if (p_section->p_data != NULL && !p_section->b_data_view)
+        dvbpsi_section_pool_data_put(p_pool, p_section->p_data,
+                                     p_section->i_pool_class);
+
+    if (p_pool->b_released || p_pool->i_sections >= DVBPSI_SECTION_POOL_DEPTH)
+        free(p_section);
+    else
+    {
+        p_section->p_next = p_pool->p_sections;
+        p_pool->p_sections = p_section;
+        p_pool->i_sections++;
+    }
+
+    assert(p_pool->i_used > 0);
+    p_pool->i_used--;
+    if (p_pool->b_released && p_pool->i_used == 0)
+        dvbpsi_section_pool_free(p_pool);
+}
+
 /*****************************************************************************
  * dvbpsi_NewPSISection
  *****************************************************************************
@@ -175,7 +255,14 @@ void dvbpsi_DeletePSISections(dvbpsi_psi_section_t *p_section)
     {
         dvbpsi_psi_section_t* p_next = p_section->p_next;
 
-        if (p_section->p_data != NULL)
+        if (p_section->p_pool)
+        {
+            dvbpsi_section_pool_put(p_section);
+            p_section = p_next;
+            continue;
+        }
+
+        if (p_section->p_data != NULL && !p_section->b_data_view)
             free(p_section->p_data);
 
         free(p_section);
@@ -184,6 +271,59 @@ void dvbpsi_DeletePSISections(dvbpsi_psi_section_t *p_section)
     p_section = NULL;
 }
 
+/*****************************************************************************
+ * dvbpsi_section_data_alloc
+ *****************************************************************************
+ * Replace the data a section points to by a buffer of its own.
+ *****************************************************************************/
+bool dvbpsi_section_data_alloc(dvbpsi_psi_section_t *p_section,
+                               const size_t i_size, const size_t i_copy)
+{
+    assert(p_section->b_data_view);
+    assert(i_copy <= i_size);
+
+    uint8_t *p_data;
+    if (p_section->p_pool)
+        p_data = dvbpsi_section_pool_data_get(p_section->p_pool, i_size,
+                                              &p_section->i_pool_class);
+    else
+        p_data = (uint8_t *)malloc(i_size);
+    if (p_data == NULL)
+        return false;
+    memcpy(p_data, p_section->p_data, i_copy);
+
+    /* Rebase the payload pointers */
+    if (p_section->p_payload_start)
+        p_section->p_payload_start = p_data +
+                    (p_section->p_payload_start - p_section->p_data);
+    p_section->p_payload_end = p_data +
+                    (p_section->p_payload_end - p_section->p_data);
+    p_section->p_data = p_data;
+    p_section->b_data_view = false;
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_OwnPSISections
+ *****************************************************************************
+ * Copy the section data still pointing into a TS packet.
+ *****************************************************************************/
+bool dvbpsi_OwnPSISections(dvbpsi_psi_section_t *p_section)
+{
+    bool b_ret = true;
+
+    for (; p_section != NULL; p_section = p_section->p_next)
+    {
+        if (!p_section->b_data_view)
+            continue;
+
+        size_t i_size = 3 + p_section->i_length;
+        if (!dvbpsi_section_data_alloc(p_section, i_size, i_size))
+            b_ret = false;
+    }
+    return b_ret;
+}
+
 /*****************************************************************************
  * dvbpsi_CheckPSISection
  *****************************************************************************
@@ -230,14 +370,8 @@ bool dvbpsi_CheckPSISection(dvbpsi_t *p_dvbpsi, dvbpsi_psi_section_t *p_section,
  *****************************************************************************/
 bool dvbpsi_ValidPSISection(dvbpsi_psi_section_t* p_section)
 {
-    uint32_t i_crc = 0xffffffff;
-    uint8_t* p_byte = p_section->p_data;
-
-    while(p_byte < p_section->p_payload_end + 4)
-    {
-        i_crc = (i_crc << 8) ^ dvbpsi_crc32_table[(i_crc >> 24) ^ (*p_byte)];
-        p_byte++;
-    }
+    uint32_t i_crc = dvbpsi_crc32(0xffffffff, p_section->p_data,
+                    p_section->p_payload_end + 4 - p_section->p_data);
 
     if (i_crc == 0)
         return true;
@@ -252,15 +386,8 @@ bool dvbpsi_ValidPSISection(dvbpsi_psi_section_t* p_section)
  *****************************************************************************/
 void dvbpsi_CalculateCRC32(dvbpsi_psi_section_t *p_section)
 {
-    uint8_t* p_byte = p_section->p_data;
-    p_section->i_crc = 0xffffffff;
-
-    while (p_byte < p_section->p_payload_end)
-    {
-        p_section->i_crc =   (p_section->i_crc << 8)
-                           ^ dvbpsi_crc32_table[(p_section->i_crc >> 24) ^ (*p_byte)];
-        p_byte++;
-    }
+    p_section->i_crc = dvbpsi_crc32(0xffffffff, p_section->p_data,
+                            p_section->p_payload_end - p_section->p_data);
 
     p_section->p_payload_end[0] = (p_section->i_crc >> 24) & 0xff;
     p_section->p_payload_end[1] = (p_section->i_crc >> 16) & 0xff;
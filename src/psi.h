@@ -64,6 +64,11 @@ extern "C" {
  * dvbpsi_psi_section_s::b_current_next, dvbpsi_psi_section_s::i_number,
  * dvbpsi_psi_section_s::i_last_number, and dvbpsi_psi_section_s::i_crc are
  * undefined.
+ *
+ * When dvbpsi_psi_section_s::b_data_view is true, dvbpsi_psi_section_s::p_data
+ * points into the TS packet given to dvbpsi_packet_push() and is only valid
+ * until that call returns (@see dvbpsi_s::b_zero_copy), or into a table
+ * decoded from the section (@see dvbpsi_s::b_zero_copy_descriptors).
  */
 struct dvbpsi_psi_section_s
 {
@@ -87,6 +92,15 @@ struct dvbpsi_psi_section_s
   uint8_t *     p_data;                 /*!< complete section */
   uint8_t *     p_payload_start;        /*!< payload start */
   uint8_t *     p_payload_end;          /*!< payload end */
+  bool          b_data_view;            /*!< p_data is not owned by the
+                                             section */
+
+  /* memory handling, private to libdvbpsi */
+  struct dvbpsi_section_pool_s *        p_pool;         /*!< pool the section
+                                                             returns to, NULL
+                                                             if not pooled */
+  int8_t        i_pool_class;           /*!< size class of p_data in
+                                             p_pool, -1 if not pooled */
 
   /* used if b_syntax_indicator is true */
   uint32_t      i_crc;                  /*!< CRC_32 */
@@ -118,6 +132,23 @@ dvbpsi_psi_section_t * dvbpsi_NewPSISection(int i_max_size);
  */
 void dvbpsi_DeletePSISections(dvbpsi_psi_section_t * p_section);
 
+/*****************************************************************************
+ * dvbpsi_OwnPSISections
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_OwnPSISections(dvbpsi_psi_section_t * p_section)
+ * \brief Copy the data of sections that point into a TS packet, so that they
+ * can be kept after dvbpsi_packet_push() returns.
+ * \param p_section pointer to the first PSI section structure
+ * \return true on success, false if a copy failed. Sections which could not
+ * be copied still point into the TS packet.
+ *
+ * Sections kept in dvbpsi_decoder_t::p_sections are copied by libdvbpsi,
+ * a decoder keeping sections elsewhere must call this function before
+ * returning from its gather callback.
+ */
+bool dvbpsi_OwnPSISections(dvbpsi_psi_section_t * p_section);
+
 /*****************************************************************************
  * dvbpsi_CheckPSISection
  *****************************************************************************/
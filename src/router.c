@@ -0,0 +1,328 @@
+/*****************************************************************************
+ * router.c: TS packet router
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+#include <assert.h>
+
+#include "dvbpsi.h"
+#include "dvbpsi_private.h"
+#include "router.h"
+
+/*****************************************************************************
+ * dvbpsi_router_route_t
+ *****************************************************************************
+ * One handle registered for a PID. p_dvbpsi is NULL once the route has been
+ * removed during a dispatch, the route is freed when the dispatch ends.
+ *****************************************************************************/
+typedef struct dvbpsi_router_route_s
+{
+    dvbpsi_t                        *p_dvbpsi;
+
+    struct dvbpsi_router_route_s    *p_next;
+} dvbpsi_router_route_t;
+
+/*****************************************************************************
+ * dvbpsi_router_s
+ *****************************************************************************/
+struct dvbpsi_router_s
+{
+    dvbpsi_router_route_t   *p_routes[DVBPSI_ROUTER_PIDS];
+
+    int                     i_dispatching;  /* Nested dispatches */
+    bool                    b_removed;      /* Routes removed while dispatching */
+};
+
+/*****************************************************************************
+ * dvbpsi_router_new
+ *****************************************************************************/
+dvbpsi_router_t *dvbpsi_router_new(void)
+{
+    return (dvbpsi_router_t *)calloc(1, sizeof(dvbpsi_router_t));
+}
+
+/*****************************************************************************
+ * dvbpsi_router_delete
+ *****************************************************************************/
+void dvbpsi_router_delete(dvbpsi_router_t *p_router)
+{
+    if (!p_router)
+        return;
+
+    for (int i = 0; i < DVBPSI_ROUTER_PIDS; i++)
+    {
+        dvbpsi_router_route_t *p_route = p_router->p_routes[i];
+        while (p_route)
+        {
+            dvbpsi_router_route_t *p_next = p_route->p_next;
+            free(p_route);
+            p_route = p_next;
+        }
+    }
+    free(p_router);
+}
+
+/*****************************************************************************
+ * dvbpsi_router_add
+ *****************************************************************************/
+bool dvbpsi_router_add(dvbpsi_router_t *p_router, const uint16_t i_pid,
+                       dvbpsi_t *p_dvbpsi)
+{
+    assert(p_router);
+    assert(p_dvbpsi);
+
+    if (i_pid >= DVBPSI_ROUTER_PIDS)
+        return false;
+
+    for (dvbpsi_router_route_t *p = p_router->p_routes[i_pid]; p; p = p->p_next)
+    {
+        if (p->p_dvbpsi == p_dvbpsi)
+            return false;
+    }
+
+    dvbpsi_router_route_t *p_route = malloc(sizeof(dvbpsi_router_route_t));
+    if (p_route == NULL)
+        return false;
+
+    /* Insert at the head, so that a route added from within a table
+     * callback does not disturb the walk over the current list. */
+    p_route->p_dvbpsi = p_dvbpsi;
+    p_route->p_next = p_router->p_routes[i_pid];
+    p_router->p_routes[i_pid] = p_route;
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_router_remove
+ *****************************************************************************/
+bool dvbpsi_router_remove(dvbpsi_router_t *p_router, const uint16_t i_pid,
+                          dvbpsi_t *p_dvbpsi)
+{
+    assert(p_router);
+    assert(p_dvbpsi);
+
+    if (i_pid >= DVBPSI_ROUTER_PIDS)
+        return false;
+
+    dvbpsi_router_route_t **pp_route = &p_router->p_routes[i_pid];
+    while (*pp_route)
+    {
+        dvbpsi_router_route_t *p_route = *pp_route;
+        if (p_route->p_dvbpsi == p_dvbpsi)
+        {
+            if (p_router->i_dispatching > 0)
+            {
+                /* The dispatch may be walking this route */
+                p_route->p_dvbpsi = NULL;
+                p_router->b_removed = true;
+                return true;
+            }
+            *pp_route = p_route->p_next;
+            free(p_route);
+            return true;
+        }
+        pp_route = &p_route->p_next;
+    }
+    return false;
+}
+
+/*****************************************************************************
+ * dvbpsi_router_purge
+ *****************************************************************************
+ * Free the routes removed during a dispatch.
+ *****************************************************************************/
+static void dvbpsi_router_purge(dvbpsi_router_t *p_router)
+{
+    for (int i = 0; i < DVBPSI_ROUTER_PIDS; i++)
+    {
+        dvbpsi_router_route_t **pp_route = &p_router->p_routes[i];
+        while (*pp_route)
+        {
+            dvbpsi_router_route_t *p_route = *pp_route;
+            if (p_route->p_dvbpsi == NULL)
+            {
+                *pp_route = p_route->p_next;
+                free(p_route);
+            }
+            else
+                pp_route = &p_route->p_next;
+        }
+    }
+    p_router->b_removed = false;
+}
+
+/*****************************************************************************
+ * dvbpsi_router_dispatch
+ *****************************************************************************
+ * Give a TS packet with a valid sync byte to all handles of its PID.
+ * p_extra is the TP_extra_header of an M2TS packet, NULL otherwise.
+ * The table callbacks may add and remove routes: removed routes are kept
+ * until the outermost dispatch ends.
+ *****************************************************************************/
+static inline bool dvbpsi_router_dispatch(dvbpsi_router_t *p_router, uint8_t *p_data,
+                                          const uint8_t *p_extra, bool *pb_routed)
+{
+    uint16_t i_pid = ((uint16_t)(p_data[1] & 0x1f) << 8) | p_data[2];
+    dvbpsi_router_route_t *p_route = p_router->p_routes[i_pid];
+    bool b_handled = false;
+
+    *pb_routed = (p_route != NULL);
+    if (p_route == NULL)
+        return false;
+
+    p_router->i_dispatching++;
+    for (; p_route; p_route = p_route->p_next)
+    {
+        dvbpsi_t *p_dvbpsi = p_route->p_dvbpsi;
+        if (p_dvbpsi == NULL)
+            continue;
+        if (p_extra)
+            p_dvbpsi->i_arrival_time = dvbpsi_m2ts_arrival_time(p_extra);
+        if (dvbpsi_packet_decode(p_dvbpsi, p_data))
+            b_handled = true;
+    }
+    p_router->i_dispatching--;
+
+    if (p_router->b_removed && p_router->i_dispatching == 0)
+        dvbpsi_router_purge(p_router);
+    return b_handled;
+}
+
+/*****************************************************************************
+ * dvbpsi_router_packet_push
+ *****************************************************************************/
+bool dvbpsi_router_packet_push(dvbpsi_router_t *p_router, uint8_t *p_data)
+{
+    bool b_routed;
+
+    assert(p_router);
+
+    /* TS start code */
+    if (p_data[0] != 0x47)
+        return false;
+
+    return dvbpsi_router_dispatch(p_router, p_data, NULL, &b_routed);
+}
+
+/*****************************************************************************
+ * dvbpsi_router_packets_push
+ *****************************************************************************/
+bool dvbpsi_router_packets_push(dvbpsi_router_t *p_router,
+                                uint8_t *p_data, const size_t i_packets,
+                                dvbpsi_packets_stats_t *p_stats)
+{
+    return dvbpsi_router_packets_push_stride(p_router, p_data, i_packets,
+                                             DVBPSI_STRIDE_TS, p_stats);
+}
+
+/*****************************************************************************
+ * dvbpsi_router_packets_push_stride
+ *****************************************************************************/
+bool dvbpsi_router_packets_push_stride(dvbpsi_router_t *p_router,
+                                       uint8_t *p_data, const size_t i_packets,
+                                       const dvbpsi_packet_stride_t i_stride,
+                                       dvbpsi_packets_stats_t *p_stats)
+{
+    dvbpsi_packets_stats_t stats = { 0, 0, 0, 0, 0, 0 };
+    const size_t i_offset = dvbpsi_packet_stride_offset(i_stride);
+    const bool b_m2ts = (i_stride == DVBPSI_STRIDE_M2TS);
+
+    assert(p_router);
+    assert(i_stride == DVBPSI_STRIDE_TS || i_stride == DVBPSI_STRIDE_M2TS
+        || i_stride == DVBPSI_STRIDE_RS);
+
+    uint8_t *p_end = p_data + i_packets * i_stride;
+    for (uint8_t *p_packet = p_data; p_packet < p_end; p_packet += i_stride)
+    {
+        uint8_t *p = p_packet + i_offset;
+        bool b_routed;
+
+        stats.i_packets++;
+
+        /* TS start code */
+        if (p[0] != 0x47)
+        {
+            stats.i_sync_errors++;
+            continue;
+        }
+
+        if (dvbpsi_router_dispatch(p_router, p, b_m2ts ? p_packet : NULL,
+                                   &b_routed))
+            stats.i_handled++;
+        if (b_routed)
+            stats.i_pushed++;
+        else
+            stats.i_skipped++;
+    }
+
+    if (p_stats)
+        *p_stats = stats;
+    return (stats.i_sync_errors == 0);
+}
+
+/*****************************************************************************
+ * dvbpsi_router_stream_push
+ *****************************************************************************/
+size_t dvbpsi_router_stream_push(dvbpsi_router_t *p_router,
+                                 uint8_t *p_data, const size_t i_size,
+                                 const dvbpsi_packet_stride_t i_stride,
+                                 dvbpsi_packets_stats_t *p_stats)
+{
+    dvbpsi_packets_stats_t stats = { 0, 0, 0, 0, 0, 0 };
+    size_t i_pos = 0;
+
+    assert(p_router);
+
+    while (i_pos < i_size)
+    {
+        dvbpsi_packets_stats_t run;
+        size_t i_packets;
+
+        size_t i_lost = dvbpsi_packets_sync(p_data + i_pos, i_size - i_pos,
+                                            i_stride, &i_packets);
+        stats.i_lost_bytes += i_lost;
+        i_pos += i_lost;
+        if (i_packets == 0)
+            break;
+
+        dvbpsi_router_packets_push_stride(p_router, p_data + i_pos, i_packets,
+                                          i_stride, &run);
+        dvbpsi_packets_stats_add(&stats, &run);
+        i_pos += i_packets * i_stride;
+    }
+
+    if (p_stats)
+        *p_stats = stats;
+    return i_pos;
+}
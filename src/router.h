@@ -0,0 +1,210 @@
+/*****************************************************************************
+ * router.h
+ *
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *****************************************************************************/
+
+/*!
+ * \file <router.h>
+ * \brief TS packet router.
+ *
+ * The router hands each TS packet to the dvbpsi_t handles registered for
+ * its PID. The lookup is done in a table indexed by PID, packets of
+ * PIDs without a registered handle are dropped immediately.
+ */
+
+#ifndef _DVBPSI_ROUTER_H_
+#define _DVBPSI_ROUTER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \def DVBPSI_ROUTER_PIDS
+ * \brief Number of PIDs in a transport stream
+ */
+#define DVBPSI_ROUTER_PIDS 8192
+
+/*****************************************************************************
+ * dvbpsi_router_t
+ *****************************************************************************/
+/*!
+ * \typedef struct dvbpsi_router_s dvbpsi_router_t
+ * \brief TS packet router structure abstraction.
+ */
+typedef struct dvbpsi_router_s dvbpsi_router_t;
+
+/*****************************************************************************
+ * dvbpsi_router_new
+ *****************************************************************************/
+/*!
+ * \fn dvbpsi_router_t *dvbpsi_router_new(void)
+ * \brief Create a new TS packet router without any registered handle.
+ * \return pointer to the router, NULL on failure
+ */
+dvbpsi_router_t *dvbpsi_router_new(void);
+
+/*****************************************************************************
+ * dvbpsi_router_delete
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_router_delete(dvbpsi_router_t *p_router)
+ * \brief Delete a TS packet router.
+ * \param p_router pointer to the router
+ * \return nothing
+ *
+ * The registered dvbpsi_t handles are not owned by the router, they must
+ * be detached and deleted by the application.
+ */
+void dvbpsi_router_delete(dvbpsi_router_t *p_router);
+
+/*****************************************************************************
+ * dvbpsi_router_add
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_router_add(dvbpsi_router_t *p_router, const uint16_t i_pid,
+                              dvbpsi_t *p_dvbpsi)
+ * \brief Register a dvbpsi_t handle for a PID.
+ * \param p_router pointer to the router
+ * \param i_pid PID of the TS packets to give to the handle
+ * \param p_dvbpsi handle with an attached decoder
+ * \return true on success, false on failure or if p_dvbpsi is already
+ * registered for i_pid.
+ *
+ * Several handles may be registered for one PID and one handle may be
+ * registered for several PIDs. Handles may be registered from within a
+ * table callback.
+ */
+bool dvbpsi_router_add(dvbpsi_router_t *p_router, const uint16_t i_pid,
+                       dvbpsi_t *p_dvbpsi);
+
+/*****************************************************************************
+ * dvbpsi_router_remove
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_router_remove(dvbpsi_router_t *p_router, const uint16_t i_pid,
+                                 dvbpsi_t *p_dvbpsi)
+ * \brief Unregister a dvbpsi_t handle for a PID.
+ * \param p_router pointer to the router
+ * \param i_pid PID the handle was registered for
+ * \param p_dvbpsi handle to unregister
+ * \return true on success, false if p_dvbpsi was not registered for i_pid.
+ *
+ * Handles may be unregistered from within a table callback, the handle of
+ * the callback included. Once unregistered, a handle is not given the
+ * remaining packets of the buffer being pushed and may be deleted, except
+ * from its own table callback.
+ */
+bool dvbpsi_router_remove(dvbpsi_router_t *p_router, const uint16_t i_pid,
+                          dvbpsi_t *p_dvbpsi);
+
+/*****************************************************************************
+ * dvbpsi_router_packet_push
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_router_packet_push(dvbpsi_router_t *p_router, uint8_t *p_data)
+ * \brief Injection of a TS packet into the decoders registered for its PID.
+ * \param p_router pointer to the router
+ * \param p_data pointer to a 188 bytes TS packet
+ * \return true when the packet has been handled by at least one decoder,
+ * false otherwise.
+ */
+bool dvbpsi_router_packet_push(dvbpsi_router_t *p_router, uint8_t *p_data);
+
+/*****************************************************************************
+ * dvbpsi_router_packets_push
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_router_packets_push(dvbpsi_router_t *p_router,
+                                       uint8_t *p_data, const size_t i_packets,
+                                       dvbpsi_packets_stats_t *p_stats)
+ * \brief Injection of a buffer of contiguous TS packets into the decoders
+ * registered for their PIDs.
+ * \param p_router pointer to the router
+ * \param p_data pointer to i_packets * 188 bytes of TS packets
+ * \param i_packets number of TS packets in p_data
+ * \param p_stats pointer to counters for this call, may be NULL. A packet
+ * given to several handles is counted once.
+ * \return true when all packets have been examined, false when a packet
+ * without sync byte was found.
+ */
+bool dvbpsi_router_packets_push(dvbpsi_router_t *p_router,
+                                uint8_t *p_data, const size_t i_packets,
+                                dvbpsi_packets_stats_t *p_stats);
+
+/*****************************************************************************
+ * dvbpsi_router_packets_push_stride
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_router_packets_push_stride(dvbpsi_router_t *p_router,
+                                              uint8_t *p_data, const size_t i_packets,
+                                              const dvbpsi_packet_stride_t i_stride,
+                                              dvbpsi_packets_stats_t *p_stats)
+ * \brief Injection of a buffer of contiguous 188, 192 or 204 bytes packets
+ * into the decoders registered for their PIDs.
+ * \param p_router pointer to the router
+ * \param p_data pointer to i_packets * i_stride bytes of packets
+ * \param i_packets number of packets in p_data
+ * \param i_stride size and layout of the packets
+ * \param p_stats pointer to counters for this call, may be NULL
+ * \return true when all packets have been examined, false when a packet
+ * without sync byte was found.
+ *
+ * With DVBPSI_STRIDE_M2TS, the arrival_time_stamp of each TS packet is set
+ * in dvbpsi_t::i_arrival_time of the handles it is given to, see
+ * dvbpsi_packets_push_stride().
+ */
+bool dvbpsi_router_packets_push_stride(dvbpsi_router_t *p_router,
+                                       uint8_t *p_data, const size_t i_packets,
+                                       const dvbpsi_packet_stride_t i_stride,
+                                       dvbpsi_packets_stats_t *p_stats);
+
+/*****************************************************************************
+ * dvbpsi_router_stream_push
+ *****************************************************************************/
+/*!
+ * \fn size_t dvbpsi_router_stream_push(dvbpsi_router_t *p_router,
+                                        uint8_t *p_data, const size_t i_size,
+                                        const dvbpsi_packet_stride_t i_stride,
+                                        dvbpsi_packets_stats_t *p_stats)
+ * \brief Injection of a buffer of transport stream bytes into the decoders
+ * registered for the PIDs of its packets.
+ * \param p_router pointer to the router
+ * \param p_data pointer to the buffer, it does not need to start at a packet
+ * \param i_size size of the buffer in bytes
+ * \param i_stride size and layout of the packets
+ * \param p_stats pointer to counters for this call, may be NULL
+ * \return number of bytes used. The remaining bytes must be given again
+ * with the following bytes of the stream.
+ *
+ * Same as dvbpsi_stream_push() for all the PIDs of the router.
+ */
+size_t dvbpsi_router_stream_push(dvbpsi_router_t *p_router,
+                                 uint8_t *p_data, const size_t i_size,
+                                 const dvbpsi_packet_stride_t i_stride,
+                                 dvbpsi_packets_stats_t *p_stats);
+
+#ifdef __cplusplus
+};
+#endif
+
+#else
+#error "Multiple inclusions of router.h"
+#endif
@@ -0,0 +1,222 @@
+/*****************************************************************************
+ * sync.c: TS packet synchronisation
+ *----------------------------------------------------------------------------
+ * Copyright (C) 2026 VideoLAN
+ * $Id$
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ *----------------------------------------------------------------------------
+ *
+ *****************************************************************************/
+
+#include "config.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(HAVE_INTTYPES_H)
+#include <inttypes.h>
+#elif defined(HAVE_STDINT_H)
+#include <stdint.h>
+#endif
+
+#include <assert.h>
+
+/* The runtime dispatch publishes the selected scan with atomic builtins */
+#if defined(HAVE_X86_AVX2) && !defined(HAVE_ATOMIC_BUILTINS)
+#undef HAVE_X86_AVX2
+#endif
+
+#ifdef HAVE_X86_AVX2
+#include <immintrin.h>
+#endif
+
+#include "dvbpsi.h"
+#include "dvbpsi_private.h"
+
+/* Number of sync bytes in a row at the packet stride needed to acquire the
+ * synchronisation */
+#define DVBPSI_SYNC_LOCK 3
+
+/*****************************************************************************
+ * dvbpsi_sync_locked
+ *****************************************************************************
+ * Number of sync bytes found in a row at i_stride from p_sync, looking at
+ * no more than i_max packets.
+ *****************************************************************************/
+static inline size_t dvbpsi_sync_locked(const uint8_t *p_sync, const size_t i_stride,
+                                        const size_t i_max)
+{
+    size_t i = 0;
+    while (i < i_max && p_sync[i * i_stride] == 0x47)
+        i++;
+    return i;
+}
+
+/*****************************************************************************
+ * dvbpsi_sync_scan
+ *****************************************************************************
+ * First packet start i < i_end at which DVBPSI_SYNC_LOCK sync bytes are
+ * found in a row, i_end if there is none. Packet starts up to i_end must have
+ * DVBPSI_SYNC_LOCK complete packets in the buffer. memchr() is vectorized by
+ * the C library.
+ *****************************************************************************/
+static size_t dvbpsi_sync_scan(const uint8_t *p_sync, size_t i, const size_t i_end,
+                               const size_t i_stride)
+{
+    while (i < i_end)
+    {
+        const uint8_t *p = memchr(&p_sync[i], 0x47, i_end - i);
+        if (p == NULL)
+            break;
+
+        i = p - p_sync;
+        if (dvbpsi_sync_locked(&p_sync[i], i_stride, DVBPSI_SYNC_LOCK) == DVBPSI_SYNC_LOCK)
+            return i;
+        i++;
+    }
+    return i_end;
+}
+
+/*****************************************************************************
+ * dvbpsi_sync_acquire_cb
+ *****************************************************************************/
+typedef size_t (* dvbpsi_sync_acquire_cb)(const uint8_t *p_sync, size_t i,
+                                          const size_t i_end, const size_t i_stride);
+
+#ifdef HAVE_X86_AVX2
+/*****************************************************************************
+ * dvbpsi_sync_acquire_avx2
+ *****************************************************************************
+ * Look for sync bytes at the same position in two packets in a row, 128
+ * positions at once. Outside of a transport stream this is rare, the blocks
+ * where it happens are checked by dvbpsi_sync_scan().
+ *****************************************************************************/
+__attribute__((target("avx2")))
+static size_t dvbpsi_sync_acquire_avx2(const uint8_t *p_sync, size_t i,
+                                       const size_t i_end, const size_t i_stride)
+{
+    const __m256i sync = _mm256_set1_epi8(0x47);
+
+    while (i + 128 <= i_end)
+    {
+        __m256i any = _mm256_setzero_si256();
+        for (int j = 0; j < 128; j += 32)
+        {
+            __m256i first = _mm256_loadu_si256((const __m256i *)&p_sync[i + j]);
+            __m256i second = _mm256_loadu_si256((const __m256i *)&p_sync[i + j + i_stride]);
+            any = _mm256_or_si256(any, _mm256_and_si256(_mm256_cmpeq_epi8(first, sync),
+                                                        _mm256_cmpeq_epi8(second, sync)));
+        }
+
+        if (_mm256_movemask_epi8(any))
+        {
+            size_t i_found = dvbpsi_sync_scan(p_sync, i, i + 128, i_stride);
+            if (i_found < i + 128)
+                return i_found;
+        }
+        i += 128;
+    }
+
+    return dvbpsi_sync_scan(p_sync, i, i_end, i_stride);
+}
+#endif
+
+#ifdef HAVE_ATOMIC_BUILTINS
+/*****************************************************************************
+ * dvbpsi_sync_select
+ *****************************************************************************
+ * Select the fastest implementation on the first call. Threads racing on
+ * the first calls select the same one, the pointer is read and written
+ * atomically.
+ *****************************************************************************/
+static size_t dvbpsi_sync_select(const uint8_t *p_sync, size_t i,
+                                 const size_t i_end, const size_t i_stride);
+
+static dvbpsi_sync_acquire_cb pf_dvbpsi_sync_acquire = dvbpsi_sync_select;
+
+static size_t dvbpsi_sync_select(const uint8_t *p_sync, size_t i,
+                                 const size_t i_end, const size_t i_stride)
+{
+    dvbpsi_sync_acquire_cb pf_acquire = dvbpsi_sync_scan;
+
+#ifdef HAVE_X86_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        pf_acquire = dvbpsi_sync_acquire_avx2;
+#endif
+
+    __atomic_store_n(&pf_dvbpsi_sync_acquire, pf_acquire, __ATOMIC_RELEASE);
+    return pf_acquire(p_sync, i, i_end, i_stride);
+}
+#endif
+
+/*****************************************************************************
+ * dvbpsi_sync_acquire
+ *****************************************************************************/
+static inline size_t dvbpsi_sync_acquire(const uint8_t *p_sync, size_t i,
+                                         const size_t i_end, const size_t i_stride)
+{
+#ifdef HAVE_ATOMIC_BUILTINS
+    dvbpsi_sync_acquire_cb pf_acquire = __atomic_load_n(&pf_dvbpsi_sync_acquire,
+                                                        __ATOMIC_ACQUIRE);
+    return pf_acquire(p_sync, i, i_end, i_stride);
+#else
+    return dvbpsi_sync_scan(p_sync, i, i_end, i_stride);
+#endif
+}
+
+/*****************************************************************************
+ * dvbpsi_packets_sync
+ *****************************************************************************/
+size_t dvbpsi_packets_sync(const uint8_t *p_data, const size_t i_size,
+                           const dvbpsi_packet_stride_t i_stride, size_t *pi_packets)
+{
+    assert(p_data);
+    assert(pi_packets);
+    assert(i_stride == DVBPSI_STRIDE_TS || i_stride == DVBPSI_STRIDE_M2TS
+        || i_stride == DVBPSI_STRIDE_RS);
+
+    /* Work on the positions of the sync bytes, i is a packet start */
+    const size_t i_offset = dvbpsi_packet_stride_offset(i_stride);
+    const uint8_t *p_sync = p_data + i_offset;
+    size_t i = 0;
+
+    *pi_packets = 0;
+    if (i_size < i_stride)
+        return 0;
+
+    /* Packet starts with DVBPSI_SYNC_LOCK complete packets */
+    if (i_size >= DVBPSI_SYNC_LOCK * i_stride)
+    {
+        const size_t i_end = i_size - DVBPSI_SYNC_LOCK * i_stride + 1;
+        i = dvbpsi_sync_acquire(p_sync, 0, i_end, i_stride);
+        if (i < i_end)
+        {
+            *pi_packets = dvbpsi_sync_locked(&p_sync[i], i_stride,
+                                             (i_size - i) / i_stride);
+            return i;
+        }
+    }
+
+    /* The last packet starts cannot be checked on DVBPSI_SYNC_LOCK packets
+     * yet: keep the bytes that may start a packet, including a
+     * TP_extra_header without its sync byte, to check them with the next
+     * buffer */
+    const uint8_t *p = memchr(&p_sync[i], 0x47, i_size - i_offset - i);
+    return p ? (size_t)(p - p_sync) : i_size - i_offset;
+}
@@ -57,6 +57,7 @@ typedef struct dvbpsi_atsc_eit_decoder_s
 
 
 static dvbpsi_atsc_eit_event_t *dvbpsi_atsc_EITAddEvent(dvbpsi_atsc_eit_t* p_eit,
+                                            dvbpsi_atsc_eit_event_t **pp_last,
                                             uint16_t i_event_id,
                                             uint32_t i_start_time,
                                             uint8_t  i_etm_location,
@@ -66,6 +67,7 @@ static dvbpsi_atsc_eit_event_t *dvbpsi_atsc_EITAddEvent(dvbpsi_atsc_eit_t* p_eit
 
 static dvbpsi_descriptor_t *dvbpsi_atsc_EITChannelAddDescriptor(
                                                dvbpsi_atsc_eit_event_t *p_table,
+                                               dvbpsi_descriptor_t **pp_last,
                                                uint8_t i_tag, uint8_t i_length,
                                                uint8_t *p_data);
 
@@ -224,9 +226,11 @@ void dvbpsi_atsc_DeleteEIT(dvbpsi_atsc_eit_t *p_eit)
 /*****************************************************************************
  * dvbpsi_atsc_EITAddChannel
  *****************************************************************************
- * Add a Channel description at the end of the EIT.
+ * Add a Channel description at the end of the EIT, *pp_last is the last
+ * event added or NULL.
  *****************************************************************************/
 static dvbpsi_atsc_eit_event_t *dvbpsi_atsc_EITAddEvent(dvbpsi_atsc_eit_t* p_eit,
+                                            dvbpsi_atsc_eit_event_t **pp_last,
                                             uint16_t i_event_id,
                                             uint32_t i_start_time,
                                             uint8_t  i_etm_location,
@@ -255,11 +259,13 @@ static dvbpsi_atsc_eit_event_t *dvbpsi_atsc_EITAddEvent(dvbpsi_atsc_eit_t* p_eit
     }
     else
     {
-      dvbpsi_atsc_eit_event_t * p_last_event = p_eit->p_first_event;
+      dvbpsi_atsc_eit_event_t * p_last_event = *pp_last ? *pp_last
+                                                        : p_eit->p_first_event;
       while(p_last_event->p_next != NULL)
         p_last_event = p_last_event->p_next;
       p_last_event->p_next = p_event;
     }
+    *pp_last = p_event;
   }
 
   return p_event;
@@ -272,6 +278,7 @@ static dvbpsi_atsc_eit_event_t *dvbpsi_atsc_EITAddEvent(dvbpsi_atsc_eit_t* p_eit
  *****************************************************************************/
 static dvbpsi_descriptor_t *dvbpsi_atsc_EITChannelAddDescriptor(
                                                dvbpsi_atsc_eit_event_t *p_event,
+                                               dvbpsi_descriptor_t **pp_last,
                                                uint8_t i_tag, uint8_t i_length,
                                                uint8_t *p_data)
 {
@@ -280,12 +287,7 @@ static dvbpsi_descriptor_t *dvbpsi_atsc_EITChannelAddDescriptor(
     if (p_descriptor == NULL)
         return NULL;
 
-    p_event->p_first_descriptor = dvbpsi_AddDescriptor(p_event->p_first_descriptor,
-                                                       p_descriptor);
-    assert(p_event->p_first_descriptor);
-    if (p_event->p_first_descriptor == NULL)
-        return NULL;
-
+    dvbpsi_descriptor_append(&p_event->p_first_descriptor, pp_last, p_descriptor);
     return p_descriptor;
 }
 
@@ -403,7 +405,7 @@ static void dvbpsi_atsc_GatherEITSections(dvbpsi_t * p_dvbpsi,
     }
 
     /* TS discontinuity check */
-    if (p_demux->b_discontinuity)
+    if (p_demux->b_discontinuity || p_eit_decoder->b_discontinuity)
     {
         dvbpsi_ReInitEIT(p_eit_decoder, true);
         p_eit_decoder->b_discontinuity = false;
@@ -493,6 +495,7 @@ static void dvbpsi_atsc_GatherEITSections(dvbpsi_t * p_dvbpsi,
 static void dvbpsi_atsc_DecodeEITSections(dvbpsi_atsc_eit_t* p_eit,
                               dvbpsi_psi_section_t* p_section)
 {
+  dvbpsi_atsc_eit_event_t *p_last_event = NULL;
   uint8_t *p_byte, *p_end;
 
   while(p_section)
@@ -506,6 +509,7 @@ static void dvbpsi_atsc_DecodeEITSections(dvbpsi_atsc_eit_t* p_eit,
         i_events_count ++)
     {
         dvbpsi_atsc_eit_event_t* p_event;
+        dvbpsi_descriptor_t *p_last_descriptor = NULL;
         uint16_t i_event_id          = ((uint16_t)(p_byte[0] & 0x3f) << 8) | ((uint16_t) p_byte[1]);
         uint32_t i_start_time        = ((uint32_t)(p_byte[2] << 24)) |
                                        ((uint32_t)(p_byte[3] << 16)) |
@@ -518,7 +522,7 @@ static void dvbpsi_atsc_DecodeEITSections(dvbpsi_atsc_eit_t* p_eit,
         uint8_t  i_title_length      = p_byte[9];
 
         p_byte += 10;
-        p_event = dvbpsi_atsc_EITAddEvent(p_eit, i_event_id, i_start_time,
+        p_event = dvbpsi_atsc_EITAddEvent(p_eit, &p_last_event, i_event_id, i_start_time,
                                 i_etm_location, i_length_seconds, i_title_length,
                                 p_byte);
         p_byte += i_title_length;
@@ -533,7 +537,8 @@ static void dvbpsi_atsc_DecodeEITSections(dvbpsi_atsc_eit_t* p_eit,
             uint8_t i_tag = p_byte[0];
             uint8_t i_len = p_byte[1];
             if(i_len + 2 <= p_end - p_byte)
-              dvbpsi_atsc_EITChannelAddDescriptor(p_event, i_tag, i_len, p_byte + 2);
+              dvbpsi_atsc_EITChannelAddDescriptor(p_event, &p_last_descriptor,
+                                                  i_tag, i_len, p_byte + 2);
             p_byte += 2 + i_len;
         }
     }
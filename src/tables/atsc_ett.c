@@ -341,7 +341,7 @@ static void dvbpsi_atsc_GatherETTSections(dvbpsi_t* p_dvbpsi,
     }
 
     /* TS discontinuity check */
-    if (p_demux->b_discontinuity)
+    if (p_demux->b_discontinuity || p_ett_decoder->b_discontinuity)
     {
         dvbpsi_ReInitETT(p_ett_decoder, true);
         p_ett_decoder->b_discontinuity = false;
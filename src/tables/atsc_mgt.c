@@ -62,6 +62,7 @@ static dvbpsi_descriptor_t *dvbpsi_atsc_MGTAddDescriptor(
                                                uint8_t *p_data);
 
 static dvbpsi_atsc_mgt_table_t *dvbpsi_atsc_MGTAddTable(dvbpsi_atsc_mgt_t* p_mgt,
+						 dvbpsi_atsc_mgt_table_t **pp_last,
 						 uint16_t i_table_type,
 						 uint16_t i_table_type_pid,
 						 uint8_t  i_table_type_version,
@@ -69,6 +70,7 @@ static dvbpsi_atsc_mgt_table_t *dvbpsi_atsc_MGTAddTable(dvbpsi_atsc_mgt_t* p_mgt
 
 static dvbpsi_descriptor_t *dvbpsi_atsc_MGTTableAddDescriptor(
                                                dvbpsi_atsc_mgt_table_t *p_table,
+                                               dvbpsi_descriptor_t **pp_last,
                                                uint8_t i_tag, uint8_t i_length,
                                                uint8_t *p_data);
 
@@ -248,9 +250,11 @@ static dvbpsi_descriptor_t *dvbpsi_atsc_MGTAddDescriptor(
 /*****************************************************************************
  * dvbpsi_atsc_MGTAddTable
  *****************************************************************************
- * Add a Table description at the end of the MGT.
+ * Add a Table description at the end of the MGT, *pp_last is the last table
+ * added or NULL.
  *****************************************************************************/
 static dvbpsi_atsc_mgt_table_t *dvbpsi_atsc_MGTAddTable(dvbpsi_atsc_mgt_t* p_mgt,
+						 dvbpsi_atsc_mgt_table_t **pp_last,
 						 uint16_t i_table_type,
 						 uint16_t i_table_type_pid,
 						 uint8_t  i_table_type_version,
@@ -274,11 +278,13 @@ static dvbpsi_atsc_mgt_table_t *dvbpsi_atsc_MGTAddTable(dvbpsi_atsc_mgt_t* p_mgt
     }
     else
     {
-      dvbpsi_atsc_mgt_table_t * p_last_table = p_mgt->p_first_table;
+      dvbpsi_atsc_mgt_table_t * p_last_table = *pp_last ? *pp_last
+                                                        : p_mgt->p_first_table;
       while(p_last_table->p_next != NULL)
         p_last_table = p_last_table->p_next;
       p_last_table->p_next = p_table;
     }
+    *pp_last = p_table;
   }
 
   return p_table;
@@ -291,25 +297,14 @@ static dvbpsi_atsc_mgt_table_t *dvbpsi_atsc_MGTAddTable(dvbpsi_atsc_mgt_t* p_mgt
  *****************************************************************************/
 static dvbpsi_descriptor_t *dvbpsi_atsc_MGTTableAddDescriptor(
                                                dvbpsi_atsc_mgt_table_t *p_table,
+                                               dvbpsi_descriptor_t **pp_last,
                                                uint8_t i_tag, uint8_t i_length,
                                                uint8_t *p_data)
 {
   dvbpsi_descriptor_t * p_descriptor
                         = dvbpsi_NewDescriptor(i_tag, i_length, p_data);
   if(p_descriptor)
-  {
-    if(p_table->p_first_descriptor == NULL)
-    {
-      p_table->p_first_descriptor = p_descriptor;
-    }
-    else
-    {
-      dvbpsi_descriptor_t * p_last_descriptor = p_table->p_first_descriptor;
-      while(p_last_descriptor->p_next != NULL)
-        p_last_descriptor = p_last_descriptor->p_next;
-      p_last_descriptor->p_next = p_descriptor;
-    }
-  }
+    dvbpsi_descriptor_append(&p_table->p_first_descriptor, pp_last, p_descriptor);
 
   return p_descriptor;
 }
@@ -426,7 +421,7 @@ static void dvbpsi_atsc_GatherMGTSections(dvbpsi_t * p_dvbpsi,
     }
 
     /* TS discontinuity check */
-    if (p_demux->b_discontinuity)
+    if (p_demux->b_discontinuity || p_mgt_decoder->b_discontinuity)
     {
         dvbpsi_ReInitMGT(p_mgt_decoder, true);
         p_mgt_decoder->b_discontinuity = false;
@@ -516,6 +511,7 @@ static void dvbpsi_atsc_GatherMGTSections(dvbpsi_t * p_dvbpsi,
 static void dvbpsi_atsc_DecodeMGTSections(dvbpsi_atsc_mgt_t* p_mgt,
                                           dvbpsi_psi_section_t* p_section)
 {
+  dvbpsi_atsc_mgt_table_t *p_last_table = NULL;
   uint8_t *p_byte, *p_end;
 
   while(p_section)
@@ -530,6 +526,7 @@ static void dvbpsi_atsc_DecodeMGTSections(dvbpsi_atsc_mgt_t* p_mgt,
         i_tables_count ++)
     {
 	dvbpsi_atsc_mgt_table_t* p_table;
+	dvbpsi_descriptor_t *p_last_descriptor = NULL;
 	uint16_t i_table_type         = ((uint16_t)(p_byte[0]) << 8) |
 	                                ((uint16_t)(p_byte[1]));
 	uint16_t i_table_type_pid     = ((uint16_t)(p_byte[2] & 0x1f) << 8) |
@@ -541,7 +538,7 @@ static void dvbpsi_atsc_DecodeMGTSections(dvbpsi_atsc_mgt_t* p_mgt,
                                         ((uint32_t)(p_byte[8]));
         i_length = ((uint16_t)(p_byte[9] & 0xf) <<8) | p_byte[10];
 
-        p_table = dvbpsi_atsc_MGTAddTable(p_mgt,
+        p_table = dvbpsi_atsc_MGTAddTable(p_mgt, &p_last_table,
 					  i_table_type,
 					  i_table_type_pid,
 					  i_table_type_version,
@@ -557,7 +554,8 @@ static void dvbpsi_atsc_DecodeMGTSections(dvbpsi_atsc_mgt_t* p_mgt,
             uint8_t i_tag = p_byte[0];
             uint8_t i_len = p_byte[1];
             if(i_len + 2 <= p_end - p_byte)
-              dvbpsi_atsc_MGTTableAddDescriptor(p_table, i_tag, i_len, p_byte + 2);
+              dvbpsi_atsc_MGTTableAddDescriptor(p_table, &p_last_descriptor,
+                                                i_tag, i_len, p_byte + 2);
             p_byte += 2 + i_len;
         }
     }
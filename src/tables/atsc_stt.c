@@ -331,7 +331,7 @@ static void dvbpsi_atsc_GatherSTTSections(dvbpsi_t *p_dvbpsi,
     }
 
     /* TS discontinuity check */
-    if (p_demux->b_discontinuity)
+    if (p_demux->b_discontinuity || p_stt_decoder->b_discontinuity)
     {
         dvbpsi_ReInitSTT(p_stt_decoder, true);
         p_stt_decoder->b_discontinuity = false;
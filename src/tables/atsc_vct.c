@@ -56,10 +56,12 @@ typedef struct dvbpsi_atsc_vct_decoder_s
 
 static dvbpsi_descriptor_t *dvbpsi_atsc_VCTAddDescriptor(
                                                dvbpsi_atsc_vct_t *p_vct,
+                                               dvbpsi_descriptor_t **pp_last,
                                                uint8_t i_tag, uint8_t i_length,
                                                uint8_t *p_data);
 
 static dvbpsi_atsc_vct_channel_t *dvbpsi_atsc_VCTAddChannel(dvbpsi_atsc_vct_t* p_vct,
+                                            dvbpsi_atsc_vct_channel_t **pp_last,
                                             uint8_t *p_short_name,
                                             uint16_t i_major_number,
                                             uint16_t i_minor_number,
@@ -77,7 +79,9 @@ static dvbpsi_atsc_vct_channel_t *dvbpsi_atsc_VCTAddChannel(dvbpsi_atsc_vct_t* p
                                             uint16_t i_source_id);
 
 static dvbpsi_descriptor_t *dvbpsi_atsc_VCTChannelAddDescriptor(
+                                               dvbpsi_atsc_vct_t *p_vct,
                                                dvbpsi_atsc_vct_channel_t *p_table,
+                                               dvbpsi_descriptor_t **pp_last,
                                                uint8_t i_tag, uint8_t i_length,
                                                uint8_t *p_data);
 
@@ -205,6 +209,7 @@ void dvbpsi_atsc_InitVCT(dvbpsi_atsc_vct_t* p_vct, uint8_t i_table_id,
     p_vct->b_cable_vct = b_cable_vct;
     p_vct->p_first_channel = NULL;
     p_vct->p_first_descriptor = NULL;
+    p_vct->p_arena = NULL;
 }
 
 /*****************************************************************************
@@ -215,14 +220,14 @@ void dvbpsi_atsc_InitVCT(dvbpsi_atsc_vct_t* p_vct, uint8_t i_table_id,
 void dvbpsi_atsc_EmptyVCT(dvbpsi_atsc_vct_t* p_vct)
 {
     dvbpsi_atsc_vct_channel_t* p_channel = p_vct->p_first_channel;
-    dvbpsi_DeleteDescriptors(p_vct->p_first_descriptor);
+    dvbpsi_arena_descriptors_delete(p_vct->p_arena, p_vct->p_first_descriptor);
     p_vct->p_first_descriptor = NULL;
 
     while(p_channel != NULL)
     {
         dvbpsi_atsc_vct_channel_t* p_tmp = p_channel->p_next;
-        dvbpsi_DeleteDescriptors(p_channel->p_first_descriptor);
-        free(p_channel);
+        dvbpsi_arena_descriptors_delete(p_vct->p_arena, p_channel->p_first_descriptor);
+        dvbpsi_arena_free(p_vct->p_arena, p_channel);
         p_channel = p_tmp;
     }
     p_vct->p_first_channel = NULL;
@@ -235,9 +240,14 @@ void dvbpsi_atsc_EmptyVCT(dvbpsi_atsc_vct_t* p_vct)
  *****************************************************************************/
 void dvbpsi_atsc_DeleteVCT(dvbpsi_atsc_vct_t *p_vct)
 {
-    if (p_vct)
-        dvbpsi_atsc_EmptyVCT(p_vct);
-    free(p_vct);
+    if (p_vct == NULL)
+        return;
+
+    dvbpsi_atsc_EmptyVCT(p_vct);
+    if (p_vct->p_arena)
+        dvbpsi_arena_delete(p_vct->p_arena);
+    else
+        free(p_vct);
 }
 
 /*****************************************************************************
@@ -246,29 +256,27 @@ void dvbpsi_atsc_DeleteVCT(dvbpsi_atsc_vct_t *p_vct)
  * Add a descriptor to the VCT table.
  *****************************************************************************/
 static dvbpsi_descriptor_t *dvbpsi_atsc_VCTAddDescriptor(dvbpsi_atsc_vct_t *p_vct,
+                                               dvbpsi_descriptor_t **pp_last,
                                                uint8_t i_tag, uint8_t i_length,
                                                uint8_t *p_data)
 {
     dvbpsi_descriptor_t * p_descriptor
-            = dvbpsi_NewDescriptor(i_tag, i_length, p_data);
+            = dvbpsi_arena_descriptor_new(p_vct->p_arena, i_tag, i_length, p_data);
     if (p_descriptor == NULL)
         return NULL;
 
-    p_vct->p_first_descriptor = dvbpsi_AddDescriptor(p_vct->p_first_descriptor,
-                                                     p_descriptor);
-    assert(p_vct->p_first_descriptor);
-    if (p_vct->p_first_descriptor == NULL)
-        return NULL;
-
+    dvbpsi_descriptor_append(&p_vct->p_first_descriptor, pp_last, p_descriptor);
     return p_descriptor;
 }
 
 /*****************************************************************************
  * dvbpsi_atsc_VCTAddChannel
  *****************************************************************************
- * Add a Channel description at the end of the VCT.
+ * Add a Channel description at the end of the VCT, *pp_last is the last
+ * channel added or NULL.
  *****************************************************************************/
 static dvbpsi_atsc_vct_channel_t *dvbpsi_atsc_VCTAddChannel(dvbpsi_atsc_vct_t* p_vct,
+                                            dvbpsi_atsc_vct_channel_t **pp_last,
                                             uint8_t *p_short_name,
                                             uint16_t i_major_number,
                                             uint16_t i_minor_number,
@@ -286,7 +294,8 @@ static dvbpsi_atsc_vct_channel_t *dvbpsi_atsc_VCTAddChannel(dvbpsi_atsc_vct_t* p
                                             uint16_t i_source_id)
 {
     dvbpsi_atsc_vct_channel_t * p_channel
-            = (dvbpsi_atsc_vct_channel_t*)malloc(sizeof(dvbpsi_atsc_vct_channel_t));
+            = (dvbpsi_atsc_vct_channel_t*)dvbpsi_arena_alloc(p_vct->p_arena,
+                                                 sizeof(dvbpsi_atsc_vct_channel_t));
     if(p_channel)
     {
         memcpy(p_channel->i_short_name, p_short_name, sizeof(uint16_t) * 7);
@@ -314,11 +323,13 @@ static dvbpsi_atsc_vct_channel_t *dvbpsi_atsc_VCTAddChannel(dvbpsi_atsc_vct_t* p
         }
         else
         {
-            dvbpsi_atsc_vct_channel_t * p_last_channel = p_vct->p_first_channel;
+            dvbpsi_atsc_vct_channel_t * p_last_channel = *pp_last ? *pp_last
+                                                                  : p_vct->p_first_channel;
             while(p_last_channel->p_next != NULL)
                 p_last_channel = p_last_channel->p_next;
             p_last_channel->p_next = p_channel;
         }
+        *pp_last = p_channel;
     }
 
     return p_channel;
@@ -330,26 +341,17 @@ static dvbpsi_atsc_vct_channel_t *dvbpsi_atsc_VCTAddChannel(dvbpsi_atsc_vct_t* p
  * Add a descriptor in the VCT table description.
  *****************************************************************************/
 static dvbpsi_descriptor_t *dvbpsi_atsc_VCTChannelAddDescriptor(
+                                               dvbpsi_atsc_vct_t *p_vct,
                                                dvbpsi_atsc_vct_channel_t *p_channel,
+                                               dvbpsi_descriptor_t **pp_last,
                                                uint8_t i_tag, uint8_t i_length,
                                                uint8_t *p_data)
 {
     dvbpsi_descriptor_t * p_descriptor
-            = dvbpsi_NewDescriptor(i_tag, i_length, p_data);
+            = dvbpsi_arena_descriptor_new(p_vct->p_arena, i_tag, i_length, p_data);
     if(p_descriptor)
-    {
-        if(p_channel->p_first_descriptor == NULL)
-        {
-            p_channel->p_first_descriptor = p_descriptor;
-        }
-        else
-        {
-            dvbpsi_descriptor_t * p_last_descriptor = p_channel->p_first_descriptor;
-            while(p_last_descriptor->p_next != NULL)
-                p_last_descriptor = p_last_descriptor->p_next;
-            p_last_descriptor->p_next = p_descriptor;
-        }
-    }
+        dvbpsi_descriptor_append(&p_channel->p_first_descriptor, pp_last,
+                                 p_descriptor);
 
     return p_descriptor;
 }
@@ -409,6 +411,32 @@ static bool dvbpsi_CheckVCT(dvbpsi_t *p_dvbpsi, dvbpsi_atsc_vct_decoder_t *p_vct
     return b_reinit;
 }
 
+/*****************************************************************************
+ * dvbpsi_atsc_BuildingVCT
+ *****************************************************************************
+ * dvbpsi_atsc_NewVCT() in an arena of its own with dvbpsi_t::b_arena_tables.
+ *****************************************************************************/
+static dvbpsi_atsc_vct_t *dvbpsi_atsc_BuildingVCT(dvbpsi_t *p_dvbpsi, uint8_t i_table_id,
+                                                  uint16_t i_extension, uint8_t i_protocol,
+                                                  bool b_cable_vct, uint8_t i_version,
+                                                  bool b_current_next)
+{
+    if (!p_dvbpsi->b_arena_tables)
+        return dvbpsi_atsc_NewVCT(i_table_id, i_extension, i_protocol, b_cable_vct,
+                                  i_version, b_current_next);
+
+    dvbpsi_arena_t *p_arena = dvbpsi_arena_new(p_dvbpsi->b_zero_copy_descriptors);
+    if (p_arena == NULL)
+        return NULL;
+
+    dvbpsi_atsc_vct_t *p_vct = dvbpsi_arena_alloc(p_arena, sizeof(dvbpsi_atsc_vct_t));
+    assert(p_vct);
+    dvbpsi_atsc_InitVCT(p_vct, i_table_id, i_extension, i_protocol, b_cable_vct,
+                        i_version, b_current_next);
+    p_vct->p_arena = p_arena;
+    return p_vct;
+}
+
 static bool dvbpsi_AddSectionVCT(dvbpsi_t *p_dvbpsi, dvbpsi_atsc_vct_decoder_t *p_vct_decoder,
                                  dvbpsi_psi_section_t* p_section)
 {
@@ -419,7 +447,7 @@ static bool dvbpsi_AddSectionVCT(dvbpsi_t *p_dvbpsi, dvbpsi_atsc_vct_decoder_t *
     /* Initialize the structures if it's the first section received */
     if (!p_vct_decoder->p_building_vct)
     {
-        p_vct_decoder->p_building_vct = dvbpsi_atsc_NewVCT(
+        p_vct_decoder->p_building_vct = dvbpsi_atsc_BuildingVCT(p_dvbpsi,
                               p_section->i_table_id, p_section->i_extension,
                               p_section->p_payload_start[0], p_section->i_table_id == 0xC9,
                               p_section->i_version, p_section->b_current_next);
@@ -429,6 +457,18 @@ static bool dvbpsi_AddSectionVCT(dvbpsi_t *p_dvbpsi, dvbpsi_atsc_vct_decoder_t *
         p_vct_decoder->i_last_section_number = p_section->i_last_number;
     }
 
+    /* Decode the section now and only remember its number */
+    if (dvbpsi_decoder_decode_on_arrival(p_dvbpsi, DVBPSI_DECODER(p_vct_decoder)))
+    {
+        if (dvbpsi_decoder_psi_section_mark(DVBPSI_DECODER(p_vct_decoder), p_section))
+            dvbpsi_debug(p_dvbpsi, "ATSC VCT decoder", "ignoring already decoded section %d",
+                         p_section->i_number);
+        else
+            dvbpsi_atsc_DecodeVCTSections(p_vct_decoder->p_building_vct, p_section);
+        dvbpsi_DeletePSISections(p_section);
+        return true;
+    }
+
     /* Add to linked list of sections */
     if (dvbpsi_decoder_psi_section_add(DVBPSI_DECODER(p_vct_decoder), p_section))
         dvbpsi_debug(p_dvbpsi, "ATSC VCT decoder", "overwrite section number %d",
@@ -464,7 +504,7 @@ static void dvbpsi_atsc_GatherVCTSections(dvbpsi_t *p_dvbpsi,
     dvbpsi_atsc_vct_decoder_t *p_vct_decoder = (dvbpsi_atsc_vct_decoder_t*)p_decoder;
 
     /* TS discontinuity check */
-    if (p_demux->b_discontinuity)
+    if (p_demux->b_discontinuity || p_vct_decoder->b_discontinuity)
     {
         dvbpsi_ReInitVCT(p_vct_decoder, true);
         p_vct_decoder->b_discontinuity = false;
@@ -534,6 +574,11 @@ static void dvbpsi_atsc_GatherVCTSections(dvbpsi_t *p_dvbpsi,
         /* Save the current information */
         p_vct_decoder->current_vct = *p_vct_decoder->p_building_vct;
         p_vct_decoder->b_current_valid = true;
+        dvbpsi_decoder_current_set(DVBPSI_DECODER(p_vct_decoder),
+                                   p_vct_decoder->p_building_vct->i_table_id,
+                                   p_vct_decoder->p_building_vct->i_extension,
+                                   p_vct_decoder->p_building_vct->i_version,
+                                   p_vct_decoder->p_building_vct->b_current_next);
         /* Decode the sections */
         dvbpsi_atsc_DecodeVCTSections(p_vct_decoder->p_building_vct,
                                       p_vct_decoder->p_sections);
@@ -554,10 +599,14 @@ static void dvbpsi_atsc_GatherVCTSections(dvbpsi_t *p_dvbpsi,
 static void dvbpsi_atsc_DecodeVCTSections(dvbpsi_atsc_vct_t* p_vct,
                               dvbpsi_psi_section_t* p_section)
 {
+    dvbpsi_descriptor_t *p_last_descriptor = NULL;
+    dvbpsi_atsc_vct_channel_t *p_last_channel = NULL;
     uint8_t *p_byte, *p_end;
 
     while(p_section)
     {
+        dvbpsi_arena_section_keep(p_vct->p_arena, p_section);
+
         uint16_t i_channels_defined = p_section->p_payload_start[1];
         uint16_t i_channels_count = 0;
         uint16_t i_length = 0;
@@ -567,6 +616,7 @@ static void dvbpsi_atsc_DecodeVCTSections(dvbpsi_atsc_vct_t* p_vct,
             i_channels_count ++)
         {
             dvbpsi_atsc_vct_channel_t* p_channel;
+            dvbpsi_descriptor_t *p_last_channel_descriptor = NULL;
             uint16_t i_major_number      = ((uint16_t)(p_byte[14] & 0xf) << 6) | ((uint16_t)(p_byte[15] & 0xfc) >> 2);
             uint16_t i_minor_number      = ((uint16_t)(p_byte[15] & 0x3) << 8) | ((uint16_t) p_byte[16]);
             uint8_t  i_modulation        = p_byte[17];
@@ -586,7 +636,7 @@ static void dvbpsi_atsc_DecodeVCTSections(dvbpsi_atsc_vct_t* p_vct,
             uint16_t i_source_id         = ((uint16_t)(p_byte[28] << 8)) |  ((uint16_t)p_byte[29]);
             i_length = ((uint16_t)(p_byte[30] & 0x3) <<8) | p_byte[31];
 
-            p_channel = dvbpsi_atsc_VCTAddChannel(p_vct, p_byte,
+            p_channel = dvbpsi_atsc_VCTAddChannel(p_vct, &p_last_channel, p_byte,
                                                   i_major_number, i_minor_number,
                                                   i_modulation, i_carrier_freq,
                                                   i_channel_tsid, i_program_number,
@@ -604,7 +654,9 @@ static void dvbpsi_atsc_DecodeVCTSections(dvbpsi_atsc_vct_t* p_vct,
                 uint8_t i_tag = p_byte[0];
                 uint8_t i_len = p_byte[1];
                 if(i_len + 2 <= p_end - p_byte)
-                    dvbpsi_atsc_VCTChannelAddDescriptor(p_channel, i_tag, i_len, p_byte + 2);
+                    dvbpsi_atsc_VCTChannelAddDescriptor(p_vct, p_channel,
+                                                        &p_last_channel_descriptor,
+                                                        i_tag, i_len, p_byte + 2);
                 p_byte += 2 + i_len;
             }
         }
@@ -619,7 +671,8 @@ static void dvbpsi_atsc_DecodeVCTSections(dvbpsi_atsc_vct_t* p_vct,
             uint8_t i_tag = p_byte[0];
             uint8_t i_len = p_byte[1];
             if(i_len + 2 <= p_end - p_byte)
-                dvbpsi_atsc_VCTAddDescriptor(p_vct, i_tag, i_len, p_byte + 2);
+                dvbpsi_atsc_VCTAddDescriptor(p_vct, &p_last_descriptor, i_tag, i_len,
+                                             p_byte + 2);
             p_byte += 2 + i_len;
         }
         p_section = p_section->p_next;
@@ -99,6 +99,9 @@ typedef struct dvbpsi_atsc_vct_s
     dvbpsi_descriptor_t         *p_first_descriptor; /*!< First descriptor. */
     dvbpsi_atsc_vct_channel_t   *p_first_channel;    /*!< First channel information structure. */
 
+    struct dvbpsi_arena_s       *p_arena;            /*!< private: memory of the table when
+                                                          decoded with dvbpsi_s::b_arena_tables */
+
 } dvbpsi_atsc_vct_t;
 
 /*****************************************************************************
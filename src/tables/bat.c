@@ -46,6 +46,7 @@
 #include "../dvbpsi_private.h"
 #include "../psi.h"
 #include "../descriptor.h"
+#include "../delta.h"
 #include "../demux.h"
 #include "bat.h"
 #include "bat_private.h"
@@ -126,11 +127,52 @@ void dvbpsi_bat_detach(dvbpsi_t *p_dvbpsi, uint8_t i_table_id, uint16_t i_extens
     if (p_bat_decoder->p_building_bat)
         dvbpsi_bat_delete(p_bat_decoder->p_building_bat);
     p_bat_decoder->p_building_bat = NULL;
+    dvbpsi_delta_state_delete(p_bat_decoder->p_delta);
 
     dvbpsi_DetachDemuxSubDecoder(p_demux, p_subdec);
     dvbpsi_DeleteDemuxSubDecoder(p_subdec);
 }
 
+/*****************************************************************************
+ * dvbpsi_bat_set_delta_callback
+ *****************************************************************************
+ * Report the changes of the next BATs.
+ *****************************************************************************/
+bool dvbpsi_bat_set_delta_callback(dvbpsi_t *p_dvbpsi, uint8_t i_table_id,
+                                   uint16_t i_extension,
+                                   dvbpsi_bat_delta_callback pf_callback,
+                                   void* p_cb_data)
+{
+    assert(p_dvbpsi);
+    assert(p_dvbpsi->p_decoder);
+
+    dvbpsi_bat_decoder_t *p_bat_decoder = (dvbpsi_bat_decoder_t *)
+            dvbpsi_demux_decoder_find(p_dvbpsi->p_decoder, i_table_id, i_extension);
+    if (p_bat_decoder == NULL)
+    {
+        dvbpsi_error(p_dvbpsi, "BAT decoder",
+                     "No such BAT decoder (table_id == 0x%02x,"
+                     "extension == 0x%02x)",
+                     i_table_id, i_extension);
+        return false;
+    }
+
+    if (pf_callback == NULL)
+    {
+        dvbpsi_delta_state_delete(p_bat_decoder->p_delta);
+        p_bat_decoder->p_delta = NULL;
+    }
+    else if (p_bat_decoder->p_delta == NULL)
+    {
+        p_bat_decoder->p_delta = dvbpsi_delta_state_new();
+        if (p_bat_decoder->p_delta == NULL)
+            return false;
+    }
+    p_bat_decoder->pf_delta_callback = pf_callback;
+    p_bat_decoder->p_delta_cb_data = p_cb_data;
+    return true;
+}
+
 /*****************************************************************************
  * dvbpsi_bat_init
  *****************************************************************************
@@ -147,6 +189,7 @@ void dvbpsi_bat_init(dvbpsi_bat_t* p_bat, uint8_t i_table_id, uint16_t i_extensi
     p_bat->b_current_next = b_current_next;
     p_bat->p_first_ts = NULL;
     p_bat->p_first_descriptor = NULL;
+    p_bat->p_arena = NULL;
 }
 
 /*****************************************************************************
@@ -172,14 +215,14 @@ void dvbpsi_bat_empty(dvbpsi_bat_t* p_bat)
 {
     dvbpsi_bat_ts_t* p_ts = p_bat->p_first_ts;
 
-    dvbpsi_DeleteDescriptors(p_bat->p_first_descriptor);
+    dvbpsi_arena_descriptors_delete(p_bat->p_arena, p_bat->p_first_descriptor);
     p_bat->p_first_descriptor = NULL;
 
     while (p_ts != NULL)
     {
         dvbpsi_bat_ts_t* p_tmp = p_ts->p_next;
-        dvbpsi_DeleteDescriptors(p_ts->p_first_descriptor);
-        free(p_ts);
+        dvbpsi_arena_descriptors_delete(p_bat->p_arena, p_ts->p_first_descriptor);
+        dvbpsi_arena_free(p_bat->p_arena, p_ts);
         p_ts = p_tmp;
     }
     p_bat->p_first_ts = NULL;
@@ -192,9 +235,14 @@ void dvbpsi_bat_empty(dvbpsi_bat_t* p_bat)
  *****************************************************************************/
 void dvbpsi_bat_delete(dvbpsi_bat_t *p_bat)
 {
-    if (p_bat)
-        dvbpsi_bat_empty(p_bat);
-    free(p_bat);
+    if (p_bat == NULL)
+        return;
+
+    dvbpsi_bat_empty(p_bat);
+    if (p_bat->p_arena)
+        dvbpsi_arena_delete(p_bat->p_arena);
+    else
+        free(p_bat);
 }
 
 /*****************************************************************************
@@ -207,7 +255,7 @@ dvbpsi_descriptor_t* dvbpsi_bat_bouquet_descriptor_add(dvbpsi_bat_t* p_bat,
                                                        uint8_t* p_data)
 {
     dvbpsi_descriptor_t* p_descriptor
-                        = dvbpsi_NewDescriptor(i_tag, i_length, p_data);
+                        = dvbpsi_arena_descriptor_new(p_bat->p_arena, i_tag, i_length, p_data);
     if (p_descriptor == NULL)
         return NULL;
 
@@ -221,15 +269,17 @@ dvbpsi_descriptor_t* dvbpsi_bat_bouquet_descriptor_add(dvbpsi_bat_t* p_bat,
 }
 
 /*****************************************************************************
- * dvbpsi_bat_ts_add
+ * dvbpsi_bat_ts_append
  *****************************************************************************
- * Add a TS description at the end of the BAT.
+ * Add a TS description at the end of the BAT. The end is searched from
+ * *pp_last, the last TS added by the caller or NULL, which is updated.
  *****************************************************************************/
-dvbpsi_bat_ts_t *dvbpsi_bat_ts_add(dvbpsi_bat_t* p_bat,
-                                 uint16_t i_ts_id, uint16_t i_orig_network_id)
+static dvbpsi_bat_ts_t *dvbpsi_bat_ts_append(dvbpsi_bat_t* p_bat, dvbpsi_bat_ts_t **pp_last,
+                                             uint16_t i_ts_id, uint16_t i_orig_network_id)
 {
     dvbpsi_bat_ts_t * p_ts
-                = (dvbpsi_bat_ts_t*)malloc(sizeof(dvbpsi_bat_ts_t));
+                = (dvbpsi_bat_ts_t*)dvbpsi_arena_alloc(p_bat->p_arena,
+                                                       sizeof(dvbpsi_bat_ts_t));
     if (p_ts == NULL)
         return NULL;
 
@@ -242,15 +292,28 @@ dvbpsi_bat_ts_t *dvbpsi_bat_ts_add(dvbpsi_bat_t* p_bat,
         p_bat->p_first_ts = p_ts;
     else
     {
-        dvbpsi_bat_ts_t * p_last_ts = p_bat->p_first_ts;
+        dvbpsi_bat_ts_t * p_last_ts = *pp_last ? *pp_last : p_bat->p_first_ts;
         while(p_last_ts->p_next != NULL)
             p_last_ts = p_last_ts->p_next;
         p_last_ts->p_next = p_ts;
     }
+    *pp_last = p_ts;
 
     return p_ts;
 }
 
+/*****************************************************************************
+ * dvbpsi_bat_ts_add
+ *****************************************************************************
+ * Add a TS description at the end of the BAT.
+ *****************************************************************************/
+dvbpsi_bat_ts_t *dvbpsi_bat_ts_add(dvbpsi_bat_t* p_bat,
+                                 uint16_t i_ts_id, uint16_t i_orig_network_id)
+{
+    dvbpsi_bat_ts_t * p_last_ts = NULL;
+    return dvbpsi_bat_ts_append(p_bat, &p_last_ts, i_ts_id, i_orig_network_id);
+}
+
 
 /*****************************************************************************
  * dvbpsi_bat_ts_descriptor_add
@@ -278,6 +341,27 @@ dvbpsi_descriptor_t *dvbpsi_bat_ts_descriptor_add(dvbpsi_bat_ts_t *p_bat,
     return p_descriptor;
 }
 
+/*****************************************************************************
+ * dvbpsi_bat_decode_descriptors
+ *****************************************************************************
+ * Decode the descriptors of the BAT and of its transport streams, each loop
+ * starting without private_data_specifier.
+ *****************************************************************************/
+unsigned int dvbpsi_bat_decode_descriptors(dvbpsi_bat_t *p_bat,
+                                           const uint8_t *p_tags, unsigned int i_tags)
+{
+    uint8_t p_selected[256];
+    unsigned int i_decoded = 0;
+
+    assert(p_bat);
+
+    dvbpsi_descriptors_select(p_selected, p_tags, i_tags);
+    i_decoded += dvbpsi_descriptors_decode(p_bat->p_first_descriptor, 0, p_selected);
+    for (dvbpsi_bat_ts_t *p_ts = p_bat->p_first_ts; p_ts; p_ts = p_ts->p_next)
+        i_decoded += dvbpsi_descriptors_decode(p_ts->p_first_descriptor, 0, p_selected);
+    return i_decoded;
+}
+
 /* */
 static void dvbpsi_ReInitBAT(dvbpsi_bat_decoder_t* p_decoder, const bool b_force)
 {
@@ -329,6 +413,29 @@ static bool dvbpsi_CheckBAT(dvbpsi_t *p_dvbpsi, dvbpsi_bat_decoder_t *p_bat_deco
     return b_reinit;
 }
 
+/*****************************************************************************
+ * dvbpsi_bat_building_new
+ *****************************************************************************
+ * dvbpsi_bat_new() in an arena of its own with dvbpsi_t::b_arena_tables.
+ *****************************************************************************/
+static dvbpsi_bat_t *dvbpsi_bat_building_new(dvbpsi_t *p_dvbpsi, uint8_t i_table_id,
+                                             uint16_t i_extension, uint8_t i_version,
+                                             bool b_current_next)
+{
+    if (!p_dvbpsi->b_arena_tables)
+        return dvbpsi_bat_new(i_table_id, i_extension, i_version, b_current_next);
+
+    dvbpsi_arena_t *p_arena = dvbpsi_arena_new(p_dvbpsi->b_zero_copy_descriptors);
+    if (p_arena == NULL)
+        return NULL;
+
+    dvbpsi_bat_t *p_bat = dvbpsi_arena_alloc(p_arena, sizeof(dvbpsi_bat_t));
+    assert(p_bat);
+    dvbpsi_bat_init(p_bat, i_table_id, i_extension, i_version, b_current_next);
+    p_bat->p_arena = p_arena;
+    return p_bat;
+}
+
 static bool dvbpsi_AddSectionBAT(dvbpsi_t *p_dvbpsi, dvbpsi_bat_decoder_t *p_bat_decoder,
                                  dvbpsi_psi_section_t* p_section)
 {
@@ -339,7 +446,7 @@ static bool dvbpsi_AddSectionBAT(dvbpsi_t *p_dvbpsi, dvbpsi_bat_decoder_t *p_bat
     /* Initialize the structures if it's the first section received */
     if (!p_bat_decoder->p_building_bat)
     {
-        p_bat_decoder->p_building_bat = dvbpsi_bat_new(
+        p_bat_decoder->p_building_bat = dvbpsi_bat_building_new(p_dvbpsi,
                               p_section->i_table_id, p_section->i_extension,
                               p_section->i_version, p_section->b_current_next);
         if (!p_bat_decoder->p_building_bat)
@@ -348,6 +455,18 @@ static bool dvbpsi_AddSectionBAT(dvbpsi_t *p_dvbpsi, dvbpsi_bat_decoder_t *p_bat
         p_bat_decoder->i_last_section_number = p_section->i_last_number;
     }
 
+    /* Decode the section now and only remember its number */
+    if (dvbpsi_decoder_decode_on_arrival(p_dvbpsi, DVBPSI_DECODER(p_bat_decoder)))
+    {
+        if (dvbpsi_decoder_psi_section_mark(DVBPSI_DECODER(p_bat_decoder), p_section))
+            dvbpsi_debug(p_dvbpsi, "BAT decoder", "ignoring already decoded section %d",
+                         p_section->i_number);
+        else
+            dvbpsi_bat_sections_decode(p_bat_decoder->p_building_bat, p_section);
+        dvbpsi_DeletePSISections(p_section);
+        return true;
+    }
+
     /* Add to linked list of sections */
     if (dvbpsi_decoder_psi_section_add(DVBPSI_DECODER(p_bat_decoder), p_section))
         dvbpsi_debug(p_dvbpsi, "BAT decoder", "overwrite section number %d",
@@ -356,6 +475,35 @@ static bool dvbpsi_AddSectionBAT(dvbpsi_t *p_dvbpsi, dvbpsi_bat_decoder_t *p_bat
     return true;
 }
 
+/*****************************************************************************
+ * dvbpsi_bat_delta
+ *****************************************************************************
+ * Give the changes of p_bat to the delta callback.
+ *****************************************************************************/
+static void dvbpsi_bat_delta(dvbpsi_t *p_dvbpsi, dvbpsi_bat_decoder_t *p_bat_decoder,
+                             const dvbpsi_bat_t *p_bat)
+{
+    dvbpsi_delta_descriptors_add(p_bat_decoder->p_delta, p_bat->p_first_descriptor);
+    for (const dvbpsi_bat_ts_t *p_ts = p_bat->p_first_ts; p_ts; p_ts = p_ts->p_next)
+    {
+        uint64_t i_hash = dvbpsi_delta_hash_descriptors(DVBPSI_DELTA_HASH_INIT,
+                                                        p_ts->p_first_descriptor);
+        dvbpsi_delta_element_add(p_bat_decoder->p_delta,
+                                 (uint32_t)p_ts->i_ts_id << 16 | p_ts->i_orig_network_id,
+                                 i_hash, p_ts);
+    }
+
+    const dvbpsi_delta_t *p_deltas;
+    unsigned int i_deltas;
+    if (!dvbpsi_delta_compute(p_bat_decoder->p_delta, &p_deltas, &i_deltas))
+    {
+        dvbpsi_error(p_dvbpsi, "BAT decoder", "failed computing the changes");
+        return;
+    }
+    p_bat_decoder->pf_delta_callback(p_bat_decoder->p_delta_cb_data, p_bat,
+                                     p_deltas, i_deltas);
+}
+
 /*****************************************************************************
  * dvbpsi_bat_sections_gather
  *****************************************************************************
@@ -378,7 +526,7 @@ void dvbpsi_bat_sections_gather(dvbpsi_t *p_dvbpsi,
     }
 
     /* We have a valid BAT section */
-    if (p_demux->b_discontinuity)
+    if (p_demux->b_discontinuity || p_bat_decoder->b_discontinuity)
     {
         dvbpsi_ReInitBAT(p_bat_decoder, true);
         p_bat_decoder->b_discontinuity = false;
@@ -444,9 +592,17 @@ void dvbpsi_bat_sections_gather(dvbpsi_t *p_dvbpsi,
         /* Save the current information */
         p_bat_decoder->current_bat = *p_bat_decoder->p_building_bat;
         p_bat_decoder->b_current_valid = true;
+        dvbpsi_decoder_current_set(DVBPSI_DECODER(p_bat_decoder),
+                                   p_bat_decoder->p_building_bat->i_table_id,
+                                   p_bat_decoder->p_building_bat->i_extension,
+                                   p_bat_decoder->p_building_bat->i_version,
+                                   p_bat_decoder->p_building_bat->b_current_next);
         /* Decode the sections */
         dvbpsi_bat_sections_decode(p_bat_decoder->p_building_bat,
                                    p_bat_decoder->p_sections);
+        /* report its changes */
+        if (p_bat_decoder->pf_delta_callback)
+            dvbpsi_bat_delta(p_dvbpsi, p_bat_decoder, p_bat_decoder->p_building_bat);
         /* signal the new BAT */
         p_bat_decoder->pf_bat_callback(p_bat_decoder->p_cb_data,
                                        p_bat_decoder->p_building_bat);
@@ -467,10 +623,14 @@ void dvbpsi_bat_sections_gather(dvbpsi_t *p_dvbpsi,
 void dvbpsi_bat_sections_decode(dvbpsi_bat_t* p_bat,
                               dvbpsi_psi_section_t* p_section)
 {
+    dvbpsi_descriptor_t* p_last_descriptor = NULL;
+    dvbpsi_bat_ts_t* p_last_ts = NULL;
     uint8_t* p_byte, * p_end;
 
     while(p_section)
     {
+        dvbpsi_arena_section_keep(p_bat->p_arena, p_section);
+
         /* - first loop descriptors */
         p_byte = p_section->p_payload_start + 2;
         p_end = p_byte + (((uint16_t)(p_section->p_payload_start[0] & 0x0f) << 8)
@@ -483,7 +643,9 @@ void dvbpsi_bat_sections_decode(dvbpsi_bat_t* p_bat,
             uint8_t i_tag = p_byte[0];
             uint8_t i_length = p_byte[1];
             if (i_length + 2 <= p_end - p_byte)
-                dvbpsi_bat_bouquet_descriptor_add(p_bat, i_tag, i_length, p_byte + 2);
+                dvbpsi_arena_descriptor_add(p_bat->p_arena, &p_bat->p_first_descriptor,
+                                            &p_last_descriptor,
+                                            i_tag, i_length, p_byte + 2);
             p_byte += 2 + i_length;
         }
 
@@ -500,11 +662,13 @@ void dvbpsi_bat_sections_decode(dvbpsi_bat_t* p_bat,
             uint16_t i_orig_network_id = ((uint16_t)p_byte[2] << 8) | p_byte[3];
             uint16_t i_transport_descriptors_length = ((uint16_t)(p_byte[4] & 0x0f) << 8) | p_byte[5];
 
-            dvbpsi_bat_ts_t* p_ts = dvbpsi_bat_ts_add(p_bat, i_ts_id, i_orig_network_id);
+            dvbpsi_bat_ts_t* p_ts = dvbpsi_bat_ts_append(p_bat, &p_last_ts,
+                                                         i_ts_id, i_orig_network_id);
             if (!p_ts)
                 break;
 
             /* - TS descriptors */
+            dvbpsi_descriptor_t* p_last_ts_descriptor = NULL;
             p_byte += 6;
             p_end2 = p_byte + i_transport_descriptors_length;
             if (p_end2 > p_section->p_payload_end)
@@ -515,7 +679,9 @@ void dvbpsi_bat_sections_decode(dvbpsi_bat_t* p_bat,
                 uint8_t i_tag = p_byte[0];
                 uint8_t i_length = p_byte[1];
                 if (i_length + 2 <= p_end2 - p_byte)
-                    dvbpsi_bat_ts_descriptor_add(p_ts, i_tag, i_length, p_byte + 2);
+                    dvbpsi_arena_descriptor_add(p_bat->p_arena, &p_ts->p_first_descriptor,
+                                                &p_last_ts_descriptor,
+                                                i_tag, i_length, p_byte + 2);
                 p_byte += 2 + i_length;
             }
         }
@@ -99,6 +99,10 @@ typedef struct dvbpsi_bat_s
     dvbpsi_bat_ts_t *       p_first_ts;         /*!< transport stream
                                                      description list */
 
+    struct dvbpsi_arena_s * p_arena;            /*!< private: memory of the
+                                                     table when decoded with
+                                                     dvbpsi_s::b_arena_tables */
+
 } dvbpsi_bat_t;
 
 /*****************************************************************************
@@ -111,6 +115,24 @@ typedef struct dvbpsi_bat_s
  */
 typedef void (* dvbpsi_bat_callback)(void* p_cb_data, dvbpsi_bat_t* p_new_bat);
 
+struct dvbpsi_delta_s;
+
+/*****************************************************************************
+ * dvbpsi_bat_delta_callback
+ *****************************************************************************/
+/*!
+ * \typedef void (* dvbpsi_bat_delta_callback)(void* p_cb_data,
+                                               const dvbpsi_bat_t* p_new_bat,
+                                               const struct dvbpsi_delta_s *p_deltas,
+                                               unsigned int i_deltas)
+ * \brief Delta callback type definition, the changes are described in
+ * delta.h. p_new_bat and p_deltas are only valid during the call, p_new_bat
+ * is then given to the dvbpsi_bat_callback.
+ */
+typedef void (* dvbpsi_bat_delta_callback)(void* p_cb_data, const dvbpsi_bat_t* p_new_bat,
+                                           const struct dvbpsi_delta_s *p_deltas,
+                                           unsigned int i_deltas);
+
 /*****************************************************************************
  * dvbpsi_bat_attach
  *****************************************************************************/
@@ -142,6 +164,33 @@ bool dvbpsi_bat_attach(dvbpsi_t *p_dvbpsi, uint8_t i_table_id, uint16_t i_extens
  */
 void dvbpsi_bat_detach(dvbpsi_t *p_dvbpsi, uint8_t i_table_id, uint16_t i_extension);
 
+/*****************************************************************************
+ * dvbpsi_bat_set_delta_callback
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_bat_set_delta_callback(dvbpsi_t *p_dvbpsi, uint8_t i_table_id,
+                                          uint16_t i_extension,
+                                          dvbpsi_bat_delta_callback pf_callback,
+                                          void* p_cb_data)
+ * \brief Report the changes of each new BAT of a BAT decoder.
+ * \param p_dvbpsi pointer holding decoder/demuxer structure
+ * \param i_table_id Table ID, 0x4a.
+ * \param i_extension Table ID extension, here bouquet ID.
+ * \param pf_callback function to call with the changes of each new BAT
+ * before the dvbpsi_bat_callback, NULL to stop reporting them.
+ * \param p_cb_data private data given in argument to the callback.
+ * \return true on success, false on failure or if there is no such decoder.
+ *
+ * The transport streams are compared by transport_stream_id and
+ * original_network_id and the bouquet descriptors by tag, with the previous
+ * BAT given to the delta callback. All of them are reported as added for the
+ * first one.
+ */
+bool dvbpsi_bat_set_delta_callback(dvbpsi_t *p_dvbpsi, uint8_t i_table_id,
+                                   uint16_t i_extension,
+                                   dvbpsi_bat_delta_callback pf_callback,
+                                   void* p_cb_data);
+
 /*****************************************************************************
  * dvbpsi_bat_init/dvbpsi_bat_new
  *****************************************************************************/
@@ -246,6 +295,23 @@ dvbpsi_descriptor_t *dvbpsi_bat_ts_descriptor_add(dvbpsi_bat_ts_t *p_bat,
                                                uint8_t i_tag, uint8_t i_length,
                                                uint8_t *p_data);
 
+/*****************************************************************************
+ * dvbpsi_bat_decode_descriptors
+ *****************************************************************************/
+/*!
+ * \fn unsigned int dvbpsi_bat_decode_descriptors(dvbpsi_bat_t *p_bat,
+                                                  const uint8_t *p_tags, unsigned int i_tags)
+ * \brief Decode the descriptors of the BAT and of its transport streams with the
+ * decoders registered for their tags, see dvbpsi_DecodeAllDescriptors().
+ * \param p_bat pointer to the BAT structure
+ * \param p_tags tags of the descriptors to decode, NULL to decode all of
+ * them
+ * \param i_tags number of tags in p_tags
+ * \return the number of decoded descriptors.
+ */
+unsigned int dvbpsi_bat_decode_descriptors(dvbpsi_bat_t *p_bat,
+                                           const uint8_t *p_tags, unsigned int i_tags);
+
 /*****************************************************************************
  * dvbpsi_bat_sections_generate
  *****************************************************************************/
@@ -41,6 +41,10 @@ typedef struct dvbpsi_bat_decoder_s
     dvbpsi_bat_callback           pf_bat_callback;
     void *                        p_cb_data;
 
+    dvbpsi_bat_delta_callback     pf_delta_callback;
+    void *                        p_delta_cb_data;
+    struct dvbpsi_delta_state_s * p_delta;       /* previous table */
+
     dvbpsi_bat_t                  current_bat;
     dvbpsi_bat_t *                p_building_bat;
 
@@ -152,6 +152,7 @@ void dvbpsi_eit_init(dvbpsi_eit_t* p_eit, uint8_t i_table_id, uint16_t i_extensi
     p_eit->i_segment_last_section_number = i_segment_last_section_number;
     p_eit->i_last_table_id = i_last_table_id;
     p_eit->p_first_event = NULL;
+    p_eit->p_arena = NULL;
 }
 
 /*****************************************************************************
@@ -184,8 +185,8 @@ void dvbpsi_eit_empty(dvbpsi_eit_t* p_eit)
     while(p_event != NULL)
     {
         dvbpsi_eit_event_t* p_tmp = p_event->p_next;
-        dvbpsi_DeleteDescriptors(p_event->p_first_descriptor);
-        free(p_event);
+        dvbpsi_arena_descriptors_delete(p_eit->p_arena, p_event->p_first_descriptor);
+        dvbpsi_arena_free(p_eit->p_arena, p_event);
         p_event = p_tmp;
     }
     p_eit->p_first_event = NULL;
@@ -198,22 +199,29 @@ void dvbpsi_eit_empty(dvbpsi_eit_t* p_eit)
  *****************************************************************************/
 void dvbpsi_eit_delete(dvbpsi_eit_t* p_eit)
 {
-    if (p_eit)
-        dvbpsi_eit_empty(p_eit);
-    free(p_eit);
+    if (p_eit == NULL)
+        return;
+
+    dvbpsi_eit_empty(p_eit);
+    if (p_eit->p_arena)
+        dvbpsi_arena_delete(p_eit->p_arena);
+    else
+        free(p_eit);
 }
 
 /*****************************************************************************
- * dvbpsi_eit_event_add
+ * dvbpsi_eit_event_append
  *****************************************************************************
- * Add an event description at the end of the EIT.
+ * Add an event description at the end of the EIT. The end is searched from
+ * *pp_last, the last event added by the caller or NULL, which is updated.
  *****************************************************************************/
-dvbpsi_eit_event_t* dvbpsi_eit_event_add(dvbpsi_eit_t* p_eit,
-    uint16_t i_event_id, uint64_t i_start_time, uint32_t i_duration,
+static dvbpsi_eit_event_t* dvbpsi_eit_event_append(dvbpsi_eit_t* p_eit,
+    dvbpsi_eit_event_t** pp_last, uint16_t i_event_id, uint64_t i_start_time, uint32_t i_duration,
     uint8_t i_running_status, bool b_free_ca, uint16_t i_event_descriptor_length)
 {
     dvbpsi_eit_event_t* p_event;
-    p_event = (dvbpsi_eit_event_t*)calloc(1,sizeof(dvbpsi_eit_event_t));
+    p_event = (dvbpsi_eit_event_t*)dvbpsi_arena_alloc(p_eit->p_arena,
+                                                      sizeof(dvbpsi_eit_event_t));
     if (p_event == NULL)
         return NULL;
 
@@ -232,14 +240,30 @@ dvbpsi_eit_event_t* dvbpsi_eit_event_add(dvbpsi_eit_t* p_eit,
         p_eit->p_first_event = p_event;
     else
     {
-        dvbpsi_eit_event_t* p_last_event = p_eit->p_first_event;
+        dvbpsi_eit_event_t* p_last_event = *pp_last ? *pp_last : p_eit->p_first_event;
         while(p_last_event->p_next != NULL)
             p_last_event = p_last_event->p_next;
         p_last_event->p_next = p_event;
     }
+    *pp_last = p_event;
     return p_event;
 }
 
+/*****************************************************************************
+ * dvbpsi_eit_event_add
+ *****************************************************************************
+ * Add an event description at the end of the EIT.
+ *****************************************************************************/
+dvbpsi_eit_event_t* dvbpsi_eit_event_add(dvbpsi_eit_t* p_eit,
+    uint16_t i_event_id, uint64_t i_start_time, uint32_t i_duration,
+    uint8_t i_running_status, bool b_free_ca, uint16_t i_event_descriptor_length)
+{
+    dvbpsi_eit_event_t* p_last_event = NULL;
+    return dvbpsi_eit_event_append(p_eit, &p_last_event, i_event_id, i_start_time,
+                                   i_duration, i_running_status, b_free_ca,
+                                   i_event_descriptor_length);
+}
+
 /*****************************************************************************
  * dvbpsi_eit_nvod_event_add
  *****************************************************************************
@@ -275,6 +299,27 @@ dvbpsi_descriptor_t* dvbpsi_eit_event_descriptor_add(dvbpsi_eit_event_t* p_event
     return p_descriptor;
 }
 
+/*****************************************************************************
+ * dvbpsi_eit_decode_descriptors
+ *****************************************************************************
+ * Decode the descriptors of the events of the EIT, each loop starting without
+ * private_data_specifier.
+ *****************************************************************************/
+unsigned int dvbpsi_eit_decode_descriptors(dvbpsi_eit_t *p_eit,
+                                           const uint8_t *p_tags, unsigned int i_tags)
+{
+    uint8_t p_selected[256];
+    unsigned int i_decoded = 0;
+
+    assert(p_eit);
+
+    dvbpsi_descriptors_select(p_selected, p_tags, i_tags);
+    for (dvbpsi_eit_event_t *p_event = p_eit->p_first_event; p_event;
+         p_event = p_event->p_next)
+        i_decoded += dvbpsi_descriptors_decode(p_event->p_first_descriptor, 0, p_selected);
+    return i_decoded;
+}
+
 /* */
 static void dvbpsi_ReInitEIT(dvbpsi_eit_decoder_t* p_decoder, const bool b_force)
 {
@@ -326,12 +371,17 @@ static bool dvbpsi_CheckEIT(dvbpsi_t *p_dvbpsi, dvbpsi_eit_decoder_t *p_eit_deco
     return b_reinit;
 }
 
-static bool dvbpsi_IsCompleteEIT(dvbpsi_eit_decoder_t* p_eit_decoder, dvbpsi_psi_section_t* p_section)
+/*****************************************************************************
+ * dvbpsi_eit_sections_complete
+ *****************************************************************************
+ * Is the EIT complete once section i_number is added, b_last_received telling
+ * whether the section last_section_number has been received?
+ *****************************************************************************/
+static bool dvbpsi_eit_sections_complete(const uint8_t i_first_received_section_number,
+                                         const uint8_t i_last_section_number,
+                                         const uint8_t i_number,
+                                         const bool b_last_received)
 {
-    assert(p_eit_decoder);
-
-    bool b_complete = false;
-
     /* As there may be gaps in the section_number fields (see below), we
      * have to wait until we have received a section_number twice or
      * until we have a received a section_number which is
@@ -340,42 +390,72 @@ static bool dvbpsi_IsCompleteEIT(dvbpsi_eit_decoder_t* p_eit_decoder, dvbpsi_psi
      * until the last_section_number has been received;
      * this is the only way to be sure that a complete table has been
      * sent! */
-    if ((p_eit_decoder->i_first_received_section_number > 0 &&
-        (p_section->i_number == p_eit_decoder->i_first_received_section_number ||
-         p_section->i_number == p_eit_decoder->i_first_received_section_number - 1)) ||
-        (p_eit_decoder->i_first_received_section_number == 0 &&
-         p_section->i_number == p_eit_decoder->i_last_section_number))
-    {
-        dvbpsi_psi_section_t *p = p_eit_decoder->p_sections;
-        while (p)
-        {
-            if (p->i_number == p_eit_decoder->i_last_section_number)
-            {
-                b_complete = true;
-                break;
-            }
+    if ((i_first_received_section_number > 0 &&
+        (i_number == i_first_received_section_number ||
+         i_number == i_first_received_section_number - 1)) ||
+        (i_first_received_section_number == 0 &&
+         i_number == i_last_section_number))
+    {
+        /* ETSI EN 300 468 V1.5.1 section 5.2.4 says that the EIT
+         * sections may be structured into a number of segments and
+         * that there may be a gap in the section_number between
+         * two segments (but not within a single segment); thus
+         * the sections between segments are not waited for, only the
+         * last_section_number is */
+        return b_last_received;
+    }
 
-            /* ETSI EN 300 468 V1.5.1 section 5.2.4 says that the EIT
-             * sections may be structured into a number of segments and
-             * that there may be a gap in the section_number between
-             * two segments (but not within a single segment); thus at
-             * the end of a segment (indicated by
-             * section_number == segment_last_section_number)
-             * we have to search for the beginning of the next segment) */
-            if (p->i_number == p->p_payload_start[4])
-            {
-                while (p->p_next &&
-                      (p->p_next->i_number < p_eit_decoder->i_last_section_number))
-                {
-                    p = p->p_next;
-                }
-            }
+    return false;
+}
 
-            p = p->p_next;
-        }
+static bool dvbpsi_IsCompleteEIT(dvbpsi_eit_decoder_t* p_eit_decoder, const uint8_t i_number)
+{
+    assert(p_eit_decoder);
+
+    return dvbpsi_eit_sections_complete(p_eit_decoder->i_first_received_section_number,
+                                        p_eit_decoder->i_last_section_number,
+                                        i_number,
+                                        dvbpsi_decoder_section_received(DVBPSI_DECODER(p_eit_decoder),
+                                                                        p_eit_decoder->i_last_section_number));
+}
+
+/*****************************************************************************
+ * dvbpsi_eit_building_new
+ *****************************************************************************
+ * dvbpsi_eit_new() for the first section of a table, in an arena of its own
+ * with dvbpsi_t::b_arena_tables.
+ *****************************************************************************/
+static dvbpsi_eit_t *dvbpsi_eit_building_new(dvbpsi_t *p_dvbpsi,
+                                             const dvbpsi_psi_section_t *p_section)
+{
+    dvbpsi_eit_t *p_eit;
+    dvbpsi_arena_t *p_arena = NULL;
+
+    if (p_dvbpsi->b_arena_tables)
+    {
+        p_arena = dvbpsi_arena_new(p_dvbpsi->b_zero_copy_descriptors);
+        if (p_arena == NULL)
+            return NULL;
+        p_eit = dvbpsi_arena_alloc(p_arena, sizeof(dvbpsi_eit_t));
+        assert(p_eit);
+    }
+    else
+    {
+        p_eit = (dvbpsi_eit_t*)malloc(sizeof(dvbpsi_eit_t));
+        if (p_eit == NULL)
+            return NULL;
     }
 
-    return b_complete;
+    dvbpsi_eit_init(p_eit, p_section->i_table_id, p_section->i_extension,
+                    p_section->i_version, p_section->b_current_next,
+                    ((uint16_t)(p_section->p_payload_start[0]) << 8)
+                        | p_section->p_payload_start[1],
+                    ((uint16_t)(p_section->p_payload_start[2]) << 8)
+                        | p_section->p_payload_start[3],
+                    p_section->p_payload_start[4],
+                    p_section->p_payload_start[5]);
+    p_eit->p_arena = p_arena;
+    return p_eit;
 }
 
 static bool dvbpsi_AddSectionEIT(dvbpsi_t *p_dvbpsi, dvbpsi_eit_decoder_t *p_eit_decoder,
@@ -388,17 +468,7 @@ static bool dvbpsi_AddSectionEIT(dvbpsi_t *p_dvbpsi, dvbpsi_eit_decoder_t *p_eit
     /* Initialize the structures if it's the first section received */
     if (!p_eit_decoder->p_building_eit)
     {
-        p_eit_decoder->p_building_eit = dvbpsi_eit_new(
-                                p_section->i_table_id,
-                                p_section->i_extension,
-                                p_section->i_version,
-                                p_section->b_current_next,
-                                ((uint16_t)(p_section->p_payload_start[0]) << 8)
-                                    | p_section->p_payload_start[1],
-                                ((uint16_t)(p_section->p_payload_start[2]) << 8)
-                                    | p_section->p_payload_start[3],
-                                p_section->p_payload_start[4],
-                                p_section->p_payload_start[5]);
+        p_eit_decoder->p_building_eit = dvbpsi_eit_building_new(p_dvbpsi, p_section);
 
         p_eit_decoder->i_last_section_number = p_section->i_last_number;
         p_eit_decoder->i_first_received_section_number = p_section->i_number;
@@ -408,6 +478,18 @@ static bool dvbpsi_AddSectionEIT(dvbpsi_t *p_dvbpsi, dvbpsi_eit_decoder_t *p_eit
         p_eit_decoder->i_last_section_number = p_section->i_last_number;
     }
 
+    /* Decode the section now and only remember its number */
+    if (dvbpsi_decoder_decode_on_arrival(p_dvbpsi, DVBPSI_DECODER(p_eit_decoder)))
+    {
+        if (dvbpsi_decoder_psi_section_mark(DVBPSI_DECODER(p_eit_decoder), p_section))
+            dvbpsi_debug(p_dvbpsi, "EIT decoder", "ignoring already decoded section %d",
+                         p_section->i_number);
+        else
+            dvbpsi_eit_sections_decode(p_dvbpsi, p_eit_decoder->p_building_eit, p_section);
+        dvbpsi_DeletePSISections(p_section);
+        return true;
+    }
+
     /* Add to linked list of sections */
     if (dvbpsi_decoder_psi_section_add(DVBPSI_DECODER(p_eit_decoder), p_section))
         dvbpsi_debug(p_dvbpsi, "EIT decoder",
@@ -443,7 +525,7 @@ void dvbpsi_eit_sections_gather(dvbpsi_t *p_dvbpsi, dvbpsi_decoder_t *p_private_
                         = (dvbpsi_eit_decoder_t*)p_private_decoder;
 
     /* TS discontinuity check */
-    if (p_demux->b_discontinuity)
+    if (p_demux->b_discontinuity || p_eit_decoder->b_discontinuity)
     {
         dvbpsi_ReInitEIT(p_eit_decoder, true);
         p_eit_decoder->b_discontinuity = false;
@@ -473,7 +555,8 @@ void dvbpsi_eit_sections_gather(dvbpsi_t *p_dvbpsi, dvbpsi_decoder_t *p_private_
         }
     }
 
-    /* Add section to EIT */
+    /* Add section to EIT, it may be deleted when decoded on arrival */
+    const uint8_t i_number = p_section->i_number;
     if (!dvbpsi_AddSectionEIT(p_dvbpsi, p_eit_decoder, p_section))
     {
         dvbpsi_error(p_dvbpsi, "EIT decoder", "failed decoding section %d",
@@ -483,16 +566,18 @@ void dvbpsi_eit_sections_gather(dvbpsi_t *p_dvbpsi, dvbpsi_decoder_t *p_private_
     }
 
     /* Check if we have all the sections */
-    /* FIXME: p_section has just been added to the p_eit_decoder,
-     * Why do we have to explicitly check against it in dvbpsi_IsCompleteEIT() ?
-     */
-    if (dvbpsi_IsCompleteEIT(p_eit_decoder, p_section))
+    if (dvbpsi_IsCompleteEIT(p_eit_decoder, i_number))
     {
         assert(p_eit_decoder->pf_eit_callback);
 
         /* Save the current information */
         p_eit_decoder->current_eit = *p_eit_decoder->p_building_eit;
         p_eit_decoder->b_current_valid = true;
+        dvbpsi_decoder_current_set(DVBPSI_DECODER(p_eit_decoder),
+                                   p_eit_decoder->p_building_eit->i_table_id,
+                                   p_eit_decoder->p_building_eit->i_extension,
+                                   p_eit_decoder->p_building_eit->i_version,
+                                   p_eit_decoder->p_building_eit->b_current_next);
 
         /* Decode the sections */
         dvbpsi_eit_sections_decode(p_dvbpsi,
@@ -508,6 +593,376 @@ void dvbpsi_eit_sections_gather(dvbpsi_t *p_dvbpsi, dvbpsi_decoder_t *p_private_
     }
 }
 
+/*****************************************************************************
+ * dvbpsi_eit_subtable_reset
+ *****************************************************************************
+ * Drop the table being built by a subtable of a range decoder.
+ *****************************************************************************/
+static void dvbpsi_eit_subtable_reset(dvbpsi_eit_subtable_t *p_subtable, const bool b_force)
+{
+    if (b_force)
+    {
+        p_subtable->b_current_valid = false;
+        if (p_subtable->p_building_eit)
+            dvbpsi_eit_delete(p_subtable->p_building_eit);
+    }
+    p_subtable->p_building_eit = NULL;
+
+    dvbpsi_DeletePSISections(p_subtable->p_sections);
+    p_subtable->p_sections = NULL;
+    memset(p_subtable->i_sections_received, 0, sizeof(p_subtable->i_sections_received));
+}
+
+/*****************************************************************************
+ * dvbpsi_eit_subtable_find
+ *****************************************************************************
+ * Find the state of subtable i_id in a range decoder.
+ *****************************************************************************/
+static dvbpsi_eit_subtable_t *dvbpsi_eit_subtable_find(const dvbpsi_eit_range_decoder_t *p_decoder,
+                                                       const uint32_t i_id)
+{
+    dvbpsi_eit_subtable_t *p_subtable =
+        p_decoder->pp_buckets[((i_id * 2654435761u) >> 8) & p_decoder->i_mask];
+
+    while (p_subtable && p_subtable->i_id != i_id)
+        p_subtable = p_subtable->p_next;
+    return p_subtable;
+}
+
+/*****************************************************************************
+ * dvbpsi_eit_subtable_get
+ *****************************************************************************
+ * Find the state of subtable i_id in a range decoder, create it if needed.
+ *****************************************************************************/
+static dvbpsi_eit_subtable_t *dvbpsi_eit_subtable_get(dvbpsi_eit_range_decoder_t *p_decoder,
+                                                      const uint32_t i_id)
+{
+    dvbpsi_eit_subtable_t *p_subtable = dvbpsi_eit_subtable_find(p_decoder, i_id);
+    if (p_subtable)
+        return p_subtable;
+
+    unsigned int i_bucket = ((i_id * 2654435761u) >> 8) & p_decoder->i_mask;
+
+    /* Grow the hash when it has as many subtables as buckets */
+    if (p_decoder->i_subtables > p_decoder->i_mask)
+    {
+        const unsigned int i_size = 2 * (p_decoder->i_mask + 1);
+        dvbpsi_eit_subtable_t **pp_buckets = calloc(i_size, sizeof(dvbpsi_eit_subtable_t *));
+        if (pp_buckets)
+        {
+            for (unsigned int i = 0; i <= p_decoder->i_mask; i++)
+            {
+                dvbpsi_eit_subtable_t *p = p_decoder->pp_buckets[i];
+                while (p)
+                {
+                    dvbpsi_eit_subtable_t *p_next = p->p_next;
+                    unsigned int j = ((p->i_id * 2654435761u) >> 8) & (i_size - 1);
+                    p->p_next = pp_buckets[j];
+                    pp_buckets[j] = p;
+                    p = p_next;
+                }
+            }
+            free(p_decoder->pp_buckets);
+            p_decoder->pp_buckets = pp_buckets;
+            p_decoder->i_mask = i_size - 1;
+            i_bucket = ((i_id * 2654435761u) >> 8) & p_decoder->i_mask;
+        }
+    }
+
+    if (p_decoder->p_chunks == NULL
+     || p_decoder->i_chunk_used == DVBPSI_EIT_SUBTABLE_CHUNK)
+    {
+        dvbpsi_eit_subtable_chunk_t *p_chunk = malloc(sizeof(dvbpsi_eit_subtable_chunk_t));
+        if (p_chunk == NULL)
+            return NULL;
+        p_chunk->p_next = p_decoder->p_chunks;
+        p_decoder->p_chunks = p_chunk;
+        p_decoder->i_chunk_used = 0;
+    }
+
+    p_subtable = &p_decoder->p_chunks->p_subtables[p_decoder->i_chunk_used++];
+    memset(p_subtable, 0, sizeof(dvbpsi_eit_subtable_t));
+    p_subtable->i_id = i_id;
+    p_subtable->p_next = p_decoder->pp_buckets[i_bucket];
+    p_decoder->pp_buckets[i_bucket] = p_subtable;
+    p_decoder->i_subtables++;
+    return p_subtable;
+}
+
+/*****************************************************************************
+ * dvbpsi_eit_range_sections_gather
+ *****************************************************************************
+ * Callback for the subtable demultiplexor, same steps as
+ * dvbpsi_eit_sections_gather() on the state of the section subtable.
+ *****************************************************************************/
+static void dvbpsi_eit_range_sections_gather(dvbpsi_t *p_dvbpsi,
+                                             dvbpsi_decoder_t *p_private_decoder,
+                                             dvbpsi_psi_section_t *p_section)
+{
+    assert(p_dvbpsi);
+    assert(p_dvbpsi->p_decoder);
+
+    if (!dvbpsi_CheckPSISection(p_dvbpsi, p_section, p_section->i_table_id, "EIT decoder"))
+    {
+        dvbpsi_DeletePSISections(p_section);
+        return;
+    }
+
+    dvbpsi_demux_t *p_demux = (dvbpsi_demux_t *) p_dvbpsi->p_decoder;
+    dvbpsi_eit_range_decoder_t *p_decoder = (dvbpsi_eit_range_decoder_t *)p_private_decoder;
+
+    /* TS discontinuity: all the subtables start over */
+    if (p_demux->b_discontinuity)
+    {
+        for (dvbpsi_eit_subtable_chunk_t *p_chunk = p_decoder->p_chunks; p_chunk;
+             p_chunk = p_chunk->p_next)
+        {
+            unsigned int i_used = (p_chunk == p_decoder->p_chunks)
+                                ? p_decoder->i_chunk_used : DVBPSI_EIT_SUBTABLE_CHUNK;
+            for (unsigned int i = 0; i < i_used; i++)
+                dvbpsi_eit_subtable_reset(&p_chunk->p_subtables[i], true);
+        }
+        p_decoder->b_discontinuity = false;
+        p_demux->b_discontinuity = false;
+    }
+
+    dvbpsi_eit_subtable_t *p_subtable =
+        dvbpsi_eit_subtable_get(p_decoder, (uint32_t)p_section->i_table_id << 16
+                                           | p_section->i_extension);
+    if (p_subtable == NULL)
+    {
+        dvbpsi_error(p_dvbpsi, "EIT decoder", "out of memory");
+        dvbpsi_DeletePSISections(p_section);
+        return;
+    }
+
+    /* Perform a few sanity checks */
+    if (p_subtable->p_building_eit)
+    {
+        if (p_subtable->p_building_eit->i_version != p_section->i_version
+         || p_subtable->i_last_section_number != p_section->i_last_number)
+        {
+            dvbpsi_error(p_dvbpsi, "EIT decoder",
+                         "'version_number' or 'last_section_number' differs"
+                         " whereas no discontinuity has occurred");
+            dvbpsi_eit_subtable_reset(p_subtable, true);
+        }
+    }
+    else if (p_subtable->b_current_valid
+          && p_subtable->i_version == p_section->i_version
+          && p_subtable->b_current_next == p_section->b_current_next)
+    {
+        /* Don't decode since this version is already decoded */
+        dvbpsi_DeletePSISections(p_section);
+        return;
+    }
+
+    /* Initialize the structures if it's the first section received */
+    if (!p_subtable->p_building_eit)
+    {
+        p_subtable->p_building_eit = dvbpsi_eit_building_new(p_dvbpsi, p_section);
+        if (p_subtable->p_building_eit == NULL)
+        {
+            dvbpsi_error(p_dvbpsi, "EIT decoder", "failed decoding section %d",
+                         p_section->i_number);
+            dvbpsi_DeletePSISections(p_section);
+            return;
+        }
+        p_subtable->i_last_section_number = p_section->i_last_number;
+        p_subtable->i_first_received_section_number = p_section->i_number;
+    }
+
+    /* Same choice as dvbpsi_decoder_decode_on_arrival() */
+    bool b_decode_on_arrival = p_dvbpsi->b_decode_on_arrival;
+    if (p_subtable->p_sections)
+        b_decode_on_arrival = false;
+    else
+    {
+        for (unsigned int i = 0; i < ARRAY_SIZE(p_subtable->i_sections_received); i++)
+            if (p_subtable->i_sections_received[i])
+                b_decode_on_arrival = true;
+    }
+
+    const uint8_t i_number = p_section->i_number;
+    uint32_t *p_word = &p_subtable->i_sections_received[i_number / 32];
+    const uint32_t i_bit = (uint32_t)1 << (i_number % 32);
+    const bool b_received = (*p_word & i_bit) != 0;
+    *p_word |= i_bit;
+
+    if (b_decode_on_arrival)
+    {
+        /* Decode the section now and only remember its number */
+        if (b_received)
+            dvbpsi_debug(p_dvbpsi, "EIT decoder",
+                         "ignoring already decoded section %d", i_number);
+        else
+            dvbpsi_eit_sections_decode(p_dvbpsi, p_subtable->p_building_eit, p_section);
+        dvbpsi_DeletePSISections(p_section);
+    }
+    /* Add to linked list of sections */
+    else if (dvbpsi_psi_sections_insert(&p_subtable->p_sections, p_section))
+        dvbpsi_debug(p_dvbpsi, "EIT decoder",
+                     "overwrite section number %d", i_number);
+
+    /* Check if we have all the sections */
+    const uint8_t i_last = p_subtable->i_last_section_number;
+    if (dvbpsi_eit_sections_complete(p_subtable->i_first_received_section_number,
+                                     i_last, i_number,
+                                     (p_subtable->i_sections_received[i_last / 32]
+                                        >> (i_last % 32)) & 1))
+    {
+        assert(p_decoder->pf_eit_callback);
+
+        /* Save the current information */
+        p_subtable->i_version = p_subtable->p_building_eit->i_version;
+        p_subtable->b_current_next = p_subtable->p_building_eit->b_current_next;
+        p_subtable->b_current_valid = true;
+
+        /* Decode the sections */
+        dvbpsi_eit_sections_decode(p_dvbpsi, p_subtable->p_building_eit,
+                                   p_subtable->p_sections);
+
+        /* signal the new EIT, the callback owns it */
+        p_decoder->pf_eit_callback(p_decoder->p_cb_data, p_subtable->p_building_eit);
+
+        dvbpsi_eit_subtable_reset(p_subtable, false);
+    }
+    else if (p_dvbpsi->b_zero_copy && !dvbpsi_OwnPSISections(p_subtable->p_sections))
+    {
+        /* The TS packet goes away when dvbpsi_packet_push() returns */
+        dvbpsi_error(p_dvbpsi, "EIT decoder", "failed to copy kept sections");
+        dvbpsi_eit_subtable_reset(p_subtable, true);
+    }
+}
+
+/*****************************************************************************
+ * dvbpsi_eit_range_idle
+ *****************************************************************************
+ * Callback for the subtable demultiplexor: does subtable (i_table_id,
+ * i_extension) hold a complete EIT and build none?
+ *****************************************************************************/
+static bool dvbpsi_eit_range_idle(dvbpsi_decoder_t *p_private_decoder,
+                                  uint8_t i_table_id, uint16_t i_extension,
+                                  uint8_t *pi_version, bool *pb_current_next)
+{
+    const dvbpsi_eit_range_decoder_t *p_decoder =
+        (const dvbpsi_eit_range_decoder_t *)p_private_decoder;
+    const dvbpsi_eit_subtable_t *p_subtable =
+        dvbpsi_eit_subtable_find(p_decoder, (uint32_t)i_table_id << 16 | i_extension);
+
+    if (p_subtable == NULL || !p_subtable->b_current_valid
+     || p_subtable->p_building_eit || p_subtable->p_sections)
+        return false;
+
+    /* Sections decoded on arrival are only marked as received */
+    for (unsigned int i = 0; i < ARRAY_SIZE(p_subtable->i_sections_received); i++)
+        if (p_subtable->i_sections_received[i])
+            return false;
+
+    *pi_version = p_subtable->i_version;
+    *pb_current_next = p_subtable->b_current_next;
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_eit_range_attach
+ *****************************************************************************
+ * Initialize an EIT range decoder.
+ *****************************************************************************/
+bool dvbpsi_eit_range_attach(dvbpsi_t *p_dvbpsi, uint8_t i_table_id_min,
+                             uint8_t i_table_id_max,
+                             dvbpsi_eit_callback pf_callback, void* p_cb_data)
+{
+    assert(p_dvbpsi);
+    assert(p_dvbpsi->p_decoder);
+    assert(i_table_id_min <= i_table_id_max);
+
+    dvbpsi_demux_t* p_demux = (dvbpsi_demux_t*)p_dvbpsi->p_decoder;
+
+    dvbpsi_eit_range_decoder_t *p_decoder;
+    p_decoder = (dvbpsi_eit_range_decoder_t*) dvbpsi_decoder_new(NULL,
+                                    0, true, sizeof(dvbpsi_eit_range_decoder_t));
+    if (p_decoder == NULL)
+        return false;
+
+    p_decoder->pf_eit_callback = pf_callback;
+    p_decoder->p_cb_data = p_cb_data;
+    p_decoder->i_mask = 63;
+    p_decoder->pp_buckets = calloc(p_decoder->i_mask + 1, sizeof(dvbpsi_eit_subtable_t *));
+    if (p_decoder->pp_buckets == NULL)
+    {
+        dvbpsi_decoder_delete(DVBPSI_DECODER(p_decoder));
+        return false;
+    }
+
+    dvbpsi_demux_range_t *p_range;
+    p_range = dvbpsi_demux_range_new(i_table_id_min, i_table_id_max,
+                                     dvbpsi_eit_range_detach,
+                                     dvbpsi_eit_range_sections_gather,
+                                     DVBPSI_DECODER(p_decoder));
+    if (p_range == NULL)
+    {
+        free(p_decoder->pp_buckets);
+        dvbpsi_decoder_delete(DVBPSI_DECODER(p_decoder));
+        return false;
+    }
+    p_range->pf_idle = dvbpsi_eit_range_idle;
+
+    if (!dvbpsi_demux_range_attach(p_demux, p_range))
+    {
+        dvbpsi_error(p_dvbpsi, "EIT decoder",
+                     "Already a decoder for table_id 0x%02x to 0x%02x",
+                     i_table_id_min, i_table_id_max);
+        free(p_decoder->pp_buckets);
+        dvbpsi_demux_range_delete(p_range);
+        return false;
+    }
+    return true;
+}
+
+/*****************************************************************************
+ * dvbpsi_eit_range_detach
+ *****************************************************************************
+ * Close an EIT range decoder.
+ *****************************************************************************/
+void dvbpsi_eit_range_detach(dvbpsi_t *p_dvbpsi, uint8_t i_table_id_min,
+                             uint8_t i_table_id_max)
+{
+    assert(p_dvbpsi);
+    assert(p_dvbpsi->p_decoder);
+
+    dvbpsi_demux_t *p_demux = (dvbpsi_demux_t *) p_dvbpsi->p_decoder;
+
+    dvbpsi_demux_range_t *p_range = dvbpsi_demux_range_get(p_demux, i_table_id_min);
+    if (p_range == NULL || p_range->i_table_id_min != i_table_id_min
+     || p_range->i_table_id_max != i_table_id_max)
+    {
+        dvbpsi_error(p_dvbpsi, "EIT Decoder",
+                     "No such EIT decoder (table_id == 0x%02x to 0x%02x)",
+                     i_table_id_min, i_table_id_max);
+        return;
+    }
+
+    dvbpsi_eit_range_decoder_t *p_decoder = (dvbpsi_eit_range_decoder_t *)p_range->p_decoder;
+    dvbpsi_eit_subtable_chunk_t *p_chunk = p_decoder->p_chunks;
+    unsigned int i_used = p_decoder->i_chunk_used;
+    while (p_chunk)
+    {
+        dvbpsi_eit_subtable_chunk_t *p_next = p_chunk->p_next;
+        for (unsigned int i = 0; i < i_used; i++)
+            dvbpsi_eit_subtable_reset(&p_chunk->p_subtables[i], true);
+        free(p_chunk);
+        p_chunk = p_next;
+        i_used = DVBPSI_EIT_SUBTABLE_CHUNK;
+    }
+    p_decoder->p_chunks = NULL;
+    free(p_decoder->pp_buckets);
+    p_decoder->pp_buckets = NULL;
+
+    dvbpsi_demux_range_detach(p_demux, p_range);
+    dvbpsi_demux_range_delete(p_range);
+}
+
 /*****************************************************************************
  * dvbpsi_eit_sections_decode
  *****************************************************************************
@@ -517,10 +972,13 @@ void dvbpsi_eit_sections_decode(dvbpsi_t *p_dvbpsi,
                                 dvbpsi_eit_t* p_eit,
                                 dvbpsi_psi_section_t* p_section)
 {
+    dvbpsi_eit_event_t* p_last_event = NULL;
     uint8_t* p_byte, *p_end;
 
     while (p_section)
     {
+        dvbpsi_arena_section_keep(p_eit->p_arena, p_section);
+
         /* EIT Event Descriptions */
         p_byte = p_section->p_payload_start + 6;
         p_end  = p_section->p_payload_end;
@@ -540,13 +998,14 @@ void dvbpsi_eit_sections_decode(dvbpsi_t *p_dvbpsi,
             bool b_free_ca = ((p_byte[10] & 0x10) == 0x10) ? true : false;
             uint16_t i_ev_length = ((uint16_t)(p_byte[10] & 0xf) << 8) |
                                                p_byte[11];
-            dvbpsi_eit_event_t *p_event = dvbpsi_eit_event_add(p_eit,
+            dvbpsi_eit_event_t *p_event = dvbpsi_eit_event_append(p_eit, &p_last_event,
                                                 i_event_id, i_start_time, i_duration,
                                                 i_running_status, b_free_ca, i_ev_length);
             if (!p_event)
                 break;
 
             /* Event Descriptors */
+            dvbpsi_descriptor_t *p_last_descriptor = NULL;
             p_byte += 12;
             uint8_t *p_ev_end = p_byte + i_ev_length;
             if (p_ev_end > p_section->p_payload_end)
@@ -556,7 +1015,9 @@ void dvbpsi_eit_sections_decode(dvbpsi_t *p_dvbpsi,
                 uint8_t i_tag = p_byte[0];
                 uint8_t i_length = p_byte[1];
                 if (i_length + 2 <= p_ev_end - p_byte)
-                    dvbpsi_eit_event_descriptor_add(p_event, i_tag, i_length, p_byte + 2);
+                    dvbpsi_arena_descriptor_add(p_eit->p_arena, &p_event->p_first_descriptor,
+                                                &p_last_descriptor,
+                                                i_tag, i_length, p_byte + 2);
                 else
                 {
                     dvbpsi_error(p_dvbpsi, "EIT decoder", "failed decoding "
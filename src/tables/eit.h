@@ -98,6 +98,10 @@ typedef struct dvbpsi_eit_s
 
     dvbpsi_eit_event_t *p_first_event;      /*!< event information list */
 
+    struct dvbpsi_arena_s *p_arena;         /*!< private: memory of the
+                                                 table when decoded with
+                                                 dvbpsi_s::b_arena_tables */
+
 } dvbpsi_eit_t;
 
 /*****************************************************************************
@@ -142,6 +146,52 @@ bool dvbpsi_eit_attach(dvbpsi_t *p_dvbpsi, uint8_t i_table_id, uint16_t i_extens
  */
 void dvbpsi_eit_detach(dvbpsi_t *p_dvbpsi, uint8_t i_table_id, uint16_t i_extension);
 
+/*****************************************************************************
+ * dvbpsi_eit_range_attach
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_eit_range_attach(dvbpsi_t *p_dvbpsi, uint8_t i_table_id_min,
+                                    uint8_t i_table_id_max,
+                                    dvbpsi_eit_callback pf_callback,
+                                    void* p_cb_data)
+ * \brief Creation and initialization of an EIT decoder for all the services
+ * of a range of table ids.
+ * \param p_dvbpsi pointer to Subtable demultiplexor to which the EIT decoder is attached.
+ * \param i_table_id_min first table ID of the range, 0x4E to 0x6F.
+ * \param i_table_id_max last table ID of the range, 0x4E to 0x6F.
+ * \param pf_callback function to call back on new EIT of any subtable.
+ * \param p_cb_data private data given in argument to the callback.
+ * \return true on success, false on failure or when the range overlaps
+ * another range decoder.
+ *
+ * One decoder handles all the (table_id, service_id) subtables of the range,
+ * for instance 0x50 to 0x6F for the EIT schedule of the actual transport
+ * stream. It keeps a small state per subtable instead of a full EIT
+ * decoder. Subtables having an EIT decoder attached with
+ * dvbpsi_eit_attach() are still given to it. The repetitions of a complete
+ * subtable are dropped before reassembly, and by the section cache, as for
+ * an EIT decoder of its own.
+ */
+bool dvbpsi_eit_range_attach(dvbpsi_t *p_dvbpsi, uint8_t i_table_id_min,
+                             uint8_t i_table_id_max,
+                             dvbpsi_eit_callback pf_callback, void* p_cb_data);
+
+/*****************************************************************************
+ * dvbpsi_eit_range_detach
+ *****************************************************************************/
+/*!
+ * \fn void dvbpsi_eit_range_detach(dvbpsi_t *p_dvbpsi, uint8_t i_table_id_min,
+                                    uint8_t i_table_id_max)
+ * \brief Destroy an EIT range decoder.
+ * \param p_dvbpsi dvbpsi handle pointing to Subtable demultiplexor to which the
+                   eit decoder is attached.
+ * \param i_table_id_min first table ID of the range.
+ * \param i_table_id_max last table ID of the range.
+ * \return nothing.
+ */
+void dvbpsi_eit_range_detach(dvbpsi_t *p_dvbpsi, uint8_t i_table_id_min,
+                             uint8_t i_table_id_max);
+
 /*****************************************************************************
  * dvbpsi_eit_init/dvbpsi_eit_new
  *****************************************************************************/
@@ -279,6 +329,23 @@ dvbpsi_descriptor_t* dvbpsi_eit_event_descriptor_add(
                                                uint8_t i_tag, uint8_t i_length,
                                                uint8_t* p_data);
 
+/*****************************************************************************
+ * dvbpsi_eit_decode_descriptors
+ *****************************************************************************/
+/*!
+ * \fn unsigned int dvbpsi_eit_decode_descriptors(dvbpsi_eit_t *p_eit,
+                                                  const uint8_t *p_tags, unsigned int i_tags)
+ * \brief Decode the descriptors of the events of the EIT with the
+ * decoders registered for their tags, see dvbpsi_DecodeAllDescriptors().
+ * \param p_eit pointer to the EIT structure
+ * \param p_tags tags of the descriptors to decode, NULL to decode all of
+ * them
+ * \param i_tags number of tags in p_tags
+ * \return the number of decoded descriptors.
+ */
+unsigned int dvbpsi_eit_decode_descriptors(dvbpsi_eit_t *p_eit,
+                                           const uint8_t *p_tags, unsigned int i_tags);
+
 /*****************************************************************************
  * dvbpsi_eit_sections_generate
  *****************************************************************************
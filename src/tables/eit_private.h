@@ -47,6 +47,57 @@ typedef struct dvbpsi_eit_decoder_s
 
 } dvbpsi_eit_decoder_t;
 
+/*****************************************************************************
+ * dvbpsi_eit_subtable_t
+ *****************************************************************************
+ * State of one subtable of an EIT range decoder, the part of
+ * dvbpsi_eit_decoder_t which depends on the subtable.
+ *****************************************************************************/
+typedef struct dvbpsi_eit_subtable_s
+{
+    uint32_t                      i_id;     /* table_id << 16 | service_id */
+    bool                          b_current_valid;
+    bool                          b_current_next;
+    uint8_t                       i_version;
+    uint8_t                       i_last_section_number;
+    uint8_t                       i_first_received_section_number;
+
+    dvbpsi_eit_t *                p_building_eit;
+    dvbpsi_psi_section_t *        p_sections;
+    uint32_t                      i_sections_received[8]; /* section_number bitmap */
+
+    struct dvbpsi_eit_subtable_s *p_next;   /* same hash bucket */
+} dvbpsi_eit_subtable_t;
+
+/* Subtables are allocated by chunks and freed with the range decoder */
+#define DVBPSI_EIT_SUBTABLE_CHUNK 64
+
+typedef struct dvbpsi_eit_subtable_chunk_s
+{
+    struct dvbpsi_eit_subtable_chunk_s *p_next;
+    dvbpsi_eit_subtable_t         p_subtables[DVBPSI_EIT_SUBTABLE_CHUNK];
+} dvbpsi_eit_subtable_chunk_t;
+
+/*****************************************************************************
+ * dvbpsi_eit_range_decoder_t
+ *****************************************************************************
+ * EIT decoder for all the subtables of a range of table ids.
+ *****************************************************************************/
+typedef struct dvbpsi_eit_range_decoder_s
+{
+    DVBPSI_DECODER_COMMON
+
+    dvbpsi_eit_callback           pf_eit_callback;
+    void *                        p_cb_data;
+
+    dvbpsi_eit_subtable_t **      pp_buckets;   /* hash of the subtables */
+    unsigned int                  i_mask;       /* buckets - 1 */
+    unsigned int                  i_subtables;
+
+    dvbpsi_eit_subtable_chunk_t * p_chunks;     /* last allocated first */
+    unsigned int                  i_chunk_used; /* subtables of p_chunks in use */
+} dvbpsi_eit_range_decoder_t;
+
 /*****************************************************************************
  * dvbpsi_eit_sections_gather
  *****************************************************************************
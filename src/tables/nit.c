@@ -46,6 +46,7 @@
 #include "../dvbpsi_private.h"
 #include "../psi.h"
 #include "../descriptor.h"
+#include "../delta.h"
 #include "../demux.h"
 #include "nit.h"
 #include "nit_private.h"
@@ -126,12 +127,53 @@ void dvbpsi_nit_detach(dvbpsi_t * p_dvbpsi, uint8_t i_table_id, uint16_t i_exten
     if (p_nit_decoder->p_building_nit)
         dvbpsi_nit_delete(p_nit_decoder->p_building_nit);
     p_nit_decoder->p_building_nit = NULL;
+    dvbpsi_delta_state_delete(p_nit_decoder->p_delta);
 
     /* Free demux sub table decoder */
     dvbpsi_DetachDemuxSubDecoder(p_demux, p_subdec);
     dvbpsi_DeleteDemuxSubDecoder(p_subdec);
 }
 
+/*****************************************************************************
+ * dvbpsi_nit_set_delta_callback
+ *****************************************************************************
+ * Report the changes of the next NITs.
+ *****************************************************************************/
+bool dvbpsi_nit_set_delta_callback(dvbpsi_t *p_dvbpsi, uint8_t i_table_id,
+                                   uint16_t i_extension,
+                                   dvbpsi_nit_delta_callback pf_callback,
+                                   void* p_cb_data)
+{
+    assert(p_dvbpsi);
+    assert(p_dvbpsi->p_decoder);
+
+    dvbpsi_nit_decoder_t *p_nit_decoder = (dvbpsi_nit_decoder_t *)
+            dvbpsi_demux_decoder_find(p_dvbpsi->p_decoder, i_table_id, i_extension);
+    if (p_nit_decoder == NULL)
+    {
+        dvbpsi_error(p_dvbpsi, "NIT decoder",
+                     "No such NIT decoder (table_id == 0x%02x,"
+                     "extension == 0x%02x)",
+                     i_table_id, i_extension);
+        return false;
+    }
+
+    if (pf_callback == NULL)
+    {
+        dvbpsi_delta_state_delete(p_nit_decoder->p_delta);
+        p_nit_decoder->p_delta = NULL;
+    }
+    else if (p_nit_decoder->p_delta == NULL)
+    {
+        p_nit_decoder->p_delta = dvbpsi_delta_state_new();
+        if (p_nit_decoder->p_delta == NULL)
+            return false;
+    }
+    p_nit_decoder->pf_delta_callback = pf_callback;
+    p_nit_decoder->p_delta_cb_data = p_cb_data;
+    return true;
+}
+
 /****************************************************************************
  * dvbpsi_nit_init
  *****************************************************************************
@@ -148,6 +190,7 @@ void dvbpsi_nit_init(dvbpsi_nit_t* p_nit, uint8_t i_table_id, uint16_t i_extensi
     p_nit->b_current_next = b_current_next;
     p_nit->p_first_descriptor = NULL;
     p_nit->p_first_ts = NULL;
+    p_nit->p_arena = NULL;
 }
 
 /****************************************************************************
@@ -175,13 +218,13 @@ void dvbpsi_nit_empty(dvbpsi_nit_t* p_nit)
 {
     dvbpsi_nit_ts_t* p_ts = p_nit->p_first_ts;
 
-    dvbpsi_DeleteDescriptors(p_nit->p_first_descriptor);
+    dvbpsi_arena_descriptors_delete(p_nit->p_arena, p_nit->p_first_descriptor);
 
     while (p_ts != NULL)
     {
         dvbpsi_nit_ts_t* p_tmp = p_ts->p_next;
-        dvbpsi_DeleteDescriptors(p_ts->p_first_descriptor);
-        free(p_ts);
+        dvbpsi_arena_descriptors_delete(p_nit->p_arena, p_ts->p_first_descriptor);
+        dvbpsi_arena_free(p_nit->p_arena, p_ts);
         p_ts = p_tmp;
     }
 
@@ -196,9 +239,14 @@ void dvbpsi_nit_empty(dvbpsi_nit_t* p_nit)
  *****************************************************************************/
 void dvbpsi_nit_delete(dvbpsi_nit_t *p_nit)
 {
-    if (p_nit)
-        dvbpsi_nit_empty(p_nit);
-    free(p_nit);
+    if (p_nit == NULL)
+        return;
+
+    dvbpsi_nit_empty(p_nit);
+    if (p_nit->p_arena)
+        dvbpsi_arena_delete(p_nit->p_arena);
+    else
+        free(p_nit);
 }
 
 /*****************************************************************************
@@ -211,7 +259,7 @@ dvbpsi_descriptor_t* dvbpsi_nit_descriptor_add(dvbpsi_nit_t* p_nit,
                                                uint8_t* p_data)
 {
     dvbpsi_descriptor_t* p_descriptor
-                        = dvbpsi_NewDescriptor(i_tag, i_length, p_data);
+                        = dvbpsi_arena_descriptor_new(p_nit->p_arena, i_tag, i_length, p_data);
     if (p_descriptor == NULL)
         return NULL;
 
@@ -228,14 +276,16 @@ dvbpsi_descriptor_t* dvbpsi_nit_descriptor_add(dvbpsi_nit_t* p_nit,
 }
 
 /*****************************************************************************
- * dvbpsi_nit_ts_add
+ * dvbpsi_nit_ts_append
  *****************************************************************************
- * Add an TS in the NIT.
+ * Add an TS in the NIT. The end is searched from *pp_last, the last TS added
+ * by the caller or NULL, which is updated.
  *****************************************************************************/
-dvbpsi_nit_ts_t* dvbpsi_nit_ts_add(dvbpsi_nit_t* p_nit,
-                                   uint16_t i_ts_id, uint16_t i_orig_network_id)
+static dvbpsi_nit_ts_t* dvbpsi_nit_ts_append(dvbpsi_nit_t* p_nit, dvbpsi_nit_ts_t** pp_last,
+                                             uint16_t i_ts_id, uint16_t i_orig_network_id)
 {
-    dvbpsi_nit_ts_t* p_ts = (dvbpsi_nit_ts_t*)malloc(sizeof(dvbpsi_nit_ts_t));
+    dvbpsi_nit_ts_t* p_ts = (dvbpsi_nit_ts_t*)dvbpsi_arena_alloc(p_nit->p_arena,
+                                                                 sizeof(dvbpsi_nit_ts_t));
     if (p_ts == NULL)
         return NULL;
 
@@ -248,14 +298,27 @@ dvbpsi_nit_ts_t* dvbpsi_nit_ts_add(dvbpsi_nit_t* p_nit,
         p_nit->p_first_ts = p_ts;
     else
     {
-        dvbpsi_nit_ts_t* p_last_ts = p_nit->p_first_ts;
+        dvbpsi_nit_ts_t* p_last_ts = *pp_last ? *pp_last : p_nit->p_first_ts;
         while(p_last_ts->p_next != NULL)
             p_last_ts = p_last_ts->p_next;
         p_last_ts->p_next = p_ts;
     }
+    *pp_last = p_ts;
     return p_ts;
 }
 
+/*****************************************************************************
+ * dvbpsi_nit_ts_add
+ *****************************************************************************
+ * Add an TS in the NIT.
+ *****************************************************************************/
+dvbpsi_nit_ts_t* dvbpsi_nit_ts_add(dvbpsi_nit_t* p_nit,
+                                   uint16_t i_ts_id, uint16_t i_orig_network_id)
+{
+    dvbpsi_nit_ts_t* p_last_ts = NULL;
+    return dvbpsi_nit_ts_append(p_nit, &p_last_ts, i_ts_id, i_orig_network_id);
+}
+
 /*****************************************************************************
  * dvbpsi_nit_ts_descriptor_add
  *****************************************************************************
@@ -279,6 +342,27 @@ dvbpsi_descriptor_t* dvbpsi_nit_ts_descriptor_add(dvbpsi_nit_ts_t* p_ts,
     return p_descriptor;
 }
 
+/*****************************************************************************
+ * dvbpsi_nit_decode_descriptors
+ *****************************************************************************
+ * Decode the descriptors of the NIT and of its transport streams, each loop
+ * starting without private_data_specifier.
+ *****************************************************************************/
+unsigned int dvbpsi_nit_decode_descriptors(dvbpsi_nit_t *p_nit,
+                                           const uint8_t *p_tags, unsigned int i_tags)
+{
+    uint8_t p_selected[256];
+    unsigned int i_decoded = 0;
+
+    assert(p_nit);
+
+    dvbpsi_descriptors_select(p_selected, p_tags, i_tags);
+    i_decoded += dvbpsi_descriptors_decode(p_nit->p_first_descriptor, 0, p_selected);
+    for (dvbpsi_nit_ts_t *p_ts = p_nit->p_first_ts; p_ts; p_ts = p_ts->p_next)
+        i_decoded += dvbpsi_descriptors_decode(p_ts->p_first_descriptor, 0, p_selected);
+    return i_decoded;
+}
+
 /* */
 static void dvbpsi_ReInitNIT(dvbpsi_nit_decoder_t* p_decoder, const bool b_force)
 {
@@ -325,6 +409,31 @@ static bool dvbpsi_CheckNIT(dvbpsi_t *p_dvbpsi, dvbpsi_nit_decoder_t *p_nit_deco
     return b_reinit;
 }
 
+/*****************************************************************************
+ * dvbpsi_nit_building_new
+ *****************************************************************************
+ * dvbpsi_nit_new() in an arena of its own with dvbpsi_t::b_arena_tables.
+ *****************************************************************************/
+static dvbpsi_nit_t *dvbpsi_nit_building_new(dvbpsi_t *p_dvbpsi, uint8_t i_table_id,
+                                             uint16_t i_extension, uint16_t i_network_id,
+                                             uint8_t i_version, bool b_current_next)
+{
+    if (!p_dvbpsi->b_arena_tables)
+        return dvbpsi_nit_new(i_table_id, i_extension, i_network_id, i_version,
+                              b_current_next);
+
+    dvbpsi_arena_t *p_arena = dvbpsi_arena_new(p_dvbpsi->b_zero_copy_descriptors);
+    if (p_arena == NULL)
+        return NULL;
+
+    dvbpsi_nit_t *p_nit = dvbpsi_arena_alloc(p_arena, sizeof(dvbpsi_nit_t));
+    assert(p_nit);
+    dvbpsi_nit_init(p_nit, i_table_id, i_extension, i_network_id, i_version,
+                    b_current_next);
+    p_nit->p_arena = p_arena;
+    return p_nit;
+}
+
 static bool dvbpsi_AddSectionNIT(dvbpsi_t *p_dvbpsi, dvbpsi_nit_decoder_t *p_nit_decoder,
                                  dvbpsi_psi_section_t* p_section)
 {
@@ -335,14 +444,26 @@ static bool dvbpsi_AddSectionNIT(dvbpsi_t *p_dvbpsi, dvbpsi_nit_decoder_t *p_nit
     /* Initialize the structures if it's the first section received */
     if (p_nit_decoder->p_building_nit == NULL)
     {
-        p_nit_decoder->p_building_nit = dvbpsi_nit_new(p_section->i_table_id,
-                p_section->i_extension, p_nit_decoder->i_network_id,
+        p_nit_decoder->p_building_nit = dvbpsi_nit_building_new(p_dvbpsi,
+                p_section->i_table_id, p_section->i_extension, p_nit_decoder->i_network_id,
                 p_section->i_version, p_section->b_current_next);
         if (p_nit_decoder->p_building_nit == NULL)
             return false;
         p_nit_decoder->i_last_section_number = p_section->i_last_number;
     }
 
+    /* Decode the section now and only remember its number */
+    if (dvbpsi_decoder_decode_on_arrival(p_dvbpsi, DVBPSI_DECODER(p_nit_decoder)))
+    {
+        if (dvbpsi_decoder_psi_section_mark(DVBPSI_DECODER(p_nit_decoder), p_section))
+            dvbpsi_debug(p_dvbpsi, "NIT decoder", "ignoring already decoded section %d",
+                         p_section->i_number);
+        else
+            dvbpsi_nit_sections_decode(p_nit_decoder->p_building_nit, p_section);
+        dvbpsi_DeletePSISections(p_section);
+        return true;
+    }
+
     /* Add to linked list of sections */
     if (dvbpsi_decoder_psi_section_add(DVBPSI_DECODER(p_nit_decoder), p_section))
         dvbpsi_debug(p_dvbpsi, "NIT decoder", "overwrite section number %d",
@@ -351,6 +472,35 @@ static bool dvbpsi_AddSectionNIT(dvbpsi_t *p_dvbpsi, dvbpsi_nit_decoder_t *p_nit
     return true;
 }
 
+/*****************************************************************************
+ * dvbpsi_nit_delta
+ *****************************************************************************
+ * Give the changes of p_nit to the delta callback.
+ *****************************************************************************/
+static void dvbpsi_nit_delta(dvbpsi_t *p_dvbpsi, dvbpsi_nit_decoder_t *p_nit_decoder,
+                             const dvbpsi_nit_t *p_nit)
+{
+    dvbpsi_delta_descriptors_add(p_nit_decoder->p_delta, p_nit->p_first_descriptor);
+    for (const dvbpsi_nit_ts_t *p_ts = p_nit->p_first_ts; p_ts; p_ts = p_ts->p_next)
+    {
+        uint64_t i_hash = dvbpsi_delta_hash_descriptors(DVBPSI_DELTA_HASH_INIT,
+                                                        p_ts->p_first_descriptor);
+        dvbpsi_delta_element_add(p_nit_decoder->p_delta,
+                                 (uint32_t)p_ts->i_ts_id << 16 | p_ts->i_orig_network_id,
+                                 i_hash, p_ts);
+    }
+
+    const dvbpsi_delta_t *p_deltas;
+    unsigned int i_deltas;
+    if (!dvbpsi_delta_compute(p_nit_decoder->p_delta, &p_deltas, &i_deltas))
+    {
+        dvbpsi_error(p_dvbpsi, "NIT decoder", "failed computing the changes");
+        return;
+    }
+    p_nit_decoder->pf_delta_callback(p_nit_decoder->p_delta_cb_data, p_nit,
+                                     p_deltas, i_deltas);
+}
+
 /*****************************************************************************
  * dvbpsi_nit_sections_gather
  *****************************************************************************
@@ -432,10 +582,18 @@ void dvbpsi_nit_sections_gather(dvbpsi_t *p_dvbpsi,
         /* Save the current information */
         p_nit_decoder->current_nit = *p_nit_decoder->p_building_nit;
         p_nit_decoder->b_current_valid = true;
+        dvbpsi_decoder_current_set(DVBPSI_DECODER(p_nit_decoder),
+                                   p_nit_decoder->p_building_nit->i_table_id,
+                                   p_nit_decoder->p_building_nit->i_extension,
+                                   p_nit_decoder->p_building_nit->i_version,
+                                   p_nit_decoder->p_building_nit->b_current_next);
 
         /* Decode the sections */
         dvbpsi_nit_sections_decode(p_nit_decoder->p_building_nit,
                                    p_nit_decoder->p_sections);
+        /* report its changes */
+        if (p_nit_decoder->pf_delta_callback)
+            dvbpsi_nit_delta(p_dvbpsi, p_nit_decoder, p_nit_decoder->p_building_nit);
         /* signal the new NIT */
         p_nit_decoder->pf_nit_callback(p_nit_decoder->p_cb_data,
                                        p_nit_decoder->p_building_nit);
@@ -453,10 +611,14 @@ void dvbpsi_nit_sections_gather(dvbpsi_t *p_dvbpsi,
 void dvbpsi_nit_sections_decode(dvbpsi_nit_t* p_nit,
                                 dvbpsi_psi_section_t* p_section)
 {
+    dvbpsi_descriptor_t* p_last_descriptor = NULL;
+    dvbpsi_nit_ts_t* p_last_ts = NULL;
     uint8_t* p_byte, * p_end;
 
     while (p_section)
     {
+        dvbpsi_arena_section_keep(p_nit->p_arena, p_section);
+
         /* - NIT descriptors */
         p_byte = p_section->p_payload_start + 2;
         p_end = p_byte + (((uint16_t)(p_section->p_payload_start[0] & 0x0f) << 8)
@@ -467,7 +629,9 @@ void dvbpsi_nit_sections_decode(dvbpsi_nit_t* p_nit,
             uint8_t i_tag = p_byte[0];
             uint8_t i_length = p_byte[1];
             if (i_length + 2 <= p_end - p_byte)
-                dvbpsi_nit_descriptor_add(p_nit, i_tag, i_length, p_byte + 2);
+                dvbpsi_arena_descriptor_add(p_nit->p_arena, &p_nit->p_first_descriptor,
+                                            &p_last_descriptor,
+                                            i_tag, i_length, p_byte + 2);
             p_byte += 2 + i_length;
         }
 
@@ -487,11 +651,13 @@ void dvbpsi_nit_sections_decode(dvbpsi_nit_t* p_nit,
             uint16_t i_orig_network_id = ((uint16_t)p_byte[2] << 8) | p_byte[3];
             uint16_t i_ts_length = ((uint16_t)(p_byte[4] & 0x0f) << 8) | p_byte[5];
 
-            dvbpsi_nit_ts_t* p_ts = dvbpsi_nit_ts_add(p_nit, i_ts_id, i_orig_network_id);
+            dvbpsi_nit_ts_t* p_ts = dvbpsi_nit_ts_append(p_nit, &p_last_ts,
+                                                         i_ts_id, i_orig_network_id);
             if (!p_ts)
                 break;
 
             /* - TS descriptors */
+            dvbpsi_descriptor_t* p_last_ts_descriptor = NULL;
             p_byte += 6;
             p_end2 = p_byte + i_ts_length;
             if (p_end2 > p_section->p_payload_end)
@@ -502,7 +668,9 @@ void dvbpsi_nit_sections_decode(dvbpsi_nit_t* p_nit,
                 uint8_t i_tag = p_byte[0];
                 uint8_t i_length = p_byte[1];
                 if (i_length + 2 <= p_end2 - p_byte)
-                    dvbpsi_nit_ts_descriptor_add(p_ts, i_tag, i_length, p_byte + 2);
+                    dvbpsi_arena_descriptor_add(p_nit->p_arena, &p_ts->p_first_descriptor,
+                                                &p_last_ts_descriptor,
+                                                i_tag, i_length, p_byte + 2);
                 p_byte += 2 + i_length;
             }
         }
@@ -93,6 +93,10 @@ typedef struct dvbpsi_nit_s
 
     dvbpsi_nit_ts_t *    p_first_ts;         /*!< TS list */
 
+    struct dvbpsi_arena_s *p_arena;          /*!< private: memory of the
+                                                  table when decoded with
+                                                  dvbpsi_s::b_arena_tables */
+
 } dvbpsi_nit_t;
 
 /*****************************************************************************
@@ -105,6 +109,24 @@ typedef struct dvbpsi_nit_s
  */
 typedef void (* dvbpsi_nit_callback)(void* p_cb_data, dvbpsi_nit_t* p_new_nit);
 
+struct dvbpsi_delta_s;
+
+/*****************************************************************************
+ * dvbpsi_nit_delta_callback
+ *****************************************************************************/
+/*!
+ * \typedef void (* dvbpsi_nit_delta_callback)(void* p_cb_data,
+                                               const dvbpsi_nit_t* p_new_nit,
+                                               const struct dvbpsi_delta_s *p_deltas,
+                                               unsigned int i_deltas)
+ * \brief Delta callback type definition, the changes are described in
+ * delta.h. p_new_nit and p_deltas are only valid during the call, p_new_nit
+ * is then given to the dvbpsi_nit_callback.
+ */
+typedef void (* dvbpsi_nit_delta_callback)(void* p_cb_data, const dvbpsi_nit_t* p_new_nit,
+                                           const struct dvbpsi_delta_s *p_deltas,
+                                           unsigned int i_deltas);
+
 /*****************************************************************************
  * dvbpsi_nit_attach
  *****************************************************************************/
@@ -137,6 +159,33 @@ bool dvbpsi_nit_attach(dvbpsi_t* p_dvbpsi, uint8_t i_table_id, uint16_t i_extens
 void dvbpsi_nit_detach(dvbpsi_t* p_dvbpsi, uint8_t i_table_id,
                       uint16_t i_extension);
 
+/*****************************************************************************
+ * dvbpsi_nit_set_delta_callback
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_nit_set_delta_callback(dvbpsi_t *p_dvbpsi, uint8_t i_table_id,
+                                          uint16_t i_extension,
+                                          dvbpsi_nit_delta_callback pf_callback,
+                                          void* p_cb_data)
+ * \brief Report the changes of each new NIT of a NIT decoder.
+ * \param p_dvbpsi pointer holding decoder/demuxer structure
+ * \param i_table_id Table ID, 0x40 (actual) or 0x41 (other).
+ * \param i_extension Table ID extension, here network ID.
+ * \param pf_callback function to call with the changes of each new NIT
+ * before the dvbpsi_nit_callback, NULL to stop reporting them.
+ * \param p_cb_data private data given in argument to the callback.
+ * \return true on success, false on failure or if there is no such decoder.
+ *
+ * The transport streams are compared by transport_stream_id and
+ * original_network_id and the network descriptors by tag, with the previous
+ * NIT given to the delta callback. All of them are reported as added for the
+ * first one.
+ */
+bool dvbpsi_nit_set_delta_callback(dvbpsi_t *p_dvbpsi, uint8_t i_table_id,
+                                   uint16_t i_extension,
+                                   dvbpsi_nit_delta_callback pf_callback,
+                                   void* p_cb_data);
+
 /*****************************************************************************
  * dvbpsi_nit_init/dvbpsi_nit_new
  *****************************************************************************/
@@ -243,6 +292,23 @@ dvbpsi_descriptor_t* dvbpsi_nit_ts_descriptor_add(dvbpsi_nit_ts_t* p_ts,
                                                   uint8_t i_tag, uint8_t i_length,
                                                   uint8_t* p_data);
 
+/*****************************************************************************
+ * dvbpsi_nit_decode_descriptors
+ *****************************************************************************/
+/*!
+ * \fn unsigned int dvbpsi_nit_decode_descriptors(dvbpsi_nit_t *p_nit,
+                                                  const uint8_t *p_tags, unsigned int i_tags)
+ * \brief Decode the descriptors of the NIT and of its transport streams with the
+ * decoders registered for their tags, see dvbpsi_DecodeAllDescriptors().
+ * \param p_nit pointer to the NIT structure
+ * \param p_tags tags of the descriptors to decode, NULL to decode all of
+ * them
+ * \param i_tags number of tags in p_tags
+ * \return the number of decoded descriptors.
+ */
+unsigned int dvbpsi_nit_decode_descriptors(dvbpsi_nit_t *p_nit,
+                                           const uint8_t *p_tags, unsigned int i_tags);
+
 /*****************************************************************************
  * dvbpsi_nit_sections_generate
  *****************************************************************************/
@@ -42,6 +42,10 @@ typedef struct dvbpsi_nit_decoder_s
     dvbpsi_nit_callback           pf_nit_callback;
     void *                        p_cb_data;
 
+    dvbpsi_nit_delta_callback     pf_delta_callback;
+    void *                        p_delta_cb_data;
+    struct dvbpsi_delta_state_s * p_delta;       /* previous table */
+
     dvbpsi_nit_t                  current_nit;
     dvbpsi_nit_t *                p_building_nit;
 
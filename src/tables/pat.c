@@ -152,12 +152,14 @@ void dvbpsi_pat_delete(dvbpsi_pat_t *p_pat)
 }
 
 /*****************************************************************************
- * dvbpsi_pat_program_add
+ * dvbpsi_pat_program_append
  *****************************************************************************
- * Add a program at the end of the PAT.
+ * Add a program at the end of the PAT. The end is searched from *pp_last,
+ * the last program added by the caller or NULL, which is updated.
  *****************************************************************************/
-dvbpsi_pat_program_t* dvbpsi_pat_program_add(dvbpsi_pat_t* p_pat,
-                                             uint16_t i_number, uint16_t i_pid)
+static dvbpsi_pat_program_t *dvbpsi_pat_program_append(dvbpsi_pat_t *p_pat,
+                                                       dvbpsi_pat_program_t **pp_last,
+                                                       uint16_t i_number, uint16_t i_pid)
 {
     dvbpsi_pat_program_t* p_program;
 
@@ -178,15 +180,29 @@ dvbpsi_pat_program_t* dvbpsi_pat_program_add(dvbpsi_pat_t* p_pat,
         p_pat->p_first_program = p_program;
     else
     {
-        dvbpsi_pat_program_t* p_last_program = p_pat->p_first_program;
+        dvbpsi_pat_program_t* p_last_program = *pp_last ? *pp_last
+                                                        : p_pat->p_first_program;
         while (p_last_program->p_next != NULL)
             p_last_program = p_last_program->p_next;
         p_last_program->p_next = p_program;
     }
+    *pp_last = p_program;
 
     return p_program;
 }
 
+/*****************************************************************************
+ * dvbpsi_pat_program_add
+ *****************************************************************************
+ * Add a program at the end of the PAT.
+ *****************************************************************************/
+dvbpsi_pat_program_t* dvbpsi_pat_program_add(dvbpsi_pat_t* p_pat,
+                                             uint16_t i_number, uint16_t i_pid)
+{
+    dvbpsi_pat_program_t* p_last_program = NULL;
+    return dvbpsi_pat_program_append(p_pat, &p_last_program, i_number, i_pid);
+}
+
 /* */
 static void dvbpsi_ReInitPAT(dvbpsi_pat_decoder_t* p_decoder, const bool b_force)
 {
@@ -358,6 +374,7 @@ void dvbpsi_pat_sections_gather(dvbpsi_t* p_dvbpsi, dvbpsi_psi_section_t* p_sect
  *****************************************************************************/
 bool dvbpsi_pat_sections_decode(dvbpsi_pat_t* p_pat, dvbpsi_psi_section_t* p_section)
 {
+    dvbpsi_pat_program_t* p_last_program = NULL;
     bool b_valid = false;
     while (p_section)
     {
@@ -367,7 +384,8 @@ bool dvbpsi_pat_sections_decode(dvbpsi_pat_t* p_pat, dvbpsi_psi_section_t* p_sec
         {
             uint16_t i_program_number = ((uint16_t)(p_byte[0]) << 8) | p_byte[1];
             uint16_t i_pid = ((uint16_t)(p_byte[2] & 0x1f) << 8) | p_byte[3];
-            dvbpsi_pat_program_t* p_program = dvbpsi_pat_program_add(p_pat, i_program_number, i_pid);
+            dvbpsi_pat_program_t* p_program = dvbpsi_pat_program_append(p_pat, &p_last_program,
+                                                                        i_program_number, i_pid);
             if (p_program)
                 b_valid = true;
         }
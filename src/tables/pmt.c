@@ -44,6 +44,7 @@
 #include "../dvbpsi_private.h"
 #include "../psi.h"
 #include "../descriptor.h"
+#include "../delta.h"
 #include "pmt.h"
 #include "pmt_private.h"
 
@@ -90,11 +91,42 @@ void dvbpsi_pmt_detach(dvbpsi_t *p_dvbpsi)
     if (p_pmt_decoder->p_building_pmt)
         dvbpsi_pmt_delete(p_pmt_decoder->p_building_pmt);
     p_pmt_decoder->p_building_pmt = NULL;
+    dvbpsi_delta_state_delete(p_pmt_decoder->p_delta);
 
     dvbpsi_decoder_delete(p_dvbpsi->p_decoder);
     p_dvbpsi->p_decoder = NULL;
 }
 
+/*****************************************************************************
+ * dvbpsi_pmt_set_delta_callback
+ *****************************************************************************
+ * Report the changes of the next PMTs.
+ *****************************************************************************/
+bool dvbpsi_pmt_set_delta_callback(dvbpsi_t *p_dvbpsi,
+                                   dvbpsi_pmt_delta_callback pf_callback,
+                                   void* p_cb_data)
+{
+    assert(p_dvbpsi);
+    assert(p_dvbpsi->p_decoder);
+
+    dvbpsi_pmt_decoder_t *p_pmt_decoder = (dvbpsi_pmt_decoder_t *)p_dvbpsi->p_decoder;
+
+    if (pf_callback == NULL)
+    {
+        dvbpsi_delta_state_delete(p_pmt_decoder->p_delta);
+        p_pmt_decoder->p_delta = NULL;
+    }
+    else if (p_pmt_decoder->p_delta == NULL)
+    {
+        p_pmt_decoder->p_delta = dvbpsi_delta_state_new();
+        if (p_pmt_decoder->p_delta == NULL)
+            return false;
+    }
+    p_pmt_decoder->pf_delta_callback = pf_callback;
+    p_pmt_decoder->p_delta_cb_data = p_cb_data;
+    return true;
+}
+
 /*****************************************************************************
  * dvbpsi_pmt_init
  *****************************************************************************
@@ -111,6 +143,7 @@ void dvbpsi_pmt_init(dvbpsi_pmt_t* p_pmt, uint16_t i_program_number,
     p_pmt->i_pcr_pid = i_pcr_pid;
     p_pmt->p_first_descriptor = NULL;
     p_pmt->p_first_es = NULL;
+    p_pmt->p_arena = NULL;
 }
 
 /*****************************************************************************
@@ -137,13 +170,13 @@ void dvbpsi_pmt_empty(dvbpsi_pmt_t* p_pmt)
 {
     dvbpsi_pmt_es_t* p_es = p_pmt->p_first_es;
 
-    dvbpsi_DeleteDescriptors(p_pmt->p_first_descriptor);
+    dvbpsi_arena_descriptors_delete(p_pmt->p_arena, p_pmt->p_first_descriptor);
 
     while(p_es != NULL)
     {
         dvbpsi_pmt_es_t* p_tmp = p_es->p_next;
-        dvbpsi_DeleteDescriptors(p_es->p_first_descriptor);
-        free(p_es);
+        dvbpsi_arena_descriptors_delete(p_pmt->p_arena, p_es->p_first_descriptor);
+        dvbpsi_arena_free(p_pmt->p_arena, p_es);
         p_es = p_tmp;
     }
 
@@ -158,9 +191,14 @@ void dvbpsi_pmt_empty(dvbpsi_pmt_t* p_pmt)
  *****************************************************************************/
 void dvbpsi_pmt_delete(dvbpsi_pmt_t* p_pmt)
 {
-    if (p_pmt)
-        dvbpsi_pmt_empty(p_pmt);
-    free(p_pmt);
+    if (p_pmt == NULL)
+        return;
+
+    dvbpsi_pmt_empty(p_pmt);
+    if (p_pmt->p_arena)
+        dvbpsi_arena_delete(p_pmt->p_arena);
+    else
+        free(p_pmt);
 }
 
 /*****************************************************************************
@@ -173,7 +211,7 @@ dvbpsi_descriptor_t* dvbpsi_pmt_descriptor_add(dvbpsi_pmt_t* p_pmt,
                                                uint8_t* p_data)
 {
     dvbpsi_descriptor_t* p_descriptor;
-    p_descriptor = dvbpsi_NewDescriptor(i_tag, i_length, p_data);
+    p_descriptor = dvbpsi_arena_descriptor_new(p_pmt->p_arena, i_tag, i_length, p_data);
     if (p_descriptor == NULL)
         return NULL;
 
@@ -187,14 +225,16 @@ dvbpsi_descriptor_t* dvbpsi_pmt_descriptor_add(dvbpsi_pmt_t* p_pmt,
 }
 
 /*****************************************************************************
- * dvbpsi_pmt_es_add
+ * dvbpsi_pmt_es_append
  *****************************************************************************
- * Add an ES in the PMT.
+ * Add an ES in the PMT. The end is searched from *pp_last, the last ES added
+ * by the caller or NULL, which is updated.
  *****************************************************************************/
-dvbpsi_pmt_es_t* dvbpsi_pmt_es_add(dvbpsi_pmt_t* p_pmt,
-                                   uint8_t i_type, uint16_t i_pid)
+static dvbpsi_pmt_es_t* dvbpsi_pmt_es_append(dvbpsi_pmt_t* p_pmt, dvbpsi_pmt_es_t** pp_last,
+                                             uint8_t i_type, uint16_t i_pid)
 {
-    dvbpsi_pmt_es_t* p_es = (dvbpsi_pmt_es_t*)malloc(sizeof(dvbpsi_pmt_es_t));
+    dvbpsi_pmt_es_t* p_es = (dvbpsi_pmt_es_t*)dvbpsi_arena_alloc(p_pmt->p_arena,
+                                                                 sizeof(dvbpsi_pmt_es_t));
     if (p_es == NULL)
         return NULL;
 
@@ -207,14 +247,27 @@ dvbpsi_pmt_es_t* dvbpsi_pmt_es_add(dvbpsi_pmt_t* p_pmt,
        p_pmt->p_first_es = p_es;
     else
     {
-        dvbpsi_pmt_es_t* p_last_es = p_pmt->p_first_es;
+        dvbpsi_pmt_es_t* p_last_es = *pp_last ? *pp_last : p_pmt->p_first_es;
         while (p_last_es->p_next != NULL)
             p_last_es = p_last_es->p_next;
         p_last_es->p_next = p_es;
     }
+    *pp_last = p_es;
     return p_es;
 }
 
+/*****************************************************************************
+ * dvbpsi_pmt_es_add
+ *****************************************************************************
+ * Add an ES in the PMT.
+ *****************************************************************************/
+dvbpsi_pmt_es_t* dvbpsi_pmt_es_add(dvbpsi_pmt_t* p_pmt,
+                                   uint8_t i_type, uint16_t i_pid)
+{
+    dvbpsi_pmt_es_t* p_last_es = NULL;
+    return dvbpsi_pmt_es_append(p_pmt, &p_last_es, i_type, i_pid);
+}
+
 /*****************************************************************************
  * dvbpsi_pmt_es_descriptor_add
  *****************************************************************************
@@ -241,6 +294,27 @@ dvbpsi_descriptor_t* dvbpsi_pmt_es_descriptor_add(dvbpsi_pmt_es_t* p_es,
     return p_descriptor;
 }
 
+/*****************************************************************************
+ * dvbpsi_pmt_decode_descriptors
+ *****************************************************************************
+ * Decode the descriptors of the PMT and of its ES, each loop starting without
+ * private_data_specifier.
+ *****************************************************************************/
+unsigned int dvbpsi_pmt_decode_descriptors(dvbpsi_pmt_t *p_pmt,
+                                           const uint8_t *p_tags, unsigned int i_tags)
+{
+    uint8_t p_selected[256];
+    unsigned int i_decoded = 0;
+
+    assert(p_pmt);
+
+    dvbpsi_descriptors_select(p_selected, p_tags, i_tags);
+    i_decoded += dvbpsi_descriptors_decode(p_pmt->p_first_descriptor, 0, p_selected);
+    for (dvbpsi_pmt_es_t *p_es = p_pmt->p_first_es; p_es; p_es = p_es->p_next)
+        i_decoded += dvbpsi_descriptors_decode(p_es->p_first_descriptor, 0, p_selected);
+    return i_decoded;
+}
+
 /* */
 static void dvbpsi_ReInitPMT(dvbpsi_pmt_decoder_t* p_decoder, const bool b_force)
 {
@@ -286,6 +360,29 @@ static bool dvbpsi_CheckPMT(dvbpsi_t *p_dvbpsi, dvbpsi_psi_section_t *p_section)
     return b_reinit;
 }
 
+/*****************************************************************************
+ * dvbpsi_pmt_building_new
+ *****************************************************************************
+ * dvbpsi_pmt_new() in an arena of its own with dvbpsi_t::b_arena_tables.
+ *****************************************************************************/
+static dvbpsi_pmt_t *dvbpsi_pmt_building_new(dvbpsi_t *p_dvbpsi, uint16_t i_program_number,
+                                             uint8_t i_version, bool b_current_next,
+                                             uint16_t i_pcr_pid)
+{
+    if (!p_dvbpsi->b_arena_tables)
+        return dvbpsi_pmt_new(i_program_number, i_version, b_current_next, i_pcr_pid);
+
+    dvbpsi_arena_t *p_arena = dvbpsi_arena_new(p_dvbpsi->b_zero_copy_descriptors);
+    if (p_arena == NULL)
+        return NULL;
+
+    dvbpsi_pmt_t *p_pmt = dvbpsi_arena_alloc(p_arena, sizeof(dvbpsi_pmt_t));
+    assert(p_pmt);
+    dvbpsi_pmt_init(p_pmt, i_program_number, i_version, b_current_next, i_pcr_pid);
+    p_pmt->p_arena = p_arena;
+    return p_pmt;
+}
+
 static bool dvbpsi_AddSectionPMT(dvbpsi_t *p_dvbpsi, dvbpsi_pmt_decoder_t *p_pmt_decoder,
                                  dvbpsi_psi_section_t* p_section)
 {
@@ -296,7 +393,8 @@ static bool dvbpsi_AddSectionPMT(dvbpsi_t *p_dvbpsi, dvbpsi_pmt_decoder_t *p_pmt
     /* Initialize the structures if it's the first section received */
     if (p_pmt_decoder->p_building_pmt == NULL)
     {
-        p_pmt_decoder->p_building_pmt = dvbpsi_pmt_new(p_pmt_decoder->i_program_number,
+        p_pmt_decoder->p_building_pmt = dvbpsi_pmt_building_new(p_dvbpsi,
+                              p_pmt_decoder->i_program_number,
                               p_section->i_version, p_section->b_current_next,
                               ((uint16_t)(p_section->p_payload_start[0] & 0x1f) << 8)
                                           | p_section->p_payload_start[1]);
@@ -314,6 +412,36 @@ static bool dvbpsi_AddSectionPMT(dvbpsi_t *p_dvbpsi, dvbpsi_pmt_decoder_t *p_pmt
     return true;
 }
 
+/*****************************************************************************
+ * dvbpsi_pmt_delta
+ *****************************************************************************
+ * Give the changes of p_pmt to the delta callback.
+ *****************************************************************************/
+static void dvbpsi_pmt_delta(dvbpsi_t *p_dvbpsi, dvbpsi_pmt_decoder_t *p_pmt_decoder,
+                             const dvbpsi_pmt_t *p_pmt)
+{
+    const uint8_t p_pcr_pid[2] = { p_pmt->i_pcr_pid >> 8, p_pmt->i_pcr_pid & 0xff };
+    dvbpsi_delta_table_add(p_pmt_decoder->p_delta,
+                           dvbpsi_delta_hash(DVBPSI_DELTA_HASH_INIT, p_pcr_pid, 2), p_pmt);
+    dvbpsi_delta_descriptors_add(p_pmt_decoder->p_delta, p_pmt->p_first_descriptor);
+    for (const dvbpsi_pmt_es_t *p_es = p_pmt->p_first_es; p_es; p_es = p_es->p_next)
+    {
+        uint64_t i_hash = dvbpsi_delta_hash(DVBPSI_DELTA_HASH_INIT, &p_es->i_type, 1);
+        i_hash = dvbpsi_delta_hash_descriptors(i_hash, p_es->p_first_descriptor);
+        dvbpsi_delta_element_add(p_pmt_decoder->p_delta, p_es->i_pid, i_hash, p_es);
+    }
+
+    const dvbpsi_delta_t *p_deltas;
+    unsigned int i_deltas;
+    if (!dvbpsi_delta_compute(p_pmt_decoder->p_delta, &p_deltas, &i_deltas))
+    {
+        dvbpsi_error(p_dvbpsi, "PMT decoder", "failed computing the changes");
+        return;
+    }
+    p_pmt_decoder->pf_delta_callback(p_pmt_decoder->p_delta_cb_data, p_pmt,
+                                     p_deltas, i_deltas);
+}
+
 /*****************************************************************************
  * dvbpsi_GatherPMTSections
  *****************************************************************************
@@ -394,6 +522,9 @@ void dvbpsi_pmt_sections_gather(dvbpsi_t *p_dvbpsi, dvbpsi_psi_section_t* p_sect
         /* Decode the sections */
         dvbpsi_pmt_sections_decode(p_pmt_decoder->p_building_pmt,
                                    p_pmt_decoder->p_sections);
+        /* report its changes */
+        if (p_pmt_decoder->pf_delta_callback)
+            dvbpsi_pmt_delta(p_dvbpsi, p_pmt_decoder, p_pmt_decoder->p_building_pmt);
         /* signal the new PMT */
         p_pmt_decoder->pf_pmt_callback(p_pmt_decoder->p_cb_data,
                                        p_pmt_decoder->p_building_pmt);
@@ -411,10 +542,14 @@ void dvbpsi_pmt_sections_gather(dvbpsi_t *p_dvbpsi, dvbpsi_psi_section_t* p_sect
 void dvbpsi_pmt_sections_decode(dvbpsi_pmt_t* p_pmt,
                                 dvbpsi_psi_section_t* p_section)
 {
+    dvbpsi_descriptor_t* p_last_descriptor = NULL;
+    dvbpsi_pmt_es_t* p_last_es = NULL;
     uint8_t* p_byte, * p_end;
 
     while (p_section)
     {
+        dvbpsi_arena_section_keep(p_pmt->p_arena, p_section);
+
         /* - PMT descriptors */
         p_byte = p_section->p_payload_start + 4;
         p_end = p_byte + (   ((uint16_t)(p_section->p_payload_start[2] & 0x0f) << 8)
@@ -424,7 +559,9 @@ void dvbpsi_pmt_sections_decode(dvbpsi_pmt_t* p_pmt,
             uint8_t i_tag = p_byte[0];
             uint8_t i_length = p_byte[1];
             if (i_length + 2 <= p_end - p_byte)
-                dvbpsi_pmt_descriptor_add(p_pmt, i_tag, i_length, p_byte + 2);
+                dvbpsi_arena_descriptor_add(p_pmt->p_arena, &p_pmt->p_first_descriptor,
+                                            &p_last_descriptor,
+                                            i_tag, i_length, p_byte + 2);
             p_byte += 2 + i_length;
         }
 
@@ -434,7 +571,8 @@ void dvbpsi_pmt_sections_decode(dvbpsi_pmt_t* p_pmt,
             uint8_t i_type = p_byte[0];
             uint16_t i_pid = ((uint16_t)(p_byte[1] & 0x1f) << 8) | p_byte[2];
             uint16_t i_es_length = ((uint16_t)(p_byte[3] & 0x0f) << 8) | p_byte[4];
-            dvbpsi_pmt_es_t* p_es = dvbpsi_pmt_es_add(p_pmt, i_type, i_pid);
+            dvbpsi_pmt_es_t* p_es = dvbpsi_pmt_es_append(p_pmt, &p_last_es, i_type, i_pid);
+            dvbpsi_descriptor_t* p_last_es_descriptor = NULL;
             /* - ES descriptors */
             p_byte += 5;
             p_end = p_byte + i_es_length;
@@ -447,7 +585,9 @@ void dvbpsi_pmt_sections_decode(dvbpsi_pmt_t* p_pmt,
                 uint8_t i_tag = p_byte[0];
                 uint8_t i_length = p_byte[1];
                 if (i_length + 2 <= p_end - p_byte)
-                    dvbpsi_pmt_es_descriptor_add(p_es, i_tag, i_length, p_byte + 2);
+                    dvbpsi_arena_descriptor_add(p_pmt->p_arena, &p_es->p_first_descriptor,
+                                                &p_last_es_descriptor,
+                                                i_tag, i_length, p_byte + 2);
                 p_byte += 2 + i_length;
             }
         }
@@ -90,6 +90,10 @@ typedef struct dvbpsi_pmt_s
 
   dvbpsi_pmt_es_t *         p_first_es;         /*!< ES list */
 
+  struct dvbpsi_arena_s *   p_arena;            /*!< private: memory of the
+                                                     table when decoded with
+                                                     dvbpsi_s::b_arena_tables */
+
 } dvbpsi_pmt_t;
 
 /*****************************************************************************
@@ -102,6 +106,24 @@ typedef struct dvbpsi_pmt_s
  */
 typedef void (* dvbpsi_pmt_callback)(void* p_cb_data, dvbpsi_pmt_t* p_new_pmt);
 
+struct dvbpsi_delta_s;
+
+/*****************************************************************************
+ * dvbpsi_pmt_delta_callback
+ *****************************************************************************/
+/*!
+ * \typedef void (* dvbpsi_pmt_delta_callback)(void* p_cb_data,
+                                               const dvbpsi_pmt_t* p_new_pmt,
+                                               const struct dvbpsi_delta_s *p_deltas,
+                                               unsigned int i_deltas)
+ * \brief Delta callback type definition, the changes are described in
+ * delta.h. p_new_pmt and p_deltas are only valid during the call, p_new_pmt
+ * is then given to the dvbpsi_pmt_callback.
+ */
+typedef void (* dvbpsi_pmt_delta_callback)(void* p_cb_data, const dvbpsi_pmt_t* p_new_pmt,
+                                           const struct dvbpsi_delta_s *p_deltas,
+                                           unsigned int i_deltas);
+
 /*****************************************************************************
  * dvbpsi_pmt_attach
  *****************************************************************************/
@@ -134,6 +156,29 @@ bool dvbpsi_pmt_attach(dvbpsi_t *p_dvbpsi, uint16_t i_program_number,
  */
 void dvbpsi_pmt_detach(dvbpsi_t *p_dvbpsi);
 
+/*****************************************************************************
+ * dvbpsi_pmt_set_delta_callback
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_pmt_set_delta_callback(dvbpsi_t *p_dvbpsi,
+                                          dvbpsi_pmt_delta_callback pf_callback,
+                                          void* p_cb_data)
+ * \brief Report the changes of each new PMT of a PMT decoder.
+ * \param p_dvbpsi handle
+ * \param pf_callback function to call with the changes of each new PMT
+ * before the dvbpsi_pmt_callback, NULL to stop reporting them.
+ * \param p_cb_data private data given in argument to the callback.
+ * \return true on success, false on failure.
+ *
+ * The elementary streams are compared by elementary_PID, the program_info
+ * descriptors by tag and the PCR_PID as a table change, with the previous PMT
+ * given to the delta callback. All of them are reported as added for the
+ * first one.
+ */
+bool dvbpsi_pmt_set_delta_callback(dvbpsi_t *p_dvbpsi,
+                                   dvbpsi_pmt_delta_callback pf_callback,
+                                   void* p_cb_data);
+
 /*****************************************************************************
  * dvbpsi_pmt_init/dvbpsi_pmt_new
  *****************************************************************************/
@@ -238,6 +283,23 @@ dvbpsi_descriptor_t* dvbpsi_pmt_es_descriptor_add(dvbpsi_pmt_es_t* p_es,
                                                uint8_t i_tag, uint8_t i_length,
                                                uint8_t* p_data);
 
+/*****************************************************************************
+ * dvbpsi_pmt_decode_descriptors
+ *****************************************************************************/
+/*!
+ * \fn unsigned int dvbpsi_pmt_decode_descriptors(dvbpsi_pmt_t *p_pmt,
+                                                  const uint8_t *p_tags, unsigned int i_tags)
+ * \brief Decode the descriptors of the PMT and of its ES with the
+ * decoders registered for their tags, see dvbpsi_DecodeAllDescriptors().
+ * \param p_pmt pointer to the PMT structure
+ * \param p_tags tags of the descriptors to decode, NULL to decode all of
+ * them
+ * \param i_tags number of tags in p_tags
+ * \return the number of decoded descriptors.
+ */
+unsigned int dvbpsi_pmt_decode_descriptors(dvbpsi_pmt_t *p_pmt,
+                                           const uint8_t *p_tags, unsigned int i_tags);
+
 /*****************************************************************************
  * dvbpsi_pmt_sections_generate
  *****************************************************************************/
@@ -40,6 +40,10 @@ typedef struct dvbpsi_pmt_decoder_s
     dvbpsi_pmt_callback           pf_pmt_callback;
     void *                        p_cb_data;
 
+    dvbpsi_pmt_delta_callback     pf_delta_callback;
+    void *                        p_delta_cb_data;
+    struct dvbpsi_delta_state_s * p_delta;       /* previous table */
+
     dvbpsi_pmt_t                  current_pmt;
     dvbpsi_pmt_t *                p_building_pmt;
 
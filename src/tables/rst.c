@@ -153,12 +153,13 @@ void dvbpsi_rst_delete(dvbpsi_rst_t *p_rst)
 }
 
 /*****************************************************************************
- * dvbpsi_rst_event_add
+ * dvbpsi_rst_event_append
  *****************************************************************************
- * Add an event in the RST.
+ * Add an event in the RST. The end is searched from *pp_last, the last event
+ * added by the caller or NULL, which is updated.
  *****************************************************************************/
-
-dvbpsi_rst_event_t* dvbpsi_rst_event_add(dvbpsi_rst_t* p_rst,
+static dvbpsi_rst_event_t* dvbpsi_rst_event_append(dvbpsi_rst_t* p_rst,
+                                            dvbpsi_rst_event_t** pp_last,
                                             uint16_t i_ts_id,
                                             uint16_t i_orig_network_id,
                                             uint16_t i_service_id,
@@ -182,15 +183,34 @@ dvbpsi_rst_event_t* dvbpsi_rst_event_add(dvbpsi_rst_t* p_rst,
     	p_rst->p_first_event = p_rst_event;
     else
     {
-    	dvbpsi_rst_event_t *p_last = p_rst->p_first_event;
+    	dvbpsi_rst_event_t *p_last = *pp_last ? *pp_last : p_rst->p_first_event;
     	while (p_last->p_next != NULL)
     		p_last = p_last->p_next;
     	p_last->p_next = p_rst_event;
     }
+    *pp_last = p_rst_event;
 
     return p_rst_event;
 }
 
+/*****************************************************************************
+ * dvbpsi_rst_event_add
+ *****************************************************************************
+ * Add an event in the RST.
+ *****************************************************************************/
+
+dvbpsi_rst_event_t* dvbpsi_rst_event_add(dvbpsi_rst_t* p_rst,
+                                            uint16_t i_ts_id,
+                                            uint16_t i_orig_network_id,
+                                            uint16_t i_service_id,
+                                            uint16_t i_event_id,
+                                            uint8_t i_running_status)
+{
+    dvbpsi_rst_event_t *p_last = NULL;
+    return dvbpsi_rst_event_append(p_rst, &p_last, i_ts_id, i_orig_network_id,
+                                   i_service_id, i_event_id, i_running_status);
+}
+
 /*****************************************************************************
  * dvbpsi_rst_sections_generate
  *****************************************************************************
@@ -403,6 +423,7 @@ void dvbpsi_rst_sections_gather(dvbpsi_t *p_dvbpsi,
 void dvbpsi_rst_sections_decode(dvbpsi_rst_t* p_rst,
                               dvbpsi_psi_section_t* p_section)
 {
+    dvbpsi_rst_event_t *p_last = NULL;
     uint8_t* p_byte;
 
     while (p_section)
@@ -417,7 +438,7 @@ void dvbpsi_rst_sections_decode(dvbpsi_rst_t* p_rst,
             uint16_t i_event_id = (p_byte[6] << 8) + p_byte[7];
             uint8_t i_running_status = (p_byte[8] & 0x07);
 
-            dvbpsi_rst_event_add(p_rst, i_transport_stream_id, i_original_network_id, i_service_id, i_event_id, i_running_status);
+            dvbpsi_rst_event_append(p_rst, &p_last, i_transport_stream_id, i_original_network_id, i_service_id, i_event_id, i_running_status);
             p_byte += 9;
         }
         p_section = p_section->p_next;
@@ -44,6 +44,7 @@
 #include "../dvbpsi_private.h"
 #include "../psi.h"
 #include "../descriptor.h"
+#include "../delta.h"
 #include "../demux.h"
 #include "sdt.h"
 #include "sdt_private.h"
@@ -127,12 +128,53 @@ void dvbpsi_sdt_detach(dvbpsi_t *p_dvbpsi, uint8_t i_table_id, uint16_t i_extens
     if (p_sdt_decoder->p_building_sdt)
         dvbpsi_sdt_delete(p_sdt_decoder->p_building_sdt);
     p_sdt_decoder->p_building_sdt = NULL;
+    dvbpsi_delta_state_delete(p_sdt_decoder->p_delta);
 
     /* Free sub table decoder */
     dvbpsi_DetachDemuxSubDecoder(p_demux, p_subdec);
     dvbpsi_DeleteDemuxSubDecoder(p_subdec);
 }
 
+/*****************************************************************************
+ * dvbpsi_sdt_set_delta_callback
+ *****************************************************************************
+ * Report the changes of the next SDTs.
+ *****************************************************************************/
+bool dvbpsi_sdt_set_delta_callback(dvbpsi_t *p_dvbpsi, uint8_t i_table_id,
+                                   uint16_t i_extension,
+                                   dvbpsi_sdt_delta_callback pf_callback,
+                                   void* p_cb_data)
+{
+    assert(p_dvbpsi);
+    assert(p_dvbpsi->p_decoder);
+
+    dvbpsi_sdt_decoder_t *p_sdt_decoder = (dvbpsi_sdt_decoder_t *)
+            dvbpsi_demux_decoder_find(p_dvbpsi->p_decoder, i_table_id, i_extension);
+    if (p_sdt_decoder == NULL)
+    {
+        dvbpsi_error(p_dvbpsi, "SDT decoder",
+                     "No such SDT decoder (table_id == 0x%02x,"
+                     "extension == 0x%02x)",
+                     i_table_id, i_extension);
+        return false;
+    }
+
+    if (pf_callback == NULL)
+    {
+        dvbpsi_delta_state_delete(p_sdt_decoder->p_delta);
+        p_sdt_decoder->p_delta = NULL;
+    }
+    else if (p_sdt_decoder->p_delta == NULL)
+    {
+        p_sdt_decoder->p_delta = dvbpsi_delta_state_new();
+        if (p_sdt_decoder->p_delta == NULL)
+            return false;
+    }
+    p_sdt_decoder->pf_delta_callback = pf_callback;
+    p_sdt_decoder->p_delta_cb_data = p_cb_data;
+    return true;
+}
+
 /*****************************************************************************
  * dvbpsi_sdt_init
  *****************************************************************************
@@ -150,6 +192,7 @@ void dvbpsi_sdt_init(dvbpsi_sdt_t* p_sdt, uint8_t i_table_id, uint16_t i_extensi
     p_sdt->b_current_next = b_current_next;
     p_sdt->i_network_id = i_network_id;
     p_sdt->p_first_service = NULL;
+    p_sdt->p_arena = NULL;
 }
 
 /*****************************************************************************
@@ -179,8 +222,8 @@ void dvbpsi_sdt_empty(dvbpsi_sdt_t* p_sdt)
     while (p_service != NULL)
     {
         dvbpsi_sdt_service_t* p_tmp = p_service->p_next;
-        dvbpsi_DeleteDescriptors(p_service->p_first_descriptor);
-        free(p_service);
+        dvbpsi_arena_descriptors_delete(p_sdt->p_arena, p_service->p_first_descriptor);
+        dvbpsi_arena_free(p_sdt->p_arena, p_service);
         p_service = p_tmp;
     }
     p_sdt->p_first_service = NULL;
@@ -193,17 +236,24 @@ void dvbpsi_sdt_empty(dvbpsi_sdt_t* p_sdt)
  *****************************************************************************/
 void dvbpsi_sdt_delete(dvbpsi_sdt_t *p_sdt)
 {
-    if (p_sdt)
-        dvbpsi_sdt_empty(p_sdt);
-    free(p_sdt);
+    if (p_sdt == NULL)
+        return;
+
+    dvbpsi_sdt_empty(p_sdt);
+    if (p_sdt->p_arena)
+        dvbpsi_arena_delete(p_sdt->p_arena);
+    else
+        free(p_sdt);
 }
 
 /*****************************************************************************
- * dvbpsi_sdt_service_add
+ * dvbpsi_sdt_service_append
  *****************************************************************************
- * Add a service description at the end of the SDT.
+ * Add a service description at the end of the SDT. The end is searched from
+ * *pp_last, the last service added by the caller or NULL, which is updated.
  *****************************************************************************/
-dvbpsi_sdt_service_t *dvbpsi_sdt_service_add(dvbpsi_sdt_t* p_sdt,
+static dvbpsi_sdt_service_t *dvbpsi_sdt_service_append(dvbpsi_sdt_t* p_sdt,
+                                           dvbpsi_sdt_service_t **pp_last,
                                            uint16_t i_service_id,
                                            bool b_eit_schedule,
                                            bool b_eit_present,
@@ -211,7 +261,8 @@ dvbpsi_sdt_service_t *dvbpsi_sdt_service_add(dvbpsi_sdt_t* p_sdt,
                                            bool b_free_ca)
 {
     dvbpsi_sdt_service_t * p_service;
-    p_service = (dvbpsi_sdt_service_t*)calloc(1, sizeof(dvbpsi_sdt_service_t));
+    p_service = (dvbpsi_sdt_service_t*)dvbpsi_arena_alloc(p_sdt->p_arena,
+                                                          sizeof(dvbpsi_sdt_service_t));
     if (p_service == NULL)
         return NULL;
 
@@ -227,15 +278,35 @@ dvbpsi_sdt_service_t *dvbpsi_sdt_service_add(dvbpsi_sdt_t* p_sdt,
         p_sdt->p_first_service = p_service;
     else
     {
-        dvbpsi_sdt_service_t * p_last_service = p_sdt->p_first_service;
+        dvbpsi_sdt_service_t * p_last_service = *pp_last ? *pp_last
+                                                         : p_sdt->p_first_service;
         while(p_last_service->p_next != NULL)
             p_last_service = p_last_service->p_next;
         p_last_service->p_next = p_service;
     }
+    *pp_last = p_service;
 
     return p_service;
 }
 
+/*****************************************************************************
+ * dvbpsi_sdt_service_add
+ *****************************************************************************
+ * Add a service description at the end of the SDT.
+ *****************************************************************************/
+dvbpsi_sdt_service_t *dvbpsi_sdt_service_add(dvbpsi_sdt_t* p_sdt,
+                                           uint16_t i_service_id,
+                                           bool b_eit_schedule,
+                                           bool b_eit_present,
+                                           uint8_t i_running_status,
+                                           bool b_free_ca)
+{
+    dvbpsi_sdt_service_t * p_last_service = NULL;
+    return dvbpsi_sdt_service_append(p_sdt, &p_last_service, i_service_id,
+                                     b_eit_schedule, b_eit_present,
+                                     i_running_status, b_free_ca);
+}
+
 /*****************************************************************************
  * dvbpsi_sdt_service_descriptor_add
  *****************************************************************************
@@ -260,6 +331,27 @@ dvbpsi_descriptor_t *dvbpsi_sdt_service_descriptor_add(
     return p_descriptor;
 }
 
+/*****************************************************************************
+ * dvbpsi_sdt_decode_descriptors
+ *****************************************************************************
+ * Decode the descriptors of the services of the SDT, each loop starting
+ * without private_data_specifier.
+ *****************************************************************************/
+unsigned int dvbpsi_sdt_decode_descriptors(dvbpsi_sdt_t *p_sdt,
+                                           const uint8_t *p_tags, unsigned int i_tags)
+{
+    uint8_t p_selected[256];
+    unsigned int i_decoded = 0;
+
+    assert(p_sdt);
+
+    dvbpsi_descriptors_select(p_selected, p_tags, i_tags);
+    for (dvbpsi_sdt_service_t *p_service = p_sdt->p_first_service; p_service;
+         p_service = p_service->p_next)
+        i_decoded += dvbpsi_descriptors_decode(p_service->p_first_descriptor, 0, p_selected);
+    return i_decoded;
+}
+
 /* */
 static void dvbpsi_ReInitSDT(dvbpsi_sdt_decoder_t* p_decoder, const bool b_force)
 {
@@ -312,6 +404,31 @@ static bool dvbpsi_CheckSDT(dvbpsi_t *p_dvbpsi, dvbpsi_sdt_decoder_t *p_sdt_deco
     return b_reinit;
 }
 
+/*****************************************************************************
+ * dvbpsi_sdt_building_new
+ *****************************************************************************
+ * dvbpsi_sdt_new() in an arena of its own with dvbpsi_t::b_arena_tables.
+ *****************************************************************************/
+static dvbpsi_sdt_t *dvbpsi_sdt_building_new(dvbpsi_t *p_dvbpsi, uint8_t i_table_id,
+                                             uint16_t i_extension, uint8_t i_version,
+                                             bool b_current_next, uint16_t i_network_id)
+{
+    if (!p_dvbpsi->b_arena_tables)
+        return dvbpsi_sdt_new(i_table_id, i_extension, i_version, b_current_next,
+                              i_network_id);
+
+    dvbpsi_arena_t *p_arena = dvbpsi_arena_new(p_dvbpsi->b_zero_copy_descriptors);
+    if (p_arena == NULL)
+        return NULL;
+
+    dvbpsi_sdt_t *p_sdt = dvbpsi_arena_alloc(p_arena, sizeof(dvbpsi_sdt_t));
+    assert(p_sdt);
+    dvbpsi_sdt_init(p_sdt, i_table_id, i_extension, i_version, b_current_next,
+                    i_network_id);
+    p_sdt->p_arena = p_arena;
+    return p_sdt;
+}
+
 static bool dvbpsi_AddSectionSDT(dvbpsi_t *p_dvbpsi, dvbpsi_sdt_decoder_t *p_sdt_decoder,
                                  dvbpsi_psi_section_t* p_section)
 {
@@ -323,7 +440,8 @@ static bool dvbpsi_AddSectionSDT(dvbpsi_t *p_dvbpsi, dvbpsi_sdt_decoder_t *p_sdt
     if (!p_sdt_decoder->p_building_sdt)
     {
         p_sdt_decoder->p_building_sdt =
-                dvbpsi_sdt_new(p_section->i_table_id, p_section->i_extension,
+                dvbpsi_sdt_building_new(p_dvbpsi, p_section->i_table_id,
+                             p_section->i_extension,
                              p_section->i_version, p_section->b_current_next,
                              ((uint16_t)(p_section->p_payload_start[0]) << 8)
                                          | p_section->p_payload_start[1]);
@@ -333,6 +451,18 @@ static bool dvbpsi_AddSectionSDT(dvbpsi_t *p_dvbpsi, dvbpsi_sdt_decoder_t *p_sdt
         p_sdt_decoder->i_last_section_number = p_section->i_last_number;
     }
 
+    /* Decode the section now and only remember its number */
+    if (dvbpsi_decoder_decode_on_arrival(p_dvbpsi, DVBPSI_DECODER(p_sdt_decoder)))
+    {
+        if (dvbpsi_decoder_psi_section_mark(DVBPSI_DECODER(p_sdt_decoder), p_section))
+            dvbpsi_debug(p_dvbpsi, "SDT decoder", "ignoring already decoded section %d",
+                         p_section->i_number);
+        else
+            dvbpsi_sdt_sections_decode(p_sdt_decoder->p_building_sdt, p_section);
+        dvbpsi_DeletePSISections(p_section);
+        return true;
+    }
+
     /* Add to linked list of sections */
     if (dvbpsi_decoder_psi_section_add(DVBPSI_DECODER(p_sdt_decoder), p_section))
         dvbpsi_debug(p_dvbpsi, "SDT decoder", "overwrite section number %d",
@@ -341,6 +471,41 @@ static bool dvbpsi_AddSectionSDT(dvbpsi_t *p_dvbpsi, dvbpsi_sdt_decoder_t *p_sdt
     return true;
 }
 
+/*****************************************************************************
+ * dvbpsi_sdt_delta
+ *****************************************************************************
+ * Give the changes of p_sdt to the delta callback.
+ *****************************************************************************/
+static void dvbpsi_sdt_delta(dvbpsi_t *p_dvbpsi, dvbpsi_sdt_decoder_t *p_sdt_decoder,
+                             const dvbpsi_sdt_t *p_sdt)
+{
+    const uint8_t p_network_id[2] = { p_sdt->i_network_id >> 8,
+                                      p_sdt->i_network_id & 0xff };
+    dvbpsi_delta_table_add(p_sdt_decoder->p_delta,
+                           dvbpsi_delta_hash(DVBPSI_DELTA_HASH_INIT, p_network_id, 2),
+                           p_sdt);
+    for (const dvbpsi_sdt_service_t *p_service = p_sdt->p_first_service; p_service;
+         p_service = p_service->p_next)
+    {
+        const uint8_t p_flags[4] = { p_service->b_eit_schedule, p_service->b_eit_present,
+                                     p_service->i_running_status, p_service->b_free_ca };
+        uint64_t i_hash = dvbpsi_delta_hash(DVBPSI_DELTA_HASH_INIT, p_flags, 4);
+        i_hash = dvbpsi_delta_hash_descriptors(i_hash, p_service->p_first_descriptor);
+        dvbpsi_delta_element_add(p_sdt_decoder->p_delta, p_service->i_service_id,
+                                 i_hash, p_service);
+    }
+
+    const dvbpsi_delta_t *p_deltas;
+    unsigned int i_deltas;
+    if (!dvbpsi_delta_compute(p_sdt_decoder->p_delta, &p_deltas, &i_deltas))
+    {
+        dvbpsi_error(p_dvbpsi, "SDT decoder", "failed computing the changes");
+        return;
+    }
+    p_sdt_decoder->pf_delta_callback(p_sdt_decoder->p_delta_cb_data, p_sdt,
+                                     p_deltas, i_deltas);
+}
+
 /*****************************************************************************
  * dvbpsi_sdt_sections_gather
  *****************************************************************************
@@ -369,7 +534,7 @@ void dvbpsi_sdt_sections_gather(dvbpsi_t *p_dvbpsi,
                         = (dvbpsi_sdt_decoder_t*)p_private_decoder;
 
     /* TS discontinuity check */
-    if (p_demux->b_discontinuity)
+    if (p_demux->b_discontinuity || p_sdt_decoder->b_discontinuity)
     {
         dvbpsi_ReInitSDT(p_sdt_decoder, true);
         p_sdt_decoder->b_discontinuity = false;
@@ -416,9 +581,17 @@ void dvbpsi_sdt_sections_gather(dvbpsi_t *p_dvbpsi,
         /* Save the current information */
         p_sdt_decoder->current_sdt = *p_sdt_decoder->p_building_sdt;
         p_sdt_decoder->b_current_valid = true;
+        dvbpsi_decoder_current_set(DVBPSI_DECODER(p_sdt_decoder),
+                                   p_sdt_decoder->p_building_sdt->i_table_id,
+                                   p_sdt_decoder->p_building_sdt->i_extension,
+                                   p_sdt_decoder->p_building_sdt->i_version,
+                                   p_sdt_decoder->p_building_sdt->b_current_next);
         /* Decode the sections */
         dvbpsi_sdt_sections_decode(p_sdt_decoder->p_building_sdt,
                                    p_sdt_decoder->p_sections);
+        /* report its changes */
+        if (p_sdt_decoder->pf_delta_callback)
+            dvbpsi_sdt_delta(p_dvbpsi, p_sdt_decoder, p_sdt_decoder->p_building_sdt);
         /* signal the new SDT */
         p_sdt_decoder->pf_sdt_callback(p_sdt_decoder->p_cb_data,
                                        p_sdt_decoder->p_building_sdt);
@@ -436,10 +609,13 @@ void dvbpsi_sdt_sections_gather(dvbpsi_t *p_dvbpsi,
 void dvbpsi_sdt_sections_decode(dvbpsi_sdt_t* p_sdt,
                                 dvbpsi_psi_section_t* p_section)
 {
+    dvbpsi_sdt_service_t *p_last_service = NULL;
     uint8_t *p_byte, *p_end;
 
     while (p_section)
     {
+        dvbpsi_arena_section_keep(p_sdt->p_arena, p_section);
+
         for (p_byte = p_section->p_payload_start + 3;
              p_byte + 4 < p_section->p_payload_end;)
         {
@@ -449,9 +625,10 @@ void dvbpsi_sdt_sections_decode(dvbpsi_sdt_t* p_sdt,
             uint8_t i_running_status = (uint8_t)(p_byte[3]) >> 5;
             bool b_free_ca = ((p_byte[3] & 0x10) >> 4);
             uint16_t i_srv_length = ((uint16_t)(p_byte[3] & 0xf) <<8) | p_byte[4];
-            dvbpsi_sdt_service_t* p_service = dvbpsi_sdt_service_add(p_sdt,
-                    i_service_id, b_eit_schedule, b_eit_present,
+            dvbpsi_sdt_service_t* p_service = dvbpsi_sdt_service_append(p_sdt,
+                    &p_last_service, i_service_id, b_eit_schedule, b_eit_present,
                     i_running_status, b_free_ca);
+            dvbpsi_descriptor_t *p_last_descriptor = NULL;
 
             /* Service descriptors */
             p_byte += 5;
@@ -463,7 +640,10 @@ void dvbpsi_sdt_sections_decode(dvbpsi_sdt_t* p_sdt,
                 uint8_t i_tag = p_byte[0];
                 uint8_t i_length = p_byte[1];
                 if (i_length + 2 <= p_end - p_byte)
-                    dvbpsi_sdt_service_descriptor_add(p_service, i_tag, i_length, p_byte + 2);
+                    dvbpsi_arena_descriptor_add(p_sdt->p_arena,
+                                                &p_service->p_first_descriptor,
+                                                &p_last_descriptor,
+                                                i_tag, i_length, p_byte + 2);
                 p_byte += 2 + i_length;
             }
         }
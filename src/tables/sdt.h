@@ -98,6 +98,10 @@ typedef struct dvbpsi_sdt_s
     dvbpsi_sdt_service_t *    p_first_service;    /*!< service description
                                                      list */
 
+    struct dvbpsi_arena_s *   p_arena;            /*!< private: memory of the
+                                                     table when decoded with
+                                                     dvbpsi_s::b_arena_tables */
+
 } dvbpsi_sdt_t;
 
 /*****************************************************************************
@@ -110,6 +114,24 @@ typedef struct dvbpsi_sdt_s
  */
 typedef void (* dvbpsi_sdt_callback)(void* p_cb_data, dvbpsi_sdt_t* p_new_sdt);
 
+struct dvbpsi_delta_s;
+
+/*****************************************************************************
+ * dvbpsi_sdt_delta_callback
+ *****************************************************************************/
+/*!
+ * \typedef void (* dvbpsi_sdt_delta_callback)(void* p_cb_data,
+                                               const dvbpsi_sdt_t* p_new_sdt,
+                                               const struct dvbpsi_delta_s *p_deltas,
+                                               unsigned int i_deltas)
+ * \brief Delta callback type definition, the changes are described in
+ * delta.h. p_new_sdt and p_deltas are only valid during the call, p_new_sdt
+ * is then given to the dvbpsi_sdt_callback.
+ */
+typedef void (* dvbpsi_sdt_delta_callback)(void* p_cb_data, const dvbpsi_sdt_t* p_new_sdt,
+                                           const struct dvbpsi_delta_s *p_deltas,
+                                           unsigned int i_deltas);
+
 /*****************************************************************************
  * dvbpsi_sdt_attach
  *****************************************************************************/
@@ -142,6 +164,32 @@ bool dvbpsi_sdt_attach(dvbpsi_t *p_dvbpsi, uint8_t i_table_id, uint16_t i_extens
  */
 void dvbpsi_sdt_detach(dvbpsi_t *p_dvbpsi, uint8_t i_table_id, uint16_t i_extension);
 
+/*****************************************************************************
+ * dvbpsi_sdt_set_delta_callback
+ *****************************************************************************/
+/*!
+ * \fn bool dvbpsi_sdt_set_delta_callback(dvbpsi_t *p_dvbpsi, uint8_t i_table_id,
+                                          uint16_t i_extension,
+                                          dvbpsi_sdt_delta_callback pf_callback,
+                                          void* p_cb_data)
+ * \brief Report the changes of each new SDT of a SDT decoder.
+ * \param p_dvbpsi pointer holding decoder/demuxer structure
+ * \param i_table_id Table ID, 0x42 or 0x46.
+ * \param i_extension Table ID extension, here TS ID.
+ * \param pf_callback function to call with the changes of each new SDT
+ * before the dvbpsi_sdt_callback, NULL to stop reporting them.
+ * \param p_cb_data private data given in argument to the callback.
+ * \return true on success, false on failure or if there is no such decoder.
+ *
+ * The services are compared by service_id and the original_network_id as a
+ * table change, with the previous SDT given to the delta callback. All of
+ * them are reported as added for the first one.
+ */
+bool dvbpsi_sdt_set_delta_callback(dvbpsi_t *p_dvbpsi, uint8_t i_table_id,
+                                   uint16_t i_extension,
+                                   dvbpsi_sdt_delta_callback pf_callback,
+                                   void* p_cb_data);
+
 /*****************************************************************************
  * dvbpsi_sdt_init/dvbpsi_NewSDT
  *****************************************************************************/
@@ -236,6 +284,23 @@ dvbpsi_descriptor_t *dvbpsi_sdt_service_descriptor_add(
                                                uint8_t i_tag, uint8_t i_length,
                                                uint8_t *p_data);
 
+/*****************************************************************************
+ * dvbpsi_sdt_decode_descriptors
+ *****************************************************************************/
+/*!
+ * \fn unsigned int dvbpsi_sdt_decode_descriptors(dvbpsi_sdt_t *p_sdt,
+                                                  const uint8_t *p_tags, unsigned int i_tags)
+ * \brief Decode the descriptors of the services of the SDT with the
+ * decoders registered for their tags, see dvbpsi_DecodeAllDescriptors().
+ * \param p_sdt pointer to the SDT structure
+ * \param p_tags tags of the descriptors to decode, NULL to decode all of
+ * them
+ * \param i_tags number of tags in p_tags
+ * \return the number of decoded descriptors.
+ */
+unsigned int dvbpsi_sdt_decode_descriptors(dvbpsi_sdt_t *p_sdt,
+                                           const uint8_t *p_tags, unsigned int i_tags);
+
 /*****************************************************************************
  * dvbpsi_sdt_sections_generate
  *****************************************************************************
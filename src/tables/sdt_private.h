@@ -40,6 +40,10 @@ typedef struct dvbpsi_sdt_decoder_s
     dvbpsi_sdt_callback           pf_sdt_callback;
     void *                        p_cb_data;
 
+    dvbpsi_sdt_delta_callback     pf_delta_callback;
+    void *                        p_delta_cb_data;
+    struct dvbpsi_delta_state_s * p_delta;       /* previous table */
+
     dvbpsi_sdt_t                  current_sdt;
     dvbpsi_sdt_t *                p_building_sdt;
 
@@ -355,7 +355,7 @@ void dvbpsi_sis_sections_gather(dvbpsi_t *p_dvbpsi,
     }
 
     /* TS discontinuity check */
-    if (p_demux->b_discontinuity)
+    if (p_demux->b_discontinuity || p_sis_decoder->b_discontinuity)
     {
         dvbpsi_ReInitSIS(p_sis_decoder, true);
         p_sis_decoder->b_discontinuity = false;